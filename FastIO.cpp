@@ -265,3 +265,57 @@ void fio_shiftOut1(uint8_t pin, uint8_t value, boolean noLatch)
 {
 	fio_shiftOut1(fio_pinToOutputRegister(pin, SKIP),fio_pinToBit(pin),value, noLatch);
 }
+
+
+// The port writes are atomic, the waits between them are not
+#define I2C_HIGH(reg,bit) ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { fio_digitalWrite_HIGH(reg, bit); }
+#define I2C_LOW(reg,bit)  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { fio_digitalWrite_LOW(reg, bit); }
+
+void fio_i2cStart(fio_register sdaRegister, fio_bit sdaBit, 
+                  fio_register sclRegister, fio_bit sclBit)
+{
+   // SDA falling while SCL is HIGH (repeated start safe): start setup and
+   // hold times
+   I2C_HIGH(sdaRegister, sdaBit);
+   I2C_HIGH(sclRegister, sclBit);
+   delayMicroseconds(FIO_I2C_HALF);
+   I2C_LOW(sdaRegister, sdaBit);
+   delayMicroseconds(FIO_I2C_HALF);
+   I2C_LOW(sclRegister, sclBit);
+}
+
+void fio_i2cStop(fio_register sdaRegister, fio_bit sdaBit, 
+                 fio_register sclRegister, fio_bit sclBit)
+{
+   // SDA rising while SCL is HIGH: SCL LOW time, stop setup time and bus
+   // free time before the next start
+   I2C_LOW(sdaRegister, sdaBit);
+   delayMicroseconds(FIO_I2C_HALF);
+   I2C_HIGH(sclRegister, sclBit);
+   delayMicroseconds(FIO_I2C_HALF);
+   I2C_HIGH(sdaRegister, sdaBit);
+   delayMicroseconds(FIO_I2C_HALF);
+}
+
+void fio_i2cWrite(fio_register sdaRegister, fio_bit sdaBit, 
+                  fio_register sclRegister, fio_bit sclBit, uint8_t value)
+{
+   for(uint8_t i = 0; i < 9; i++)
+   {
+      // The 9th clock is the acknowledge, hold SDA LOW so there is no
+      // contention with the slave ack
+      if((i < 8) && (value & 0x80))
+      {
+         I2C_HIGH(sdaRegister, sdaBit);
+      }
+      else
+      {
+         I2C_LOW(sdaRegister, sdaBit);
+      }
+      value <<= 1;
+      delayMicroseconds(FIO_I2C_HALF);    // SCL LOW
+      I2C_HIGH(sclRegister, sclBit);
+      delayMicroseconds(FIO_I2C_HALF);    // SCL HIGH
+      I2C_LOW(sclRegister, sclBit);
+   }
+}
@@ -171,6 +171,18 @@ int fio_digitalRead ( fio_register pinRegister, fio_bit pinBit );
 void fio_shiftOut( fio_register dataRegister, fio_bit dataBit, fio_register clockRegister, 
                   fio_bit clockBit, uint8_t value, uint8_t bitOrder );
 
+/*!
+ @defined
+ @abstract Worst case time of fio_shiftOut (us).
+ @discussion Upper estimate: direct port writes, 3 digitalWrite per bit if
+ fastio is disabled.
+ */
+#ifndef FIO_FALLBACK
+#define FIO_SHIFTOUT_TIME 20
+#else
+#define FIO_SHIFTOUT_TIME 120
+#endif
+
 /*!
  @method
  @abstract faster shift out clear
@@ -216,4 +228,68 @@ void fio_shiftOut1_init(fio_register shift1Register, fio_bit shift1Bit);
  */
 void fio_shiftOut1_init(uint8_t pin);
 
+/*!
+ @defined
+ @abstract Clock rate of the write only I2C master (kHz).
+ @discussion 100kHz by default, the rate of the PCF8574 (SCL HIGH 4us and
+ LOW 4.7us at least). The MCP23008 takes up to 1700kHz. It has to be the same
+ for the whole library build (i.e. -DFIO_I2C_KHZ=400).
+ */
+#ifndef FIO_I2C_KHZ
+#define FIO_I2C_KHZ 100
+#endif
+
+/*!
+ @defined
+ @abstract Half clock period of the write only I2C master (us).
+ @discussion Rounded up, SCL is held HIGH and LOW at least this long and the
+ start and stop conditions are timed with it. The port writes add to it, the
+ bus runs a bit slower than FIO_I2C_KHZ.
+ */
+#define FIO_I2C_HALF ( ( 500 + FIO_I2C_KHZ - 1 ) / FIO_I2C_KHZ )
+
+/*!
+ * @method
+ * @abstract write only I2C start condition
+ * @discussion Issues an I2C start condition on the bus, both lines are left
+ * LOW. The bus is driven push-pull and it is never read back, therefore it
+ * should only be used with slaves that don't stretch the clock (i.e. PCF8574
+ * or MCP23008 IO expanders).
+ * @param sdaRegister[in] Register of data pin - ignored if fast digital write is disabled
+ * @param sdaBit[in] Bit of data pin - Pin if fast digital write is disabled
+ * @param sclRegister[in] Register of clock pin - ignored if fast digital write is disabled
+ * @param sclBit[in] Bit of clock pin - Pin if fast digital write is disabled
+ */
+void fio_i2cStart(fio_register sdaRegister, fio_bit sdaBit, 
+                  fio_register sclRegister, fio_bit sclBit);
+
+/*!
+ * @method
+ * @abstract write only I2C stop condition
+ * @discussion Issues an I2C stop condition on the bus leaving both lines
+ * HIGH (bus idle).
+ * @param sdaRegister[in] Register of data pin - ignored if fast digital write is disabled
+ * @param sdaBit[in] Bit of data pin - Pin if fast digital write is disabled
+ * @param sclRegister[in] Register of clock pin - ignored if fast digital write is disabled
+ * @param sclBit[in] Bit of clock pin - Pin if fast digital write is disabled
+ */
+void fio_i2cStop(fio_register sdaRegister, fio_bit sdaBit, 
+                 fio_register sclRegister, fio_bit sclBit);
+
+/*!
+ * @method
+ * @abstract write only I2C byte write
+ * @discussion Clocks out a byte MSB first followed by the acknowledge clock,
+ * 9 clock periods of 2 FIO_I2C_HALF. The acknowledge is not read, SDA is
+ * driven LOW during the acknowledge clock so that it never fights the slave
+ * pulling the line down. Interrupts are only masked for each port write.
+ * @param sdaRegister[in] Register of data pin - ignored if fast digital write is disabled
+ * @param sdaBit[in] Bit of data pin - Pin if fast digital write is disabled
+ * @param sclRegister[in] Register of clock pin - ignored if fast digital write is disabled
+ * @param sclBit[in] Bit of clock pin - Pin if fast digital write is disabled
+ * @param value[in] byte to write
+ */
+void fio_i2cWrite(fio_register sdaRegister, fio_bit sdaBit, 
+                  fio_register sclRegister, fio_bit sclBit, uint8_t value);
+
 #endif // FAST_IO_H
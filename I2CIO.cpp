@@ -35,6 +35,7 @@
 
 #include <../Wire/Wire.h>
 #include "I2CIO.h"
+#include "LCDBusTrace.h"
 
 // CLASS VARIABLES
 // ---------------------------------------------------------------------------
@@ -48,6 +49,12 @@ I2CIO::I2CIO ( )
    _dirMask     = 0xFF;    // mark all as INPUTs
    _shadow      = 0x0;     // no values set
    _initialised = false;
+   _intPin      = I2CIO_NO_INT;
+   _intMask     = 0x0;
+   _pullUps     = 0x0;
+   _inputs      = 0x0;
+   _batch       = false;
+   _pending     = false;
 }
 
 // PUBLIC METHODS
@@ -64,11 +71,9 @@ int I2CIO::begin ( uint8_t i2cAddr, uint8_t chiptype )
    
    if (!_chipType)
    {
-      Wire.beginTransmission(i2cAddr);
-      write(MCP23008_IOCON,0b00100000);//use dedicated cs //MCP23008
-      write(MCP23008_IODIR,0x00);  
-      write(MCP23008_GPIO,0b00000000); // Set the entire port to LOW
-      Wire.endTransmission();
+      writeReg(MCP23008_IOCON,0b00100000);//use dedicated cs //MCP23008
+      writeReg(MCP23008_IODIR,_dirMask);  
+      writeReg(MCP23008_GPIO,0b00000000); // Set the entire port to LOW
    }
       
    _initialised = Wire.requestFrom ( _i2cAddr, (uint8_t)1 );
@@ -79,6 +84,9 @@ int I2CIO::begin ( uint8_t i2cAddr, uint8_t chiptype )
    _shadow = Wire.read (); // Remove the byte read don't need it.
 #endif
    
+   // Apply an interrupt line set before the device was initialised
+   configInterrupt ( );
+   
    return ( _initialised );
 }
 
@@ -96,6 +104,11 @@ void I2CIO::pinMode ( uint8_t pin, uint8_t dir )
       {
          _dirMask |= ( 1 << pin );
       }
+      if (!_chipType)
+      {
+         writeReg ( MCP23008_IODIR, _dirMask );
+      }
+      configInterrupt ( );
    }
 }
 
@@ -114,6 +127,11 @@ void I2CIO::portMode ( uint8_t dir )
       {
          _dirMask = 0x00;
       }
+      if (!_chipType)
+      {
+         writeReg ( MCP23008_IODIR, _dirMask );
+      }
+      configInterrupt ( );
    }
 }
 
@@ -157,16 +175,34 @@ int I2CIO::write ( byte cmd, uint8_t value )
       // Only write HIGH the values of the ports that have been initialised as
       // outputs updating the output shadow of the device
       _shadow = ( value & ~(_dirMask) );
+      
+      // Writing to the PCF8574 port releases its /INT line, pick up any
+      // pending input change before it is lost. Its input pins must be kept
+      // HIGH (weak pull-up) to be read.
+      if ( _chipType )
+      {
+         if ( _intPin != I2CIO_NO_INT )
+         {
+            readInputs ( );
+         }
+         value = _shadow | _dirMask;
+      }
+      else 
+      {
+         value = _shadow;
+      }
    
       Wire.beginTransmission ( _i2cAddr );
 #if (ARDUINO <  100)
 	  if (!_chipType) Wire.send(cmd);
-      Wire.send ( _shadow );
+      Wire.send ( value );
 #else
 	  if (!_chipType) Wire.write(cmd);
-      Wire.write ( _shadow );
+      Wire.write ( value );
 #endif  
       status = Wire.endTransmission ();
+      _pending = false;
+      LCD_TRACE_BUS ( value );
    }
    return ( (status == 0) );
 }
@@ -182,7 +218,7 @@ uint8_t I2CIO::digitalRead ( uint8_t pin )
    if ( ( _initialised ) && ( pin <= 7 ) )
    {
       // Remove the values which are not inputs and get the value of the pin
-      pinVal = this->read(MCP23008_GPIO) & _dirMask;
+      pinVal = readInputs ( ) & _dirMask;
       pinVal = ( pinVal >> pin ) & 0x01; // Get the pin value
    }
    return (pinVal);
@@ -211,11 +247,143 @@ int I2CIO::digitalWrite ( uint8_t pin, uint8_t level )
       {
          _shadow &= ~writeVal;
       }
+      
+      // Defer the write if batching changes
+      if ( _batch )
+      {
+         _pending = true;
+         status = 1;
+      }
+      else 
+      {
+         status = this->write ( MCP23008_GPIO, _shadow );
+      }
+   }
+   return ( status );
+}
+
+//
+// writeMask
+int I2CIO::writeMask ( uint8_t mask, uint8_t values )
+{
+   int status = 0;
+   
+   if ( _initialised )
+   {
+      status = this->write ( MCP23008_GPIO, 
+                             ( _shadow & ~mask ) | ( values & mask ) );
+   }
+   return ( status );
+}
+
+//
+// beginBatch
+void I2CIO::beginBatch ( void )
+{
+   _batch = true;
+}
+
+//
+// commit
+int I2CIO::commit ( void )
+{
+   int status = 1;
+   
+   _batch = false;
+   if ( _pending )
+   {
       status = this->write ( MCP23008_GPIO, _shadow );
    }
    return ( status );
 }
 
+//
+// setInterruptPin
+void I2CIO::setInterruptPin ( uint8_t intPin, uint8_t mask, uint8_t pullUps )
+{
+   // Turn off the interrupt output of the device if the line is released
+   if ( ( _initialised ) && ( !_chipType ) && ( _intPin != I2CIO_NO_INT ) &&
+        ( intPin == I2CIO_NO_INT ) )
+   {
+      writeReg ( MCP23008_GPINTEN, 0x00 );
+   }
+   
+   _intPin  = intPin;
+   _intMask = mask;
+   _pullUps = pullUps;
+   
+   configInterrupt ( );
+}
+
+//
+// interruptPending
+bool I2CIO::interruptPending ( void )
+{
+   return ( ( _intPin == I2CIO_NO_INT ) || ( ::digitalRead ( _intPin ) == LOW ) );
+}
+
 //
 // PRIVATE METHODS
 // ---------------------------------------------------------------------------
+
+//
+// writeReg
+void I2CIO::writeReg ( uint8_t reg, uint8_t value )
+{
+   Wire.beginTransmission ( _i2cAddr );
+#if (ARDUINO <  100)
+   Wire.send ( reg );
+   Wire.send ( value );
+#else
+   Wire.write ( reg );
+   Wire.write ( value );
+#endif
+   Wire.endTransmission ( );
+}
+
+//
+// configInterrupt
+void I2CIO::configInterrupt ( void )
+{
+   if ( ( _initialised ) && ( _intPin != I2CIO_NO_INT ) )
+   {
+      // Interrupt lines are active LOW, open drain on the PCF8574
+#ifdef INPUT_PULLUP
+      ::pinMode ( _intPin, INPUT_PULLUP );
+#else
+      ::pinMode ( _intPin, INPUT );
+      ::digitalWrite ( _intPin, HIGH );
+#endif
+      if (!_chipType)
+      {
+         // Interrupt on change from previous value, INT active LOW (IOCON)
+         writeReg ( MCP23008_GPPU, _pullUps & _dirMask );
+         writeReg ( MCP23008_INTCON, 0x00 );
+         writeReg ( MCP23008_GPINTEN, _intMask & _dirMask );
+      }
+      // Initial read, it also clears any pending interrupt
+      _inputs = this->read ( MCP23008_GPIO );
+   }
+}
+
+//
+// readInputs
+uint8_t I2CIO::readInputs ( void )
+{
+   uint8_t captured;
+   
+   // Only go to the bus if the device has signaled a change
+   if ( interruptPending ( ) )
+   {
+      if ( ( !_chipType ) && ( _intPin != I2CIO_NO_INT ) )
+      {
+         // The levels when the change happened, then the current ones for
+         // the next read: a short pulse is seen once, then its end.
+         captured = this->read ( MCP23008_INTCAP );
+         _inputs  = this->read ( MCP23008_GPIO );
+         return ( captured );
+      }
+      _inputs = this->read ( MCP23008_GPIO );
+   }
+   return ( _inputs );
+}
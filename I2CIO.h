@@ -51,6 +51,14 @@
 #define MCP23008_GPIO 0x09
 #define MCP23008_OLAT 0x0A
 
+/*!
+ @defined 
+ @abstract   No interrupt line connected.
+ @discussion Used to indicate that the expander interrupt output is not 
+ connected to the MCU, inputs are then read from the device on every call.
+ */
+#define I2CIO_NO_INT 0xFF
+
 /*!
  @class
  @abstract    I2CIO
@@ -156,14 +164,124 @@ public:
     */   
    int digitalWrite ( uint8_t pin, uint8_t level );
    
+   /*!
+    @method
+    @abstract   Writes several pins of the device in one transaction.
+    @discussion Sets the level of the output pins selected by mask leaving the
+    rest of the pins untouched. The device is written immediately, any pin
+    changes pending from a batch (@see beginBatch) are sent in the same 
+    transaction.
+    
+    This is the method used by LCD drivers sharing the device so that their
+    port writes don't override the spare pins of the expander.
+    
+    @param      mask[in] pins to change.
+    @param      values[in] new level of the pins in mask.
+    @result     1 on success, 0 otherwise.
+    */
+   int writeMask ( uint8_t mask, uint8_t values );
+   
+   /*!
+    @method
+    @abstract   Starts a batch of pin changes.
+    @discussion From this call on digitalWrite only updates the output shadow
+    of the device without accessing the bus, until commit is called. Pending
+    changes are also sent with the next writeMask or write, i.e. merged with
+    the next port write of an LCD driver sharing the device.
+    */
+   void beginBatch ( void );
+   
+   /*!
+    @method
+    @abstract   Sends a batch of pin changes.
+    @discussion Writes all the pin changes done since beginBatch in a single
+    transaction and ends the batch. If there is nothing pending (i.e. the 
+    changes have already been sent along with a port write) the bus is not
+    accessed.
+    
+    @result     1 on success, 0 otherwise.
+    */
+   int commit ( void );
+   
+   /*!
+    @method
+    @abstract   Reads inputs only when the expander signals a change.
+    @discussion Configures the MCU pin connected to the expander interrupt 
+    output (PCF8574 /INT, MCP23008 INT). Once configured, digitalRead returns
+    the last input values read from the device and only reads the device again
+    when the interrupt line is asserted, i.e. when an input has changed.
+    
+    On the MCP23008 interrupt-on-change is enabled (GPINTEN, INTCON) for the
+    input pins in mask and the pull-ups (GPPU) of the input pins in pullUps
+    are enabled. The configuration follows the pin directions: pins set as
+    inputs later with pinMode or portMode are added, outputs are removed.
+    The value read after an interrupt is the one captured by the expander
+    when the change happened (INTCAP), a pulse shorter than the time to
+    read it is not missed; the next read returns the current level. The 
+    PCF8574 always asserts /INT on any input change.
+    
+    It can be called before begin, the configuration is then applied by
+    begin.
+    
+    NOTE: the PCF8574 also releases /INT when its port is written, if the 
+    expander is shared with an LCD the line is checked before every write
+    so that pending changes are read first.
+    
+    @param      intPin[in] MCU digital pin connected to the interrupt output
+    (active LOW). I2CIO_NO_INT disables the feature.
+    @param      mask[in] expander input pins generating an interrupt 
+    (MCP23008 only).
+    @param      pullUps[in] expander input pins with their pull-up enabled
+    (MCP23008 only), none by default.
+    */
+   void setInterruptPin ( uint8_t intPin, uint8_t mask = 0xFF,
+                          uint8_t pullUps = 0x00 );
    
+   /*!
+    @method
+    @abstract   Checks if inputs have changed.
+    @discussion Checks the expander interrupt line without any I2C traffic.
+    @result     true if the interrupt line is asserted or if no interrupt line
+    has been configured, false otherwise.
+    */
+   bool interruptPending ( void );
    
 private:
+   /*!
+    @method
+    @abstract   Writes a register of the device.
+    @discussion Writes a configuration register of the MCP23008, the value
+    is written as is without applying the direction mask.
+    */
+   void writeReg ( uint8_t reg, uint8_t value );
+   
+   /*!
+    @method
+    @abstract   Configures the interrupt line and the expander.
+    @discussion Applies the configuration of setInterruptPin to the input
+    pins of the device, once it is initialised.
+    */
+   void configInterrupt ( void );
+   
+   /*!
+    @method
+    @abstract   Gets the state of the input pins.
+    @discussion Returns the cached input state unless the device has signaled
+    a change through its interrupt line, in which case it is read again.
+    */
+   uint8_t readInputs ( void );
+   
    uint8_t _shadow;      // Shadow output
    uint8_t _dirMask;     // Direction mask
    uint8_t _i2cAddr;     // I2C address
    bool    _initialised; // Initialised object
    uint8_t _chipType;	 
+   uint8_t _intPin;      // MCU pin connected to the interrupt line
+   uint8_t _intMask;     // Pins generating an interrupt (MCP23008)
+   uint8_t _pullUps;     // Pins with their pull-up enabled (MCP23008)
+   uint8_t _inputs;      // Last input values read from the device
+   bool    _batch;       // Pin changes are being batched
+   bool    _pending;     // Shadow has changes not written to the device
    
 };
 
@@ -49,7 +49,8 @@
 // Constructor
 LCD::LCD () 
 {
-   
+   _hookStart = 0;
+   _hookEnd   = 0;
 }
 
 // PUBLIC METHODS
@@ -93,9 +94,12 @@ void LCD::begin(uint8_t cols, uint8_t lines, uint8_t dotsize)
    // SEE PAGE 45/46 FOR INITIALIZATION SPECIFICATION!
    // according to datasheet, we need at least 40ms after power rises above 2.7V
    // before sending commands. Arduino can turn on way before 4.5V so we'll wait 
-   // 50
+   // 100ms. This is not a command execution time: it is waited even by the
+   // drivers that know when the LCD is ready.
    // ---------------------------------------------------------------------------
+   LCD_HOOK_START(LCD_OP_POWER_UP, 100);
    delay (100); // 100ms delay
+   LCD_HOOK_END(LCD_OP_POWER_UP, 100);
    
    //put the LCD into 4 bit or 8 bit mode
    // -------------------------------------
@@ -107,19 +111,19 @@ void LCD::begin(uint8_t cols, uint8_t lines, uint8_t dotsize)
       // we start in 8bit mode, try to set 4 bit mode
       // Special case of "Function Set"
       send(0x03, FOUR_BITS);
-      delayMicroseconds(4500); // wait min 4.1ms
+      execWait(4500);         // wait min 4.1ms
       
       // second try
       send ( 0x03, FOUR_BITS );
-      delayMicroseconds(150); // wait min 100us
+      execWait(150);          // wait min 100us
       
       // third go!
       send( 0x03, FOUR_BITS );
-      delayMicroseconds(150); // wait min of 100us
+      execWait(150);          // wait min of 100us
       
       // finally, set to 4-bit interface
       send ( 0x02, FOUR_BITS );
-      delayMicroseconds(150); // wait min of 100us
+      execWait(150);          // wait min of 100us
 
    } 
    else 
@@ -129,21 +133,21 @@ void LCD::begin(uint8_t cols, uint8_t lines, uint8_t dotsize)
       
       // Send function set command sequence
       command(LCD_FUNCTIONSET | _displayfunction);
-      delayMicroseconds(4500);  // wait more than 4.1ms
+      execWait(4500);           // wait more than 4.1ms
       
       // second try
       command(LCD_FUNCTIONSET | _displayfunction);
-      delayMicroseconds(150);
+      execWait(150);
       
       // third go
       command(LCD_FUNCTIONSET | _displayfunction);
-      delayMicroseconds(150);
+      execWait(150);
 
    }
    
    // finally, set # lines, font size, etc.
    command(LCD_FUNCTIONSET | _displayfunction);
-   delayMicroseconds ( 60 );  // wait more
+   execWait ( 60 );           // wait more
    
    // turn the display on with no cursor or blinking default
    _displaycontrol = LCD_DISPLAYON | LCD_CURSOROFF | LCD_BLINKOFF;  
@@ -166,16 +170,24 @@ void LCD::begin(uint8_t cols, uint8_t lines, uint8_t dotsize)
 void LCD::clear()
 {
    command(LCD_CLEARDISPLAY);             // clear display, set cursor position to zero
-   delayMicroseconds(HOME_CLEAR_EXEC);    // this command is time consuming
+   execWait(HOME_CLEAR_EXEC);             // this command is time consuming
+   _displaymode |= LCD_ENTRYLEFT;         // the LCD goes back to left to right
 }
 
 void LCD::home()
 {
    command(LCD_RETURNHOME);             // set cursor position to zero
-   delayMicroseconds(HOME_CLEAR_EXEC);  // This command is time consuming
+   execWait(HOME_CLEAR_EXEC);           // This command is time consuming
 }
 
 void LCD::setCursor(uint8_t col, uint8_t row)
+{
+   command(LCD_SETDDRAMADDR | address(col, row));
+}
+
+//
+// address - DDRAM address of a position
+uint8_t LCD::address(uint8_t col, uint8_t row)
 {
    const byte row_offsetsDef[]   = { 0x00, 0x40, 0x14, 0x54 }; // For regular LCDs
    const byte row_offsetsLarge[] = { 0x00, 0x40, 0x10, 0x50 }; // For 16x4 LCDs
@@ -189,13 +201,57 @@ void LCD::setCursor(uint8_t col, uint8_t row)
    // ----------------------------------------
    if ( _cols == 16 && _numlines == 4 )
    {
-      command(LCD_SETDDRAMADDR | (col + row_offsetsLarge[row]));
+      return ( col + row_offsetsLarge[row] );
    }
-   else 
+   return ( col + row_offsetsDef[row] );
+}
+
+//
+// writeScreen - write all the rows in DDRAM order
+void LCD::writeScreen(const uint8_t *screen)
+{
+   uint8_t done = 0;                // rows written
+   uint8_t addr = 0xFF;             // LCD address counter, unknown
+   uint8_t row;
+   
+   // A row starting where the previous one ended doesn't need addressing,
+   // i.e. on a 20x4 LCD rows 0, 2, 1 and 3 follow each other in the DDRAM.
+   beginBatch ( );
+   for ( uint8_t n = 0; n < _numlines; n++ )
    {
-      command(LCD_SETDDRAMADDR | (col + row_offsetsDef[row]));
+      row = 0xFF;
+      for ( uint8_t r = 0; r < _numlines; r++ )
+      {
+         if ( done & ( 1 << r ) )
+         {
+            continue;
+         }
+         if ( address ( 0, r ) == addr )
+         {
+            row = r;
+            break;
+         }
+         if ( ( row == 0xFF ) || ( address ( 0, r ) < address ( 0, row ) ) )
+         {
+            row = r;
+         }
+      }
+      
+      if ( address ( 0, row ) != addr )
+      {
+         setCursor ( 0, row );
+      }
+      write ( &screen[row * _cols], _cols );
+      done |= ( 1 << row );
+      
+      // In 2 line mode the end of a DDRAM line continues on the other one
+      addr = address ( 0, row ) + _cols;
+      if ( ( _displayfunction & LCD_2LINE ) && ( ( addr & 0x3F ) == 40 ) )
+      {
+         addr = ( addr & 0x40 ) ^ 0x40;
+      }
    }
-   
+   endBatch ( );
 }
 
 // Turn the display on/off
@@ -293,13 +349,23 @@ void LCD::createChar(uint8_t location, uint8_t charmap[])
 {
    location &= 0x7;            // we only have 8 locations 0-7
    
+   // Right to left the rows would be written backwards
+   if (!(_displaymode & LCD_ENTRYLEFT))
+   {
+      command(LCD_ENTRYMODESET | _displaymode | LCD_ENTRYLEFT);
+   }
    command(LCD_SETCGRAMADDR | (location << 3));
-   delayMicroseconds(30);
+   execWait(30);
    
    for (uint8_t i = 0; i < 8; i++)
    {
       write(charmap[i]);      // call the virtual write method
-      delayMicroseconds(40);
+      execWait(40);
+   }
+   
+   if (!(_displaymode & LCD_ENTRYLEFT))
+   {
+      command(LCD_ENTRYMODESET | _displaymode);
    }
 }
 
@@ -308,13 +374,23 @@ void LCD::createChar(uint8_t location, const prog_uchar charmap[])
 {
    location &= 0x7;   // we only have 8 memory locations 0-7
    
+   // Right to left the rows would be written backwards
+   if (!(_displaymode & LCD_ENTRYLEFT))
+   {
+      command(LCD_ENTRYMODESET | _displaymode | LCD_ENTRYLEFT);
+   }
    command(LCD_SETCGRAMADDR | (location << 3));
-   delayMicroseconds(30);
+   execWait(30);
    
    for (uint8_t i = 0; i < 8; i++)
    {
       write(pgm_read_byte_near(charmap++));
-      delayMicroseconds(40);
+      execWait(40);
+   }
+   
+   if (!(_displaymode & LCD_ENTRYLEFT))
+   {
+      command(LCD_ENTRYMODESET | _displaymode);
    }
 }
 #endif // __AVR__
@@ -351,20 +427,113 @@ void LCD::off ( void )
 
 // General LCD commands - generic methods used by the rest of the commands
 // ---------------------------------------------------------------------------
+//
+// waitExec - wait for the LCD to complete a time consuming operation
+void LCD::waitExec ( uint16_t uSec )
+{
+   delayMicroseconds ( uSec );
+}
+
+//
+// execWait - waitExec reported to the hooks
+void LCD::execWait ( uint16_t uSec )
+{
+   LCD_HOOK_START(LCD_OP_WAIT, uSec);
+   waitExec ( uSec );
+   LCD_HOOK_END(LCD_OP_WAIT, uSec);
+}
+
+//
+// dataCost - characters and commands take a send each by default
+uint16_t LCD::dataCost ( void )
+{
+   return ( LCD_EXEC_TIME );
+}
+
+//
+// commandCost
+uint16_t LCD::commandCost ( void )
+{
+   return ( LCD_EXEC_TIME );
+}
+
+//
+// maxBridgeGap - unchanged characters cheaper to rewrite than a command
+uint16_t LCD::maxBridgeGap ( void )
+{
+   uint16_t data    = dataCost ( );
+   uint16_t command = commandCost ( );
+
+   if ( ( data == 0 ) || ( command == 0 ) )
+   {
+      return ( 0 );
+   }
+   return ( ( command - 1 ) / data );
+}
+
+//
+// maxSendTime
+uint16_t LCD::maxSendTime ( void )
+{
+   return ( 0 );
+}
+
+//
+// maxBlocking
+unsigned long LCD::maxBlocking ( uint8_t call )
+{
+   uint16_t send = maxSendTime ( );
+   
+   if ( send == 0 )
+   {
+      return ( 0 );
+   }
+   
+   switch ( call )
+   {
+      case LCD_CALL_WRITE:
+         return ( LCD_WCET_WRITE ( send ) );
+      case LCD_CALL_SET_CURSOR:
+         return ( LCD_WCET_SET_CURSOR ( send ) );
+      case LCD_CALL_CLEAR:
+         return ( LCD_WCET_CLEAR ( send ) );
+      case LCD_CALL_CREATE_CHAR:
+         return ( LCD_WCET_CREATE_CHAR ( send ) );
+      case LCD_CALL_BEGIN:
+         return ( LCD_WCET_BEGIN ( send ) );
+   }
+   return ( 0 );
+}
+
 void LCD::command(uint8_t value) 
 {
+   LCD_HOOK_START(LCD_OP_COMMAND, 1);
    send(value, COMMAND);
+   LCD_HOOK_END(LCD_OP_COMMAND, 1);
+}
+
+//
+// setHooks
+void LCD::setHooks ( t_lcdHook start, t_lcdHook end )
+{
+   _hookStart = start;
+   _hookEnd   = end;
 }
 
 #if (ARDUINO <  100)
 void LCD::write(uint8_t value)
 {
+   LCD_HOOK_START(LCD_OP_DATA, 1);
    send(value, DATA);
+   LCD_HOOK_END(LCD_OP_DATA, 1);
 }
 #else
 size_t LCD::write(uint8_t value) 
 {
+   LCD_HOOK_START(LCD_OP_DATA, 1);
    send(value, DATA);
+   LCD_HOOK_END(LCD_OP_DATA, 1);
    return 1;             // assume OK
 }
 #endif
+
@@ -79,6 +79,52 @@ inline static void waitUsec ( uint16_t uSec )
 #endif // FAST_MODE
 }
 
+/*!
+ @defined 
+ @abstract   Enables the transaction hooks.
+ @discussion If defined, the functions set with setHooks are called at the
+ start and at the end of each send, bulk transfer and wait for the LCD, i.e.
+ to toggle a spare pin watched by a logic analyser. If not defined, the
+ calls to the hooks compile to nothing; the class layout and setHooks are the
+ same either way, only the library sources look at it.
+ */
+// #define LCD_HOOKS
+
+/*!
+ @defined 
+ @abstract   Kinds of operation reported to the transaction hooks.
+ @discussion LCD_OP_COMMAND and LCD_OP_DATA: a send, of 1 byte.
+ LCD_OP_BULK: a bulk transfer of characters, of the given number of bytes.
+ LCD_OP_WAIT: a wait for the LCD to execute a command, of the given number
+ of microseconds.
+ LCD_OP_POWER_UP: the wait for the LCD to power up in begin, of the given
+ number of milliseconds.
+ */
+#define LCD_OP_COMMAND          0
+#define LCD_OP_DATA             1
+#define LCD_OP_BULK             2
+#define LCD_OP_WAIT             3
+#define LCD_OP_POWER_UP         4
+
+/*!
+ @typedef 
+ @abstract   Transaction hook.
+ @discussion Called with the kind of operation (LCD_OP_COMMAND, ...) and its
+ size in bytes, or in microseconds for a wait. Called from within the
+ driver, it must be short.
+ */
+typedef void ( *t_lcdHook ) ( uint8_t kind, uint16_t size );
+
+#ifdef LCD_HOOKS
+#define LCD_HOOK_START(kind, size) \
+   do { if ( _hookStart != 0 ) _hookStart ( kind, size ); } while ( 0 )
+#define LCD_HOOK_END(kind, size) \
+   do { if ( _hookEnd != 0 ) _hookEnd ( kind, size ); } while ( 0 )
+#else
+#define LCD_HOOK_START(kind, size)
+#define LCD_HOOK_END(kind, size)
+#endif
+
 
 /*!
  @defined 
@@ -130,6 +176,10 @@ inline static void waitUsec ( uint16_t uSec )
 #define LCD_5x10DOTS            0x04
 #define LCD_5x8DOTS             0x00
 
+// Default execution time of a command or a character write (us)
+// ---------------------------------------------------------------------------
+#define LCD_EXEC_TIME           37
+
 
 // Define COMMAND and DATA LCD Rs (used by send method).
 // ---------------------------------------------------------------------------
@@ -146,6 +196,40 @@ inline static void waitUsec ( uint16_t uSec )
  */
 #define HOME_CLEAR_EXEC      2000
 
+/*!
+ @defined 
+ @abstract   Worst case time the LCD calls block (us).
+ @discussion Given the worst case time of a send of a driver (i.e.
+ LCI2C_MAX_SEND), the longest time each call can block, built from the sends
+ and waits the LCD class makes (as counted on LCDSimulator):
+ write: a send.
+ setCursor: a send.
+ clear: a send and the clear execution time.
+ createChar: 11 sends, when in right to left mode the entry mode is changed
+ and restored around the address and 8 characters, the CGRAM address wait
+ and a wait per character.
+ begin: 9 sends (4 initialisation nibbles, function set, display control,
+ clear, entry mode, backlight as one more send) and the power up,
+ initialisation and clear waits.
+ The time the driver's own begin takes to set up its bus is not included.
+ */
+#define LCD_WCET_WRITE(send)          ( (unsigned long)(send) )
+#define LCD_WCET_SET_CURSOR(send)     ( (unsigned long)(send) )
+#define LCD_WCET_CLEAR(send)          ( (unsigned long)(send) + HOME_CLEAR_EXEC )
+#define LCD_WCET_CREATE_CHAR(send)    ( 11 * (unsigned long)(send) + 30 + 8 * 40 )
+#define LCD_WCET_BEGIN(send)          ( 9 * (unsigned long)(send) + 100000 + \
+                                        4500 + 3 * 150 + 60 + HOME_CLEAR_EXEC )
+
+/*!
+ @defined 
+ @abstract   Calls whose worst case time is given by maxBlocking.
+ */
+#define LCD_CALL_WRITE          0
+#define LCD_CALL_SET_CURSOR     1
+#define LCD_CALL_CLEAR          2
+#define LCD_CALL_CREATE_CHAR    3
+#define LCD_CALL_BEGIN          4
+
 /*!
     @defined 
     @abstract   Backlight off constant declaration
@@ -418,6 +502,31 @@ public:
     */
    void setCursor(uint8_t col, uint8_t row);
    
+   /*!
+    @function
+    @abstract   DDRAM address of a position.
+    @discussion Returns the LCD display data RAM address where the character
+    of a given position of the LCD is stored (the address setCursor uses).
+    
+    @param      col[in] LCD column
+    @param      row[in] LCD row - line.
+    @result     DDRAM address.
+    */
+   uint8_t address(uint8_t col, uint8_t row);
+   
+   /*!
+    @function
+    @abstract   Writes the whole LCD.
+    @discussion Writes all the characters of the LCD, row after row. The rows
+    are written in DDRAM address order and only the rows that don't follow
+    the previous one in the DDRAM are addressed, i.e. a 20x4 LCD is written
+    with a single addressing command and a 16x4 LCD with two, instead of one
+    per row. The cursor is left at an undefined position.
+    
+    @param      screen[in] cols * rows characters, row after row.
+    */
+   void writeScreen(const uint8_t *screen);
+   
    /*!
     @function
     @abstract   Switch-on the LCD backlight.
@@ -454,6 +563,45 @@ public:
     */   
    void off ( void );
    
+   /*!
+    @function
+    @abstract   Send a command to the LCD.
+    @discussion This method sends a command to the LCD by setting the Register
+    select line of the LCD.
+    
+    This command shouldn't be used to drive the LCD, only to implement any other
+    feature that is not available on this library.
+    
+    @param      value[in] Command value to send to the LCD (COMMAND, DATA or
+    FOUR_BITS).
+    */
+   void command(uint8_t value);
+   
+   /*!
+    @function
+    @abstract   Worst case time a call blocks.
+    @discussion The time is worked out from maxSendTime, @see LCD_WCET_WRITE.
+    
+    @param      call[in] LCD_CALL_WRITE, LCD_CALL_SET_CURSOR, LCD_CALL_CLEAR,
+    LCD_CALL_CREATE_CHAR or LCD_CALL_BEGIN.
+    @result     time in microseconds, 0 if the driver doesn't give its worst
+    case send time or the call is unknown.
+    */
+   unsigned long maxBlocking ( uint8_t call );
+   
+   /*!
+    @function
+    @abstract   Sets the transaction hooks.
+    @discussion The hooks are called at the start and at the end of each
+    command or character sent, each bulk transfer and each wait for the LCD
+    to execute a command. A bulk transfer doesn't report the characters it is
+    made of. The hooks are only called if LCD_HOOKS is defined.
+    
+    @param      start[in] called before the operation, 0 for none.
+    @param      end[in] called after the operation, 0 for none.
+    */
+   void setHooks ( t_lcdHook start, t_lcdHook end );
+   
    //
    // virtual class methods
    // --------------------------------------------------------------------------
@@ -511,7 +659,82 @@ public:
    using Print::write;
 #endif   
    
+   /*!
+    @function
+    @abstract   Cost of writing a character.
+    @discussion Approximate time in microseconds taken by each character of
+    a string written to the LCD (bus transfer and LCD execution time). Used
+    together with commandCost to update the LCD with less traffic, i.e.
+    rewriting a few unchanged characters instead of addressing the next
+    change. Drivers with a cheaper bulk write path should override it.
+    
+    @result     cost of a character within a string.
+    */
+   virtual uint16_t dataCost ( void );
+   
+   /*!
+    @function
+    @abstract   Cost of sending a command.
+    @discussion Approximate time in microseconds taken by a command, i.e.
+    addressing the LCD with setCursor. @see dataCost
+    
+    @result     cost of a command.
+    */
+   virtual uint16_t commandCost ( void );
+   
+   /*!
+    @function
+    @abstract   Longest run of unchanged characters worth rewriting.
+    @discussion Unchanged characters between two changes are cheaper to
+    rewrite than addressing the next change when they cost less than a
+    command. Worked out from dataCost and commandCost.
+    
+    @result     number of unchanged characters to bridge, 0 if the costs
+    are not known.
+    */
+   uint16_t maxBridgeGap ( void );
+   
+   /*!
+    @function
+    @abstract   Worst case time of a send.
+    @discussion Longest time in microseconds a command or a character takes
+    to be sent by the driver: bus transfer, retries and the waits the driver
+    makes. Unlike dataCost and commandCost it is a bound, not an estimate.
+    The default returns 0, the time is not known.
+    
+    @result     worst case time of a send, 0 if not known.
+    */
+   virtual uint16_t maxSendTime ( void );
+   
+   /*!
+    @function
+    @abstract   Starts a batch of transfers.
+    @discussion Drivers with a bulk transfer path (i.e. a single system call
+    for a whole bus message) hold back the transfers until endBatch and then
+    send them at once. Batches can be nested, the transfers are sent when the
+    outermost batch ends. The default does nothing.
+    */
+   virtual void beginBatch ( void ) { };
+   
+   /*!
+    @function
+    @abstract   Ends a batch of transfers. @see beginBatch
+    */
+   virtual void endBatch ( void ) { };
+   
 protected:
+   /*!
+    @function
+    @abstract   Waits for the LCD to execute a command.
+    @discussion Waits the given time for the LCD controller to complete a
+    time consuming operation (clear, home, CGRAM writes). The default
+    implementation simply delays; drivers whose hardware reports when the
+    LCD is ready (busy/ack handshake) can override it to return immediately.
+    
+    @param      uSec[in] worst case execution time in microseconds.
+    */
+   virtual void waitExec ( uint16_t uSec );
+   
    // Internal LCD variables to control the LCD shared between all derived
    // classes.
    uint8_t _displayfunction;  // LCD_5x10DOTS or LCD_5x8DOTS, LCD_4BITMODE or 
@@ -522,22 +745,17 @@ protected:
    uint8_t _numlines;         // Number of lines of the LCD, initialized with begin()
    uint8_t _cols;             // Number of columns in the LCD
    t_backlighPol _polarity;   // Backlight polarity
+   t_lcdHook _hookStart;      // Called before each transaction
+   t_lcdHook _hookEnd;        // Called after each transaction
    
 private:
    /*!
     @function
-    @abstract   Send a command to the LCD.
-    @discussion This method sends a command to the LCD by setting the Register
-    select line of the LCD.
-    
-    This command shouldn't be used to drive the LCD, only to implement any other
-    feature that is not available on this library.
-    
-    @param      value[in] Command value to send to the LCD (COMMAND, DATA or
-    FOUR_BITS).
+    @abstract   Waits for the LCD to execute a command, reporting the wait to
+    the transaction hooks. @see waitExec
     */
-   void command(uint8_t value);
-
+   void execWait ( uint16_t uSec );
+   
    /*!
     @function
     @abstract   Send a particular value to the LCD.
@@ -0,0 +1,130 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: Yes (one receiver, the I2C interrupt, and one renderer)
+// Extendable: Yes
+//
+// @file LCDBackpack.cpp
+// This file implements an intelligent I2C backpack: a small MCU driving a
+// local LCD with the frames it receives as an I2C slave.
+//
+// @brief
+// The receive buffer is a ring of bytes: the I2C interrupt only writes the
+// head and the main loop only writes the tail, both single byte indexes, so
+// neither side needs to disable interrupts.
+//
+// ---------------------------------------------------------------------------
+#if (ARDUINO <  100)
+#include <WProgram.h>
+#else
+#include <Arduino.h>
+#endif
+
+#include <inttypes.h>
+
+#include <../Wire/Wire.h>
+#include "LCDBackpack.h"
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+#define BUFFER_MASK   ( LCDBP_BUFFER_SIZE - 1 )
+
+// CLASS VARIABLES
+// ---------------------------------------------------------------------------
+LCDBackpack *LCDBackpack::_instance = 0;
+
+// CONSTRUCTORS
+// ---------------------------------------------------------------------------
+LCDBackpack::LCDBackpack ( LCD &lcd, uint8_t cols, uint8_t rows ) :
+   _lcd ( lcd ), _decoder ( lcd, cols, rows )
+{
+   _cols     = cols;
+   _rows     = rows;
+   _head     = 0;
+   _tail     = 0;
+   _overruns = 0;
+}
+
+// PUBLIC METHODS
+// ---------------------------------------------------------------------------
+
+//
+// begin
+void LCDBackpack::begin ( uint8_t address )
+{
+   _lcd.begin ( _cols, _rows );
+
+   _instance = this;
+   Wire.begin ( address );
+   Wire.onReceive ( receive );
+   Wire.onRequest ( request );
+}
+
+//
+// update
+int LCDBackpack::update ( void )
+{
+   uint8_t value;
+
+   while ( _tail != _head )
+   {
+      value = _buffer[_tail];
+      _tail = ( _tail + 1 ) & BUFFER_MASK;   // the byte can be reused now
+
+      if ( _decoder.feed ( value ) )
+      {
+         return ( 1 );
+      }
+   }
+   return ( 0 );
+}
+
+//
+// errors
+uint8_t LCDBackpack::errors ( void )
+{
+   return ( _decoder.errors ( ) + _overruns );
+}
+
+// PRIVATE METHODS
+// ---------------------------------------------------------------------------
+
+//
+// receive
+void LCDBackpack::receive ( int count )
+{
+   LCDBackpack *backpack = _instance;
+   uint8_t      head     = backpack->_head;
+   uint8_t      next;
+
+   while ( Wire.available ( ) )
+   {
+      next = ( head + 1 ) & BUFFER_MASK;
+      if ( next == backpack->_tail )
+      {
+         // The frame is lost anyway, the decoder will discard it
+         backpack->_overruns++;
+         Wire.read ( );
+         continue;
+      }
+      backpack->_buffer[head] = Wire.read ( );
+      head = next;
+   }
+   backpack->_head = head;                   // publish the whole transfer
+}
+
+//
+// request
+void LCDBackpack::request ( void )
+{
+   LCDBackpack *backpack = _instance;
+   uint8_t      status[2];
+
+   status[0] = ( backpack->_tail - backpack->_head - 1 ) & BUFFER_MASK;
+   status[1] = backpack->errors ( );
+   Wire.write ( status, sizeof ( status ) );
+}
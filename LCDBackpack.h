@@ -0,0 +1,138 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: Yes (one receiver, the I2C interrupt, and one renderer)
+// Extendable: Yes
+//
+// @file LCDBackpack.h
+// This file implements an intelligent I2C backpack: a small MCU driving a
+// local LCD with the frames it receives as an I2C slave.
+//
+// @brief
+// An I2C expander backpack takes 4 bus writes per character. With a
+// backpack MCU the master sends the frames of the binary display protocol
+// (@see LCDProtocol.h) instead, a whole screen or only what changed since
+// the last one, in one short transfer per update. The frame bytes are
+// copied into a receive buffer from the I2C interrupt, so the master is
+// acknowledged straight away, and the main loop of the backpack applies
+// them to the local LCD (i.e. a parallel LiquidCrystal) at its own pace.
+//
+//   LiquidCrystal lcd(8, 9, 4, 5, 6, 7);
+//   LCDBackpack   backpack(lcd, 20, 4);
+//
+//   void setup()
+//   {
+//      backpack.begin ( 0x30 );
+//   }
+//
+//   void loop()
+//   {
+//      backpack.update ( );
+//   }
+//
+// On the master, an LCDEncoder turns the screens into frames, which are
+// written to the backpack in transfers of up to BUFFER_LENGTH bytes (the
+// Wire buffer). Reading 2 bytes from the backpack returns the room left in
+// its receive buffer, to pace the transfers, and the number of frames and
+// bytes it had to discard: when it changes the master calls
+// LCDEncoder::invalidate to send the whole screen again.
+//
+// There is a single backpack per MCU, the Wire callbacks don't take a
+// context.
+//
+// ---------------------------------------------------------------------------
+#ifndef LCDBackpack_h
+#define LCDBackpack_h
+
+#include <inttypes.h>
+
+#include "LCD.h"
+#include "LCDDecoder.h"
+
+/*!
+ @defined
+ @abstract   Size of the receive buffer.
+ @discussion It has to be a power of 2 up to 256. The default holds a
+ whole screen, sent while the previous one is still being applied.
+ */
+#ifndef LCDBP_BUFFER_SIZE
+#define LCDBP_BUFFER_SIZE    128
+#endif
+
+#if ( LCDBP_BUFFER_SIZE < 2 ) || ( LCDBP_BUFFER_SIZE > 256 ) || \
+    ( ( LCDBP_BUFFER_SIZE & ( LCDBP_BUFFER_SIZE - 1 ) ) != 0 )
+#error "LCDBP_BUFFER_SIZE has to be a power of 2 up to 256"
+#endif
+
+class LCDBackpack
+{
+public:
+   /*!
+    @method
+    @abstract   Class constructor.
+
+    @param      lcd[in] local LCD driven by the backpack.
+    @param      cols[in] number of columns of the LCD.
+    @param      rows[in] number of rows of the LCD.
+    */
+   LCDBackpack ( LCD &lcd, uint8_t cols, uint8_t rows );
+
+   /*!
+    @function
+    @abstract   Starts the backpack.
+    @discussion Initialises the local LCD and joins the I2C bus as a slave.
+
+    @param      address[in] I2C address of the backpack.
+    */
+   void begin ( uint8_t address );
+
+   /*!
+    @function
+    @abstract   Applies the frames received to the LCD.
+    @discussion Takes the bytes received up to the end of the next frame,
+    so a call applies at most one frame. To be called from the main loop.
+
+    @result     1 if a frame has been applied, 0 otherwise.
+    */
+   int update ( void );
+
+   /*!
+    @function
+    @abstract   Number of frames and bytes discarded.
+    @discussion Frames with a wrong length, checksum or contents and bytes
+    received with the receive buffer full.
+    */
+   uint8_t errors ( void );
+
+private:
+   /*!
+    @function
+    @abstract   Copies the bytes of a transfer to the receive buffer.
+    @discussion Called from the I2C interrupt.
+    */
+   static void receive ( int count );
+
+   /*!
+    @function
+    @abstract   Replies the room left and the errors to the master.
+    @discussion Called from the I2C interrupt.
+    */
+   static void request ( void );
+
+   static LCDBackpack *_instance;        // Backpack of the Wire callbacks
+
+   LCD              &_lcd;               // Local LCD
+   uint8_t           _cols;              // Display columns
+   uint8_t           _rows;              // Display rows
+   LCDDecoder        _decoder;           // Frames to LCD operations
+   volatile uint8_t  _head;              // Next byte received, I2C interrupt
+   volatile uint8_t  _tail;              // Next byte to apply, main loop
+   volatile uint8_t  _overruns;          // Bytes lost with the buffer full
+   uint8_t           _buffer[LCDBP_BUFFER_SIZE];  // Bytes received
+};
+
+#endif
@@ -0,0 +1,111 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LCDBusTrace.cpp
+// This file implements a trace of the bytes the drivers put on their bus.
+//
+// @brief
+// The CRC is computed bit by bit, it is slower than a table but takes no
+// memory and the trace is only compiled in to check the drivers.
+//
+// ---------------------------------------------------------------------------
+#include <inttypes.h>
+
+#if (ARDUINO <  100)
+#include <WProgram.h>
+#else
+#include <Arduino.h>
+#endif
+
+#include "LCDBusTrace.h"
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+
+// CRC-16 CCITT
+#define CRC_INIT      0xFFFF
+#define CRC_POLY      0x1021
+
+// CLASS VARIABLES
+// ---------------------------------------------------------------------------
+unsigned long LCDBusTrace::_count = 0;
+uint16_t      LCDBusTrace::_crc   = CRC_INIT;
+uint8_t       LCDBusTrace::_capture[LCDBT_CAPTURE_SIZE];
+
+// PUBLIC METHODS
+// ---------------------------------------------------------------------------
+
+//
+// start
+void LCDBusTrace::start ( void )
+{
+   _count = 0;
+   _crc   = CRC_INIT;
+}
+
+//
+// record
+void LCDBusTrace::record ( uint8_t value )
+{
+   if ( _count < LCDBT_CAPTURE_SIZE )
+   {
+      _capture[_count] = value;
+   }
+   _count++;
+
+   _crc ^= ( uint16_t )value << 8;
+   for ( uint8_t i = 0; i < 8; i++ )
+   {
+      if ( _crc & 0x8000 )
+      {
+         _crc = ( _crc << 1 ) ^ CRC_POLY;
+      }
+      else
+      {
+         _crc <<= 1;
+      }
+   }
+}
+
+//
+// count
+unsigned long LCDBusTrace::count ( void )
+{
+   return ( _count );
+}
+
+//
+// crc
+uint16_t LCDBusTrace::crc ( void )
+{
+   return ( _crc );
+}
+
+//
+// dump
+void LCDBusTrace::dump ( Print &out )
+{
+   unsigned long size = _count;
+
+   if ( size > LCDBT_CAPTURE_SIZE )
+   {
+      size = LCDBT_CAPTURE_SIZE;
+   }
+   for ( uint8_t i = 0; i < size; i++ )
+   {
+      if ( _capture[i] < 0x10 )
+      {
+         out.write ( '0' );
+      }
+      out.print ( _capture[i], HEX );
+      out.write ( ' ' );
+   }
+   out.println ( );
+}
@@ -0,0 +1,107 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LCDBusTrace.h
+// This file implements a trace of the bytes the drivers put on their bus.
+//
+// @brief
+// Each driver calls LCD_TRACE_BUS with every byte it puts on its bus, at the
+// lowest level it controls: the nibbles and RS level written to the pins
+// (LiquidCrystal), the port values written to the I2C expander
+// (LiquidCrystal_I2C, LiquidCrystal_IIC, LiquidCrystal_SI2C), the commands
+// and data sent to the ByVac backpack, the values loaded in the shift
+// register (LiquidCrystal_SR, _SR1W, _SR2W, _SR3W).
+//
+// The trace keeps a digest of the sequence: the number of bytes, their
+// CRC-16 and the first LCDBT_CAPTURE_SIZE bytes. Comparing the digest of a
+// fixed scenario with the one of a known good version of the library tells
+// whether a change altered what goes on the bus, @see the BusTrace example.
+//
+//   LCDBusTrace::start ( );
+//   lcd.print ( "Hello" );
+//   // LCDBusTrace::count ( ), LCDBusTrace::crc ( )
+//
+// The trace is compiled in only when LCD_BUS_TRACE is defined below, it
+// costs nothing otherwise.
+//
+// ---------------------------------------------------------------------------
+#ifndef LCDBusTrace_h
+#define LCDBusTrace_h
+
+#include <inttypes.h>
+#include <Print.h>
+
+/*!
+ @defined
+ @abstract   Enables the bus trace.
+ @discussion Uncomment to compile the trace into the drivers. Libraries are
+ built separately from the sketch, it has to be defined here.
+ */
+// #define LCD_BUS_TRACE
+
+/*!
+ @defined
+ @abstract   Number of bytes of the sequence kept from the start.
+ */
+#ifndef LCDBT_CAPTURE_SIZE
+#define LCDBT_CAPTURE_SIZE    32
+#endif
+
+/*!
+ @defined
+ @abstract   Records a byte put on the bus.
+ */
+#ifdef LCD_BUS_TRACE
+#define LCD_TRACE_BUS(value)  LCDBusTrace::record ( value )
+#else
+#define LCD_TRACE_BUS(value)
+#endif
+
+class LCDBusTrace
+{
+public:
+   /*!
+    @function
+    @abstract   Starts a new trace.
+    */
+   static void start ( void );
+
+   /*!
+    @function
+    @abstract   Records a byte put on the bus.
+    @discussion Drivers call it through LCD_TRACE_BUS.
+    */
+   static void record ( uint8_t value );
+
+   /*!
+    @function
+    @abstract   Number of bytes recorded since the start.
+    */
+   static unsigned long count ( void );
+
+   /*!
+    @function
+    @abstract   CRC-16 (CCITT) of the bytes recorded since the start.
+    */
+   static uint16_t crc ( void );
+
+   /*!
+    @function
+    @abstract   Prints the bytes captured from the start, in hexadecimal.
+    */
+   static void dump ( Print &out );
+
+private:
+   static unsigned long _count;                        // Bytes recorded
+   static uint16_t      _crc;                          // CRC of the sequence
+   static uint8_t       _capture[LCDBT_CAPTURE_SIZE];  // Start of the sequence
+};
+
+#endif
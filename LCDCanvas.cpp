@@ -0,0 +1,132 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LCDCanvas.cpp
+// This file implements a text canvas larger than the LCD, shown through an
+// LCDViewport.
+//
+// @brief
+// The cursor is allowed past the right edge and below the last row so that
+// clipped text keeps its place: whatever follows a '\n' still lands on the
+// right row.
+//
+// ---------------------------------------------------------------------------
+#include <string.h>
+#include <inttypes.h>
+
+#if (ARDUINO <  100)
+#include <WProgram.h>
+#else
+#include <Arduino.h>
+#endif
+
+#include "LCDCanvas.h"
+
+// CONSTRUCTORS
+// ---------------------------------------------------------------------------
+LCDCanvas::LCDCanvas ( uint8_t *buffer, uint8_t cols, uint8_t rows )
+{
+   _cells = buffer;
+   _cols  = cols;
+   _rows  = rows;
+   clear ( );
+}
+
+// PUBLIC METHODS
+// ---------------------------------------------------------------------------
+
+//
+// clear
+void LCDCanvas::clear ( void )
+{
+   memset ( _cells, ' ', ( uint16_t )_cols * _rows );
+   _col = 0;
+   _row = 0;
+}
+
+//
+// setCursor
+void LCDCanvas::setCursor ( uint8_t col, uint8_t row )
+{
+   _col = col;
+   _row = row;
+}
+
+//
+// write
+#if (ARDUINO <  100)
+void LCDCanvas::write ( uint8_t value )
+#else
+size_t LCDCanvas::write ( uint8_t value )
+#endif
+{
+   if ( value == '\n' )
+   {
+      _col = 0;
+      if ( _row < 255 )
+      {
+         _row++;
+      }
+   }
+   else if ( value == '\r' )
+   {
+      _col = 0;
+   }
+   else
+   {
+      if ( ( _col < _cols ) && ( _row < _rows ) )
+      {
+         _cells[( uint16_t )_row * _cols + _col] = value;
+      }
+      if ( _col < 255 )
+      {
+         _col++;
+      }
+   }
+#if (ARDUINO >=  100)
+   return ( 1 );
+#endif
+}
+
+//
+// charAt
+uint8_t LCDCanvas::charAt ( uint8_t col, uint8_t row )
+{
+   if ( ( col >= _cols ) || ( row >= _rows ) )
+   {
+      return ( ' ' );
+   }
+   return ( _cells[( uint16_t )row * _cols + col] );
+}
+
+//
+// line
+const uint8_t *LCDCanvas::line ( uint8_t row )
+{
+   if ( row >= _rows )
+   {
+      return ( 0 );
+   }
+   return ( &_cells[( uint16_t )row * _cols] );
+}
+
+//
+// cols
+uint8_t LCDCanvas::cols ( void )
+{
+   return ( _cols );
+}
+
+//
+// rows
+uint8_t LCDCanvas::rows ( void )
+{
+   return ( _rows );
+}
@@ -0,0 +1,119 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LCDCanvas.h
+// This file implements a text canvas larger than the LCD, shown through an
+// LCDViewport.
+//
+// @brief
+// The canvas is a grid of characters held in memory, of any size up to
+// 255x255, written with the usual Print methods (print, write) after
+// placing the cursor with setCursor. Writing doesn't send anything to an
+// LCD: the part of the canvas shown is chosen and sent by an LCDViewport.
+//
+//   uint8_t   cells[64 * 16];
+//   LCDCanvas canvas(cells, 64, 16);
+//
+//   canvas.setCursor ( 0, 10 );
+//   canvas.print ( "Line 10 of the log" );
+//
+// Text is clipped at the right edge of the canvas, a new line ('\n') moves
+// the cursor to the start of the next row. The memory is given by the
+// application, cols * rows bytes, as it is usually larger than a sketch
+// would want reserved by the library.
+//
+// ---------------------------------------------------------------------------
+#ifndef LCDCanvas_h
+#define LCDCanvas_h
+
+#include <inttypes.h>
+#include <Print.h>
+
+class LCDCanvas : public Print
+{
+public:
+   /*!
+    @method
+    @abstract   Class constructor.
+    @discussion The canvas is cleared.
+
+    @param      buffer[in] cols * rows bytes holding the canvas.
+    @param      cols[in] number of columns of the canvas.
+    @param      rows[in] number of rows of the canvas.
+    */
+   LCDCanvas ( uint8_t *buffer, uint8_t cols, uint8_t rows );
+
+   /*!
+    @function
+    @abstract   Clears the canvas and moves the cursor to (0, 0).
+    */
+   void clear ( void );
+
+   /*!
+    @function
+    @abstract   Moves the cursor.
+    @discussion Text written outside of the canvas is dropped.
+
+    @param      col[in] column, from 0.
+    @param      row[in] row, from 0.
+    */
+   void setCursor ( uint8_t col, uint8_t row );
+
+   /*!
+    @function
+    @abstract   Writes a character at the cursor.
+    @discussion All Print class methods end up calling this method. '\n'
+    moves the cursor to the start of the next row, '\r' to the start of the
+    row.
+
+    @param      value[in] character to write.
+    */
+#if (ARDUINO <  100)
+   virtual void write ( uint8_t value );
+#else
+   virtual size_t write ( uint8_t value );
+#endif
+   using Print::write;
+
+   /*!
+    @function
+    @abstract   Character at a position.
+    @result     the character, a space outside of the canvas.
+    */
+   uint8_t charAt ( uint8_t col, uint8_t row );
+
+   /*!
+    @function
+    @abstract   Characters of a row, cols() bytes.
+    @result     the row, 0 outside of the canvas.
+    */
+   const uint8_t *line ( uint8_t row );
+
+   /*!
+    @function
+    @abstract   Number of columns of the canvas.
+    */
+   uint8_t cols ( void );
+
+   /*!
+    @function
+    @abstract   Number of rows of the canvas.
+    */
+   uint8_t rows ( void );
+
+private:
+   uint8_t *_cells;                    // Canvas, row after row
+   uint8_t  _cols;                     // Columns
+   uint8_t  _rows;                     // Rows
+   uint8_t  _col;                      // Cursor column
+   uint8_t  _row;                      // Cursor row
+};
+
+#endif
@@ -0,0 +1,329 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LCDDecoder.cpp
+// This file implements the display side of the binary display protocol
+// (@see LCDProtocol.h).
+//
+// @brief
+// A frame is received whole and its records are checked before applying
+// any of them, so a corrupted frame never reaches the LCD.
+//
+// ---------------------------------------------------------------------------
+#include <inttypes.h>
+
+#if (ARDUINO <  100)
+#include <WProgram.h>
+#else
+#include <Arduino.h>
+#endif
+
+#include "LCDDecoder.h"
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+
+// Receiver states
+#define WAIT_SYNC      0
+#define WAIT_LENGTH    1
+#define WAIT_PAYLOAD   2
+#define WAIT_CHECKSUM  3
+
+// CONSTRUCTORS
+// ---------------------------------------------------------------------------
+LCDDecoder::LCDDecoder ( LCD &lcd, uint8_t cols, uint8_t rows ) : _lcd ( lcd )
+{
+   _cols     = cols;
+   _rows     = rows;
+   _col      = 0;
+   _row      = 0;
+   _placed   = false;
+   _state    = WAIT_SYNC;
+   _length   = 0;
+   _received = 0;
+   _sum      = 0;
+   _errors   = 0;
+}
+
+// PUBLIC METHODS
+// ---------------------------------------------------------------------------
+
+//
+// feed
+int LCDDecoder::feed ( uint8_t value )
+{
+   switch ( _state )
+   {
+      case WAIT_SYNC:
+         if ( value == LCDP_SYNC )
+         {
+            _state = WAIT_LENGTH;
+         }
+         break;
+
+      case WAIT_LENGTH:
+         if ( ( value == 0 ) || ( value > LCDP_MAX_PAYLOAD ) )
+         {
+            _errors++;
+            _state = ( value == LCDP_SYNC ) ? WAIT_LENGTH : WAIT_SYNC;
+            break;
+         }
+         _length   = value;
+         _received = 0;
+         _sum      = value;
+         _state    = WAIT_PAYLOAD;
+         break;
+
+      case WAIT_PAYLOAD:
+         _payload[_received++] = value;
+         _sum += value;
+         if ( _received == _length )
+         {
+            _state = WAIT_CHECKSUM;
+         }
+         break;
+
+      case WAIT_CHECKSUM:
+         _state = WAIT_SYNC;
+         if ( ( uint8_t )( _sum + value ) != 0 )
+         {
+            _errors++;
+            return ( 0 );
+         }
+         if ( !apply ( ) )
+         {
+            _errors++;
+            return ( 0 );
+         }
+         return ( 1 );
+   }
+   return ( 0 );
+}
+
+//
+// errors
+uint8_t LCDDecoder::errors ( void )
+{
+   return ( _errors );
+}
+
+// PRIVATE METHODS
+// ---------------------------------------------------------------------------
+
+//
+// apply
+int LCDDecoder::apply ( void )
+{
+   uint8_t header;
+   uint8_t length;
+   uint8_t pos;
+   uint8_t i;
+
+   // First pass checks the records, second one applies them
+   for ( uint8_t pass = 0; pass < 2; pass++ )
+   {
+      bool positioned = false;
+
+      for ( i = 0; i < _length; )
+      {
+         header = _payload[i++];
+         length = ( header & LCDP_LEN_MASK ) + 1;
+
+         if ( ( header & LCDP_TYPE_MASK ) == LCDP_CONTROL )
+         {
+            if ( header & LCDP_POS )
+            {
+               return ( 0 );
+            }
+            switch ( header & LCDP_LEN_MASK )
+            {
+               case LCDP_CLEAR:
+                  if ( pass == 1 )
+                  {
+                     _lcd.clear ( );
+                     _col    = 0;
+                     _row    = 0;
+                     _placed = true;
+                  }
+                  positioned = true;
+                  break;
+
+               case LCDP_MODE:
+                  if ( i + 1 > _length )
+                  {
+                     return ( 0 );
+                  }
+                  if ( pass == 1 )
+                  {
+                     mode ( _payload[i] );
+                  }
+                  i += 1;
+                  break;
+
+               case LCDP_BACKLIGHT:
+                  if ( i + 1 > _length )
+                  {
+                     return ( 0 );
+                  }
+                  if ( pass == 1 )
+                  {
+                     _lcd.setBacklight ( _payload[i] );
+                  }
+                  i += 1;
+                  break;
+
+               case LCDP_GLYPH:
+                  if ( ( i + 9 > _length ) || ( _payload[i] > 7 ) )
+                  {
+                     return ( 0 );
+                  }
+                  if ( pass == 1 )
+                  {
+                     _lcd.createChar ( _payload[i], &_payload[i + 1] );
+                     _placed = false;   // left addressing the CGRAM
+                  }
+                  i += 9;
+                  break;
+
+               default:
+                  return ( 0 );
+            }
+            continue;
+         }
+
+         if ( header & LCDP_POS )
+         {
+            if ( i + 1 > _length )
+            {
+               return ( 0 );
+            }
+            pos = _payload[i++];
+            if ( ( ( pos & 0x3F ) >= _cols ) || ( ( pos >> 6 ) >= _rows ) )
+            {
+               return ( 0 );
+            }
+            if ( pass == 1 )
+            {
+               _col    = pos & 0x3F;
+               _row    = pos >> 6;
+               _placed = false;
+            }
+            positioned = true;
+         }
+         else if ( !positioned )
+         {
+            return ( 0 );               // nowhere to continue from
+         }
+
+         switch ( header & LCDP_TYPE_MASK )
+         {
+            case LCDP_TEXT:
+               if ( i + length > _length )
+               {
+                  return ( 0 );
+               }
+               if ( pass == 1 )
+               {
+                  text ( &_payload[i], length );
+               }
+               i += length;
+               break;
+
+            case LCDP_REPEAT:
+               if ( i + 1 > _length )
+               {
+                  return ( 0 );
+               }
+               for ( uint8_t n = 0; ( pass == 1 ) && ( n < length ); n++ )
+               {
+                  put ( _payload[i] );
+               }
+               i += 1;
+               break;
+
+            default:
+               return ( 0 );
+         }
+      }
+   }
+   return ( 1 );
+}
+
+//
+// mode
+void LCDDecoder::mode ( uint8_t flags )
+{
+   if ( flags & LCDP_MODE_DISPLAY )
+   {
+      _lcd.display ( );
+   }
+   else
+   {
+      _lcd.noDisplay ( );
+   }
+   if ( flags & LCDP_MODE_CURSOR )
+   {
+      _lcd.cursor ( );
+   }
+   else
+   {
+      _lcd.noCursor ( );
+   }
+   if ( flags & LCDP_MODE_BLINK )
+   {
+      _lcd.blink ( );
+   }
+   else
+   {
+      _lcd.noBlink ( );
+   }
+}
+
+//
+// put
+void LCDDecoder::put ( uint8_t value )
+{
+   text ( &value, 1 );
+}
+
+//
+// text
+void LCDDecoder::text ( const uint8_t *text, uint8_t length )
+{
+   uint8_t chunk;
+
+   while ( length > 0 )
+   {
+      if ( !_placed )
+      {
+         _lcd.setCursor ( _col, _row );
+         _placed = true;
+      }
+
+      // Up to the end of the row in one go
+      chunk = _cols - _col;
+      if ( chunk > length )
+      {
+         chunk = length;
+      }
+      _lcd.write ( text, chunk );
+      text   += chunk;
+      length -= chunk;
+      _col   += chunk;
+
+      // Rows aren't consecutive in the LCD memory, the next row is addressed
+      if ( _col == _cols )
+      {
+         _col    = 0;
+         _row    = ( _row + 1 ) % _rows;
+         _placed = false;
+      }
+   }
+}
@@ -0,0 +1,110 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LCDDecoder.h
+// This file implements the display side of the binary display protocol
+// (@see LCDProtocol.h).
+//
+// @brief
+// The decoder takes the bytes received, one at a time, and applies every
+// complete and correct frame to an LCD.
+//
+//   LCDDecoder decoder(lcd, 20, 4);
+//
+//   void loop()
+//   {
+//      while ( Serial.available() )
+//      {
+//         decoder.feed ( Serial.read() );
+//      }
+//   }
+//
+// ---------------------------------------------------------------------------
+#ifndef LCDDecoder_h
+#define LCDDecoder_h
+
+#include <inttypes.h>
+
+#include "LCD.h"
+#include "LCDProtocol.h"
+
+class LCDDecoder
+{
+public:
+   /*!
+    @method
+    @abstract   Class constructor.
+
+    @param      lcd[in] LCD the frames are applied to, it has to be
+    initialised by the application.
+    @param      cols[in] number of columns of the LCD.
+    @param      rows[in] number of rows of the LCD.
+    */
+   LCDDecoder ( LCD &lcd, uint8_t cols, uint8_t rows );
+
+   /*!
+    @function
+    @abstract   Takes a received byte.
+    @discussion When the byte completes a frame, the frame is checked and
+    applied to the LCD.
+
+    @param      value[in] byte received.
+    @result     1 if a frame has been applied, 0 otherwise.
+    */
+   int feed ( uint8_t value );
+
+   /*!
+    @function
+    @abstract   Number of frames discarded.
+    @discussion Frames with a wrong length, checksum or contents.
+    */
+   uint8_t errors ( void );
+
+private:
+   /*!
+    @function
+    @abstract   Applies the records of the frame received.
+    @result     1 if all the records were correct, 0 otherwise.
+    */
+   int apply ( void );
+
+   /*!
+    @function
+    @abstract   Applies the mode flags.
+    */
+   void mode ( uint8_t flags );
+
+   /*!
+    @function
+    @abstract   Writes a character at the decoder cursor.
+    */
+   void put ( uint8_t value );
+
+   /*!
+    @function
+    @abstract   Writes characters at the decoder cursor.
+    */
+   void text ( const uint8_t *text, uint8_t length );
+
+   LCD     &_lcd;                        // Target LCD
+   uint8_t  _cols;                       // Display columns
+   uint8_t  _rows;                       // Display rows
+   uint8_t  _col;                        // Decoder cursor column
+   uint8_t  _row;                        // Decoder cursor row
+   bool     _placed;                     // LCD cursor at the decoder cursor
+   uint8_t  _state;                      // Receiver state
+   uint8_t  _length;                     // Payload length
+   uint8_t  _received;                   // Payload bytes received
+   uint8_t  _sum;                        // Running checksum
+   uint8_t  _errors;                     // Frames discarded
+   uint8_t  _payload[LCDP_MAX_PAYLOAD];  // Frame being received
+};
+
+#endif
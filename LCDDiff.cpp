@@ -0,0 +1,126 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: Yes
+// Extendable: Yes
+//
+// @file LCDDiff.cpp
+// This file implements the search of the changes between two screens.
+//
+// @brief
+// Each wider step stops at the first block that differs and leaves it to
+// the next narrower one: 16 byte blocks, then words, then bytes. Words are
+// read with memcpy as the screens don't have to be aligned, compilers turn
+// it into a single load.
+//
+// ---------------------------------------------------------------------------
+#include <inttypes.h>
+#include <string.h>
+
+#include "LCDDiff.h"
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+
+#if defined ( __SSE2__ )
+#include <emmintrin.h>
+#define DIFF_BLOCK        16
+#endif
+
+// Word compared at once, none on 8 bit MCUs
+#if !defined ( __AVR__ )
+#if ( defined ( UINTPTR_MAX ) && ( UINTPTR_MAX > 0xFFFFFFFF ) ) || \
+    ( __SIZEOF_POINTER__ == 8 )
+#define DIFF_WORD         uint64_t
+#else
+#define DIFF_WORD         uint32_t
+#endif
+#endif
+
+// PRIVATE FUNCTIONS
+// ---------------------------------------------------------------------------
+
+#ifdef DIFF_BLOCK
+//
+// sameBlock
+static inline bool sameBlock ( const uint8_t *a, const uint8_t *b )
+{
+   __m128i x = _mm_loadu_si128 ( ( const __m128i * )a );
+   __m128i y = _mm_loadu_si128 ( ( const __m128i * )b );
+
+   return ( _mm_movemask_epi8 ( _mm_cmpeq_epi8 ( x, y ) ) == 0xFFFF );
+}
+#endif
+
+#ifdef DIFF_WORD
+//
+// sameWord
+static inline bool sameWord ( const uint8_t *a, const uint8_t *b )
+{
+   DIFF_WORD x;
+   DIFF_WORD y;
+
+   memcpy ( &x, a, sizeof ( x ) );
+   memcpy ( &y, b, sizeof ( y ) );
+   return ( x == y );
+}
+#endif
+
+// PUBLIC FUNCTIONS
+// ---------------------------------------------------------------------------
+
+//
+// lcd_diffFirst
+size_t lcd_diffFirst ( const uint8_t *a, const uint8_t *b, size_t size )
+{
+   size_t i = 0;
+
+#ifdef DIFF_BLOCK
+   while ( ( i + DIFF_BLOCK <= size ) && sameBlock ( &a[i], &b[i] ) )
+   {
+      i += DIFF_BLOCK;
+   }
+#endif
+#ifdef DIFF_WORD
+   while ( ( i + sizeof ( DIFF_WORD ) <= size ) && sameWord ( &a[i], &b[i] ) )
+   {
+      i += sizeof ( DIFF_WORD );
+   }
+#endif
+   while ( ( i < size ) && ( a[i] == b[i] ) )
+   {
+      i++;
+   }
+   return ( i );
+}
+
+//
+// lcd_diffLast
+size_t lcd_diffLast ( const uint8_t *a, const uint8_t *b, size_t size )
+{
+   size_t end = size;
+
+#ifdef DIFF_BLOCK
+   while ( ( end >= DIFF_BLOCK ) &&
+           sameBlock ( &a[end - DIFF_BLOCK], &b[end - DIFF_BLOCK] ) )
+   {
+      end -= DIFF_BLOCK;
+   }
+#endif
+#ifdef DIFF_WORD
+   while ( ( end >= sizeof ( DIFF_WORD ) ) &&
+           sameWord ( &a[end - sizeof ( DIFF_WORD )], &b[end - sizeof ( DIFF_WORD )] ) )
+   {
+      end -= sizeof ( DIFF_WORD );
+   }
+#endif
+   while ( ( end > 0 ) && ( a[end - 1] == b[end - 1] ) )
+   {
+      end--;
+   }
+   return ( end );
+}
@@ -0,0 +1,60 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: Yes
+// Extendable: Yes
+//
+// @file LCDDiff.h
+// This file implements the search of the changes between two screens.
+//
+// @brief
+// Finding what changed between the screen shown and a new one is a byte by
+// byte comparison, most of it over unchanged characters. These functions
+// compare a machine word at a time (4 bytes on 32 bit MCUs, 8 on 64 bit
+// hosts), 16 bytes at a time with SSE2 on hosts that have it, to skip the
+// unchanged parts quickly and then find the exact character within the
+// word that differs. On 8 bit MCUs a word is a byte and they compare a byte
+// at a time.
+//
+//   first = lcd_diffFirst ( screen, shown, size );
+//   end   = lcd_diffLast ( screen, shown, size );
+//   // the changes are between first and end - 1, none if first == size
+//
+// They don't depend on the Arduino libraries and can be built on the host
+// driving many displays (@see LCDEncoder).
+//
+// ---------------------------------------------------------------------------
+#ifndef LCDDiff_h
+#define LCDDiff_h
+
+#include <inttypes.h>
+#include <stddef.h>
+
+/*!
+ @function
+ @abstract   First character that differs between two screens.
+
+ @param      a[in] a screen.
+ @param      b[in] the other screen.
+ @param      size[in] number of characters of the screens.
+ @result     index of the first character that differs, size if none does.
+ */
+size_t lcd_diffFirst ( const uint8_t *a, const uint8_t *b, size_t size );
+
+/*!
+ @function
+ @abstract   End of the changes between two screens.
+
+ @param      a[in] a screen.
+ @param      b[in] the other screen.
+ @param      size[in] number of characters of the screens.
+ @result     index following the last character that differs, 0 if none
+ does.
+ */
+size_t lcd_diffLast ( const uint8_t *a, const uint8_t *b, size_t size );
+
+#endif
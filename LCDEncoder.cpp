@@ -0,0 +1,254 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LCDEncoder.cpp
+// This file implements the sending side of the binary display protocol
+// (@see LCDProtocol.h).
+//
+// @brief
+// A record costs a header and, unless it continues where the previous one
+// ended, a position byte. A repeat of n characters costs 2 bytes against n
+// as text, plus the header of the text that follows it, so runs of 4 or
+// more are worth a repeat. An unchanged cell between two changes costs 1
+// byte sent again against 2 to address the next change.
+//
+// ---------------------------------------------------------------------------
+#include <inttypes.h>
+#include <string.h>
+
+#include "LCDEncoder.h"
+#include "LCDDiff.h"
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+
+// Shortest run sent as a repeat
+#define MIN_REPEAT    4
+
+// No record encoded yet, the next one needs a position
+#define NO_CURSOR     0xFF
+
+// CONSTRUCTORS
+// ---------------------------------------------------------------------------
+LCDEncoder::LCDEncoder ( uint8_t cols, uint8_t rows )
+{
+   // Keep within the screen copy, the rows that don't fit are left out
+   _cols = ( cols > LCDP_MAX_COLS ) ? LCDP_MAX_COLS : cols;
+   _rows = ( rows > LCDP_MAX_ROWS ) ? LCDP_MAX_ROWS : rows;
+   if ( ( uint16_t )_cols * _rows > LCDP_MAX_CELLS )
+   {
+      _rows = LCDP_MAX_CELLS / _cols;
+   }
+   invalidate ( );
+}
+
+// PUBLIC METHODS
+// ---------------------------------------------------------------------------
+
+//
+// invalidate
+void LCDEncoder::invalidate ( void )
+{
+   memset ( _shown, ' ', sizeof ( _shown ) );
+   _clear = true;
+}
+
+//
+// encode
+uint16_t LCDEncoder::encode ( const uint8_t *screen, uint8_t *out, uint16_t size )
+{
+   uint8_t  payload[LCDP_MAX_PAYLOAD];
+   uint8_t  length  = 0;
+   uint16_t written = 0;
+   uint16_t framed;
+   uint16_t cells   = ( uint16_t )_cols * _rows;
+   uint8_t  cursor  = NO_CURSOR;
+   uint8_t  first;
+   uint8_t  last;
+   uint8_t  cell;
+   uint8_t  count;
+   uint8_t  header;
+   uint8_t  bytes;
+
+   if ( _clear )
+   {
+      payload[length++] = LCDP_CONTROL | LCDP_CLEAR;
+      cursor = 0;
+   }
+
+   for ( first = 0; first < cells; first++ )
+   {
+      // Skip the unchanged cells a word at a time
+      first += lcd_diffFirst ( &screen[first], &_shown[first], cells - first );
+      if ( first == cells )
+      {
+         break;
+      }
+
+      // Take in the next changes as long as a single cell is unchanged
+      last = first;
+      for ( cell = first + 1; ( cell < cells ) && ( cell <= last + 2 ); cell++ )
+      {
+         if ( screen[cell] != _shown[cell] )
+         {
+            last = cell;
+         }
+      }
+
+      for ( cell = first; cell <= last; cell += count )
+      {
+         count = run ( screen, cell, last );
+         if ( count >= MIN_REPEAT )
+         {
+            header = LCDP_REPEAT | ( count - 1 );
+            bytes  = 2;
+         }
+         else
+         {
+            // Text up to the next run worth a repeat
+            count = 1;
+            while ( ( cell + count <= last ) && ( count < LCDP_MAX_RUN ) &&
+                    ( run ( screen, cell + count, last ) < MIN_REPEAT ) )
+            {
+               count++;
+            }
+            header = LCDP_TEXT | ( count - 1 );
+            bytes  = 1 + count;
+         }
+
+         // Start a new frame, the record will need a position then
+         if ( length + bytes + 1 > LCDP_MAX_PAYLOAD )
+         {
+            framed = frame ( payload, length, &out[written], size - written );
+            if ( framed == 0 )
+            {
+               return ( 0 );
+            }
+            written += framed;
+            length   = 0;
+            cursor   = NO_CURSOR;
+         }
+
+         if ( cursor != cell )
+         {
+            payload[length++] = header | LCDP_POS;
+            payload[length++] = LCDP_POSITION ( cell % _cols, cell / _cols );
+         }
+         else
+         {
+            payload[length++] = header;
+         }
+
+         if ( ( header & LCDP_TYPE_MASK ) == LCDP_REPEAT )
+         {
+            payload[length++] = screen[cell];
+         }
+         else
+         {
+            memcpy ( &payload[length], &screen[cell], count );
+            length += count;
+         }
+         cursor = ( cell + count ) % cells;
+      }
+      first = last;
+   }
+
+   if ( length > 0 )
+   {
+      framed = frame ( payload, length, &out[written], size - written );
+      if ( framed == 0 )
+      {
+         return ( 0 );
+      }
+      written += framed;
+   }
+
+   if ( written > 0 )
+   {
+      memcpy ( _shown, screen, cells );
+      _clear = false;
+   }
+   return ( written );
+}
+
+//
+// glyph
+uint16_t LCDEncoder::glyph ( uint8_t index, const uint8_t *bitmap, uint8_t *out,
+                             uint16_t size )
+{
+   uint8_t payload[10];
+
+   payload[0] = LCDP_CONTROL | LCDP_GLYPH;
+   payload[1] = index;
+   memcpy ( &payload[2], bitmap, 8 );
+   return ( frame ( payload, sizeof ( payload ), out, size ) );
+}
+
+//
+// mode
+uint16_t LCDEncoder::mode ( uint8_t flags, uint8_t *out, uint16_t size )
+{
+   uint8_t payload[2];
+
+   payload[0] = LCDP_CONTROL | LCDP_MODE;
+   payload[1] = flags;
+   return ( frame ( payload, sizeof ( payload ), out, size ) );
+}
+
+//
+// backlight
+uint16_t LCDEncoder::backlight ( uint8_t value, uint8_t *out, uint16_t size )
+{
+   uint8_t payload[2];
+
+   payload[0] = LCDP_CONTROL | LCDP_BACKLIGHT;
+   payload[1] = value;
+   return ( frame ( payload, sizeof ( payload ), out, size ) );
+}
+
+// PRIVATE METHODS
+// ---------------------------------------------------------------------------
+
+//
+// frame
+uint16_t LCDEncoder::frame ( const uint8_t *payload, uint8_t length,
+                             uint8_t *out, uint16_t size )
+{
+   uint8_t sum = length;
+
+   if ( ( uint16_t )length + 3 > size )
+   {
+      return ( 0 );
+   }
+
+   out[0] = LCDP_SYNC;
+   out[1] = length;
+   for ( uint8_t i = 0; i < length; i++ )
+   {
+      out[2 + i] = payload[i];
+      sum += payload[i];
+   }
+   out[2 + length] = ( uint8_t )( 0 - sum );
+   return ( length + 3 );
+}
+
+//
+// run
+uint8_t LCDEncoder::run ( const uint8_t *screen, uint8_t from, uint8_t last )
+{
+   uint8_t count = 1;
+
+   while ( ( from + count <= last ) && ( count < LCDP_MAX_RUN ) &&
+           ( screen[from + count] == screen[from] ) )
+   {
+      count++;
+   }
+   return ( count );
+}
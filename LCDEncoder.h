@@ -0,0 +1,136 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LCDEncoder.h
+// This file implements the sending side of the binary display protocol
+// (@see LCDProtocol.h).
+//
+// @brief
+// The encoder keeps a copy of the screen last sent and turns every new
+// screen into the frames that update only the cells that changed. It
+// doesn't depend on the Arduino libraries, it can be built into the host
+// (PLC, PC, ...) driving the remote displays as well as into a sketch.
+//
+//   LCDEncoder encoder(20, 4);
+//   uint8_t    frames[LCDP_MAX_ENCODED];
+//
+//   length = encoder.encode ( screen, frames, sizeof ( frames ) );
+//   // send length bytes of frames
+//
+// Screens of up to LCDP_MAX_COLS columns, LCDP_MAX_ROWS rows and
+// LCDP_MAX_CELLS cells: a 40x4 screen is encoded as its top 40x2.
+//
+// ---------------------------------------------------------------------------
+#ifndef LCDEncoder_h
+#define LCDEncoder_h
+
+#include <inttypes.h>
+
+#include "LCDProtocol.h"
+
+class LCDEncoder
+{
+public:
+   /*!
+    @method
+    @abstract   Class constructor.
+    @discussion The first screen encoded clears the display and sends all
+    the cells that aren't blank. Columns are limited to LCDP_MAX_COLS, rows
+    to LCDP_MAX_ROWS and to those that fit in LCDP_MAX_CELLS.
+
+    @param      cols[in] number of columns of the display.
+    @param      rows[in] number of rows of the display.
+    */
+   LCDEncoder ( uint8_t cols, uint8_t rows );
+
+   /*!
+    @function
+    @abstract   Forgets the screen last sent.
+    @discussion To be called when the display may have lost its contents
+    (display reset, frames lost), the next screen is sent whole.
+    */
+   void invalidate ( void );
+
+   /*!
+    @function
+    @abstract   Encodes the changes from the screen last sent.
+    @discussion Runs of 4 or more equal characters are sent as a repeat,
+    other changes as text, single unchanged cells between changes are sent
+    again rather than addressing the next change. The screen is taken as
+    sent only if it has been encoded whole.
+
+    @param      screen[in] characters of the screen, cols * rows bytes, one
+    row after the other.
+    @param      out[out] buffer for the frames.
+    @param      size[in] size of the buffer, LCDP_MAX_ENCODED is enough for
+    any screen.
+    @result     number of bytes written to out, 0 if the screen hasn't
+    changed or the buffer is too small.
+    */
+   uint16_t encode ( const uint8_t *screen, uint8_t *out, uint16_t size );
+
+   /*!
+    @function
+    @abstract   Encodes a custom character upload.
+
+    @param      index[in] custom character (0 to 7).
+    @param      bitmap[in] 8 rows of the custom character.
+    @param      out[out] buffer for the frame.
+    @param      size[in] size of the buffer.
+    @result     number of bytes written to out, 0 if the buffer is too small.
+    */
+   uint16_t glyph ( uint8_t index, const uint8_t *bitmap, uint8_t *out,
+                    uint16_t size );
+
+   /*!
+    @function
+    @abstract   Encodes a display mode change.
+
+    @param      flags[in] LCDP_MODE_DISPLAY, LCDP_MODE_CURSOR and
+    LCDP_MODE_BLINK set.
+    @param      out[out] buffer for the frame.
+    @param      size[in] size of the buffer.
+    @result     number of bytes written to out, 0 if the buffer is too small.
+    */
+   uint16_t mode ( uint8_t flags, uint8_t *out, uint16_t size );
+
+   /*!
+    @function
+    @abstract   Encodes a backlight change.
+
+    @param      value[in] backlight value.
+    @param      out[out] buffer for the frame.
+    @param      size[in] size of the buffer.
+    @result     number of bytes written to out, 0 if the buffer is too small.
+    */
+   uint16_t backlight ( uint8_t value, uint8_t *out, uint16_t size );
+
+private:
+   /*!
+    @function
+    @abstract   Writes a frame around a payload.
+    @result     number of bytes written to out, 0 if the buffer is too small.
+    */
+   uint16_t frame ( const uint8_t *payload, uint8_t length, uint8_t *out,
+                    uint16_t size );
+
+   /*!
+    @function
+    @abstract   Length of the run of equal characters starting at a cell.
+    */
+   uint8_t run ( const uint8_t *screen, uint8_t from, uint8_t last );
+
+   uint8_t _cols;                       // Display columns
+   uint8_t _rows;                       // Display rows
+   bool    _clear;                      // Next screen sent whole
+   uint8_t _shown[LCDP_MAX_CELLS];      // Screen last sent
+};
+
+#endif
@@ -0,0 +1,396 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LCDEquivalence.cpp
+// This file implements a differential check of an optimised LCD path
+// against plain writes to the LCD.
+//
+// @brief
+// The arguments of each call are drawn once and the call is made on both
+// sides, so both get exactly the same sequence whatever the path does. The
+// random generator is a 32 bit xorshift, the same on every platform.
+//
+// ---------------------------------------------------------------------------
+#include <string.h>
+#include <inttypes.h>
+
+#if (ARDUINO <  100)
+#include <WProgram.h>
+#else
+#include <Arduino.h>
+#endif
+
+#include "LCDEquivalence.h"
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+
+// Calls
+#define OP_SET_CURSOR    0
+#define OP_PRINT         1
+#define OP_WRITE         2
+#define OP_CLEAR         3
+#define OP_HOME          4
+#define OP_GLYPH         5
+#define OP_DISPLAY       6
+#define OP_CURSOR        7
+#define OP_BLINK         8
+#define OP_BACKLIGHT     9
+#define OP_SCROLL        10
+#define OP_MOVE_CURSOR   11
+#define OP_DIRECTION     12
+#define OP_AUTOSCROLL    13
+
+// Longest call argument: a text, longer than a row
+#define MAX_DATA         24
+
+// CONSTRUCTORS
+// ---------------------------------------------------------------------------
+LCDEquivalence::LCDEquivalence ( LCD &optimised, LCDSimulator &target,
+                                 LCDSimulator &reference, t_lcdSync sync ) :
+   _optimised ( optimised ), _target ( target ), _reference ( reference )
+{
+   _sync   = sync;
+   _cols   = 0;
+   _rows   = 0;
+   _seed   = 1;
+   _steps  = 0;
+   _failed = 0;
+}
+
+// PUBLIC METHODS
+// ---------------------------------------------------------------------------
+
+//
+// begin
+void LCDEquivalence::begin ( uint8_t cols, uint8_t rows )
+{
+   _cols = cols;
+   _rows = rows;
+
+   _reference.begin ( cols, rows );
+   _optimised.begin ( cols, rows );
+   if ( _sync != 0 )
+   {
+      _sync ( );
+   }
+   _reference.resetCounters ( );
+   _target.resetCounters ( );
+}
+
+//
+// run
+int LCDEquivalence::run ( uint16_t steps, uint32_t seed, uint8_t groups )
+{
+   _seed   = ( seed != 0 ) ? seed : 1;     // xorshift never leaves 0
+   _steps  = 0;
+   _failed = 0;
+
+   while ( _steps < steps )
+   {
+      step ( groups );
+      _steps++;
+      if ( ( ( _steps % LCDEQ_STEPS ) == 0 ) || ( _steps == steps ) )
+      {
+         if ( !compare ( ) )
+         {
+            _failed = _steps;
+            return ( 0 );
+         }
+      }
+   }
+   return ( 1 );
+}
+
+//
+// compare
+int LCDEquivalence::compare ( void )
+{
+   if ( _sync != 0 )
+   {
+      _sync ( );
+   }
+
+   // What is shown, a path can shift the display instead of rewriting it
+   for ( uint8_t row = 0; row < _rows; row++ )
+   {
+      for ( uint8_t col = 0; col < _cols; col++ )
+      {
+         if ( _target.charAt ( col, row ) != _reference.charAt ( col, row ) )
+         {
+            return ( 0 );
+         }
+      }
+   }
+
+   if ( ( memcmp ( _target.cgram ( ), _reference.cgram ( ), LCDSIM_CGRAM_SIZE ) != 0 ) ||
+        ( _target.control ( ) != _reference.control ( ) ) ||
+        ( _target.backlightValue ( ) != _reference.backlightValue ( ) ) )
+   {
+      return ( 0 );
+   }
+
+   // Where the cursor is only matters while it is seen
+   if ( ( _reference.control ( ) & ( LCD_CURSORON | LCD_BLINKON ) ) &&
+        ( _target.viewAddress ( ) != _reference.viewAddress ( ) ) )
+   {
+      return ( 0 );
+   }
+   return ( 1 );
+}
+
+//
+// failedStep
+uint16_t LCDEquivalence::failedStep ( void )
+{
+   return ( _failed );
+}
+
+//
+// report
+void LCDEquivalence::report ( Print &out )
+{
+   unsigned long plain = _reference.busTime ( );
+   unsigned long fast  = _target.busTime ( );
+
+   out.print ( "Calls: " );
+   out.println ( _steps );
+   out.print ( "Reference: " );
+   out.print ( _reference.sends ( ) );
+   out.print ( " sends, " );
+   out.print ( plain );
+   out.println ( " us" );
+   out.print ( "Optimised: " );
+   out.print ( _target.sends ( ) );
+   out.print ( " sends, " );
+   out.print ( fast );
+   out.println ( " us" );
+   if ( plain > 0 )
+   {
+      out.print ( "Bus time saved: " );
+      out.print ( ( fast < plain ) ? ( ( plain - fast ) * 100 ) / plain : 0 );
+      out.println ( "%" );
+   }
+   if ( _failed != 0 )
+   {
+      out.print ( "Differ after call " );
+      out.println ( _failed );
+   }
+}
+
+// PRIVATE METHODS
+// ---------------------------------------------------------------------------
+
+//
+// step
+void LCDEquivalence::step ( uint8_t groups )
+{
+   // Text is most of what applications do
+   const uint8_t op[20]    = { OP_SET_CURSOR, OP_SET_CURSOR, OP_SET_CURSOR,
+                               OP_PRINT, OP_PRINT, OP_PRINT, OP_PRINT,
+                               OP_WRITE, OP_WRITE, OP_CLEAR, OP_HOME,
+                               OP_GLYPH, OP_DISPLAY, OP_CURSOR, OP_BLINK,
+                               OP_BACKLIGHT, OP_SCROLL, OP_MOVE_CURSOR,
+                               OP_DIRECTION, OP_AUTOSCROLL };
+   const uint8_t group[20] = { LCDEQ_TEXT, LCDEQ_TEXT, LCDEQ_TEXT,
+                               LCDEQ_TEXT, LCDEQ_TEXT, LCDEQ_TEXT, LCDEQ_TEXT,
+                               LCDEQ_TEXT, LCDEQ_TEXT, LCDEQ_CLEAR, LCDEQ_CLEAR,
+                               LCDEQ_GLYPHS, LCDEQ_CONTROL, LCDEQ_CONTROL,
+                               LCDEQ_CONTROL, LCDEQ_CONTROL, LCDEQ_SHIFT,
+                               LCDEQ_SHIFT, LCDEQ_ENTRY, LCDEQ_ENTRY };
+   uint8_t data[MAX_DATA];
+   uint8_t length = 0;
+   uint8_t pick;
+   uint8_t i;
+
+   if ( ( groups & LCDEQ_ALL ) == 0 )
+   {
+      return;
+   }
+   do
+   {
+      pick = next ( ) % sizeof ( op );
+   } while ( !( groups & group[pick] ) );
+   pick = op[pick];
+
+   switch ( pick )
+   {
+      case OP_SET_CURSOR:
+         data[length++] = next ( ) % _cols;
+         data[length++] = next ( ) % _rows;
+         break;
+
+      case OP_PRINT:
+         length = 1 + next ( ) % MAX_DATA;
+         for ( i = 0; i < length; i++ )
+         {
+            data[i] = ' ' + next ( ) % 95;
+         }
+         break;
+
+      case OP_WRITE:
+         // Custom characters as well
+         data[length++] = ( next ( ) & 3 ) ? ' ' + next ( ) % 95 : next ( ) % 8;
+         break;
+
+      case OP_GLYPH:
+         data[length++] = next ( ) % 8;
+         for ( i = 0; i < 8; i++ )
+         {
+            data[length++] = next ( ) & 0x1F;
+         }
+         data[length++] = next ( ) % _cols;
+         data[length++] = next ( ) % _rows;
+         break;
+
+      case OP_BACKLIGHT:
+         data[length++] = next ( ) & 0xFF;
+         break;
+
+      case OP_CLEAR:
+      case OP_HOME:
+         break;
+
+      default:
+         // On or off, left or right
+         data[length++] = next ( ) & 1;
+   }
+
+   call ( _optimised, pick, data, length );
+   call ( _reference, pick, data, length );
+}
+
+//
+// call
+void LCDEquivalence::call ( LCD &lcd, uint8_t op, const uint8_t *data,
+                            uint8_t length )
+{
+   uint8_t charmap[8];
+
+   switch ( op )
+   {
+      case OP_SET_CURSOR:
+         lcd.setCursor ( data[0], data[1] );
+         break;
+
+      case OP_PRINT:
+         lcd.write ( data, length );
+         break;
+
+      case OP_WRITE:
+         lcd.write ( data[0] );
+         break;
+
+      case OP_CLEAR:
+         lcd.clear ( );
+         break;
+
+      case OP_HOME:
+         lcd.home ( );
+         break;
+
+      case OP_GLYPH:
+         memcpy ( charmap, &data[1], sizeof ( charmap ) );
+         lcd.createChar ( data[0], charmap );
+         lcd.setCursor ( data[9], data[10] );    // back to the DDRAM
+         break;
+
+      case OP_DISPLAY:
+         if ( data[0] )
+         {
+            lcd.display ( );
+         }
+         else
+         {
+            lcd.noDisplay ( );
+         }
+         break;
+
+      case OP_CURSOR:
+         if ( data[0] )
+         {
+            lcd.cursor ( );
+         }
+         else
+         {
+            lcd.noCursor ( );
+         }
+         break;
+
+      case OP_BLINK:
+         if ( data[0] )
+         {
+            lcd.blink ( );
+         }
+         else
+         {
+            lcd.noBlink ( );
+         }
+         break;
+
+      case OP_BACKLIGHT:
+         lcd.setBacklight ( data[0] );
+         break;
+
+      case OP_SCROLL:
+         if ( data[0] )
+         {
+            lcd.scrollDisplayLeft ( );
+         }
+         else
+         {
+            lcd.scrollDisplayRight ( );
+         }
+         break;
+
+      case OP_MOVE_CURSOR:
+         if ( data[0] )
+         {
+            lcd.moveCursorLeft ( );
+         }
+         else
+         {
+            lcd.moveCursorRight ( );
+         }
+         break;
+
+      case OP_DIRECTION:
+         if ( data[0] )
+         {
+            lcd.leftToRight ( );
+         }
+         else
+         {
+            lcd.rightToLeft ( );
+         }
+         break;
+
+      case OP_AUTOSCROLL:
+         if ( data[0] )
+         {
+            lcd.autoscroll ( );
+         }
+         else
+         {
+            lcd.noAutoscroll ( );
+         }
+         break;
+   }
+}
+
+//
+// next
+uint16_t LCDEquivalence::next ( void )
+{
+   _seed ^= _seed << 13;
+   _seed ^= _seed >> 17;
+   _seed ^= _seed << 5;
+   return ( _seed >> 16 );
+}
@@ -0,0 +1,183 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LCDEquivalence.h
+// This file implements a differential check of an optimised LCD path
+// against plain writes to the LCD.
+//
+// @brief
+// Optimisations (buffering, skipping redundant commands, merging writes,
+// shorter waits) must leave the LCD exactly as the plain path does. The
+// check makes the same random sequence of LCD calls (setCursor, print,
+// write, clear, home, createChar, display control, shifts, entry mode,
+// backlight) on the optimised path, whose output goes to a simulated LCD,
+// and straight on a reference simulated LCD, one send per character or
+// command. After every few calls both simulators are compared: the
+// characters shown (the DDRAM through the display shift, as a path may
+// shift the display instead of rewriting it), CGRAM, display control,
+// backlight and, while the cursor is shown, its position on the display.
+// The bus time of both sides is added up to report what the optimisation
+// saves.
+//
+//   LCDSimulator         target;
+//   LCDSimulator         reference;
+//   LiquidCrystal_Buffer buffer(target);
+//
+//   void flushBuffer ( void ) { buffer.flush ( ); }
+//
+//   LCDEquivalence check(buffer, target, reference, flushBuffer);
+//
+//   check.begin ( 20, 4 );
+//   if ( !check.run ( 1000, seed ) )
+//   {
+//      // check.failedStep() tells where it went wrong
+//   }
+//   check.report ( Serial );
+//
+// Runs are reproducible: the same seed makes the same calls.
+//
+// The host tests run it on LiquidCrystal_Buffer for every display size
+// (test/test_equivalence.cpp, "make -C test").
+//
+// ---------------------------------------------------------------------------
+#ifndef LCDEquivalence_h
+#define LCDEquivalence_h
+
+#include <inttypes.h>
+#include <Print.h>
+
+#include "LCD.h"
+#include "LCDSimulator.h"
+
+/*!
+ @defined
+ @abstract   Groups of calls made by a run.
+ @discussion LCDEQ_TEXT: setCursor, print, write.
+ LCDEQ_CLEAR: clear, home.
+ LCDEQ_GLYPHS: createChar, followed by setCursor as the LCD is left
+ addressing the CGRAM.
+ LCDEQ_CONTROL: display, cursor and blink on and off, backlight.
+ LCDEQ_SHIFT: display and cursor shifts.
+ LCDEQ_ENTRY: text direction and autoscroll.
+ */
+#define LCDEQ_TEXT         0x01
+#define LCDEQ_CLEAR        0x02
+#define LCDEQ_GLYPHS       0x04
+#define LCDEQ_CONTROL      0x08
+#define LCDEQ_SHIFT        0x10
+#define LCDEQ_ENTRY        0x20
+#define LCDEQ_ALL          0x3F
+
+/*!
+ @defined
+ @abstract   Number of calls between comparisons.
+ @discussion Comparing after fewer calls finds the call that went wrong
+ sooner, but leaves the optimised path less to optimise between syncs.
+ */
+#ifndef LCDEQ_STEPS
+#define LCDEQ_STEPS        8
+#endif
+
+/*!
+ @typedef
+ @abstract   Function bringing the output of the optimised path up to date,
+ i.e. flushing a buffer.
+ */
+typedef void ( *t_lcdSync ) ( void );
+
+class LCDEquivalence
+{
+public:
+   /*!
+    @method
+    @abstract   Class constructor.
+
+    @param      optimised[in] LCD path under test.
+    @param      target[in] simulated LCD the optimised path writes to, it
+    can be the optimised path itself (a driver option).
+    @param      reference[in] simulated LCD written the plain way.
+    @param      sync[in] called before comparing, 0 if the optimised path
+    writes straight away.
+    */
+   LCDEquivalence ( LCD &optimised, LCDSimulator &target,
+                    LCDSimulator &reference, t_lcdSync sync = 0 );
+
+   /*!
+    @function
+    @abstract   Initialises both sides to a given size (col, row).
+    @discussion The time counters start from here.
+    */
+   void begin ( uint8_t cols, uint8_t rows );
+
+   /*!
+    @function
+    @abstract   Makes a run of random calls on both sides.
+    @discussion Compares both sides every LCDEQ_STEPS calls and at the end
+    of the run, stopping at the first difference.
+
+    @param      steps[in] number of calls.
+    @param      seed[in] seed of the random sequence.
+    @param      groups[in] groups of calls to make (LCDEQ_TEXT, ...).
+    @result     1 if both sides stayed the same, 0 otherwise.
+    */
+   int run ( uint16_t steps, uint32_t seed, uint8_t groups = LCDEQ_ALL );
+
+   /*!
+    @function
+    @abstract   Compares both sides.
+    @discussion Calls the synchronisation function first.
+    @result     1 if both simulated LCDs are the same, 0 otherwise.
+    */
+   int compare ( void );
+
+   /*!
+    @function
+    @abstract   Call of the last run after which the sides differed, 0 if
+    they didn't.
+    */
+   uint16_t failedStep ( void );
+
+   /*!
+    @function
+    @abstract   Prints the sends and bus time of both sides.
+    */
+   void report ( Print &out );
+
+private:
+   /*!
+    @function
+    @abstract   Makes a random call on both sides.
+    */
+   void step ( uint8_t groups );
+
+   /*!
+    @function
+    @abstract   Makes a call on a side.
+    */
+   void call ( LCD &lcd, uint8_t op, const uint8_t *data, uint8_t length );
+
+   /*!
+    @function
+    @abstract   Next random number.
+    */
+   uint16_t next ( void );
+
+   LCD          &_optimised;              // Path under test
+   LCDSimulator &_target;                 // Output of the path under test
+   LCDSimulator &_reference;              // Plain path
+   t_lcdSync     _sync;                   // Brings the target up to date
+   uint8_t       _cols;                   // Display columns
+   uint8_t       _rows;                   // Display rows
+   uint32_t      _seed;                   // Random state
+   uint16_t      _steps;                  // Calls made
+   uint16_t      _failed;                 // Call after which they differed
+};
+
+#endif
@@ -0,0 +1,294 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LCDMenu.cpp
+// This file implements a hierarchical menu stored in flash.
+//
+// @brief
+// Only the visible items are rendered and only the characters that differ
+// from what is on the display are written.
+//
+// ---------------------------------------------------------------------------
+#include <string.h>
+#include <inttypes.h>
+
+#if (ARDUINO <  100)
+#include <WProgram.h>
+#else
+#include <Arduino.h>
+#endif
+
+#include "LCDMenu.h"
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+#ifdef __AVR__
+#define LCDMENU_READ(dst, src, size)  memcpy_P ( dst, src, size )
+#define LCDMENU_READ_BYTE(src)        pgm_read_byte_near ( src )
+#else
+#define LCDMENU_READ(dst, src, size)  memcpy ( dst, src, size )
+#define LCDMENU_READ_BYTE(src)        ( *(const uint8_t *)(src) )
+#endif
+
+// CONSTRUCTORS
+// ---------------------------------------------------------------------------
+LCDMenu::LCDMenu ( LCD &lcd, uint8_t cols, uint8_t rows ) : _lcd ( lcd )
+{
+   _cols  = ( cols > LCDMENU_MAX_COLS ) ? LCDMENU_MAX_COLS : cols;
+   _rows  = rows;
+   _menu  = NULL;
+   _top   = 0;
+   _sel   = 0;
+   _drawn = false;
+   _depth = 0;
+}
+
+// PUBLIC METHODS
+// ---------------------------------------------------------------------------
+
+//
+// begin
+void LCDMenu::begin ( const t_lcdMenu *menu )
+{
+   _depth = 0;
+   _drawn = false;
+   show ( menu, 0, 0 );
+}
+
+//
+// redraw
+void LCDMenu::redraw ( void )
+{
+   _drawn = false;
+   show ( _menu, _top, _sel );
+}
+
+//
+// next
+int LCDMenu::next ( void )
+{
+   uint8_t top = _top;
+
+   if ( ( _menu == NULL ) || ( _sel + 1 >= LCDMENU_READ_BYTE ( &_menu->numItems ) ) )
+   {
+      return ( 0 );
+   }
+   if ( _sel + 1 >= _top + _rows )
+   {
+      top++;
+   }
+   show ( _menu, top, _sel + 1 );
+   return ( 1 );
+}
+
+//
+// prev
+int LCDMenu::prev ( void )
+{
+   uint8_t top = _top;
+
+   if ( ( _menu == NULL ) || ( _sel == 0 ) )
+   {
+      return ( 0 );
+   }
+   if ( _sel - 1 < _top )
+   {
+      top--;
+   }
+   show ( _menu, top, _sel - 1 );
+   return ( 1 );
+}
+
+//
+// select
+uint8_t LCDMenu::select ( void )
+{
+   t_lcdMenuItem item;
+
+   if ( _menu == NULL )
+   {
+      return ( LCDMENU_NONE );
+   }
+   readItem ( _menu, _sel, item );
+   if ( ( item.submenu == NULL ) || ( _depth >= LCDMENU_MAX_DEPTH ) )
+   {
+      return ( item.id );
+   }
+
+   _parent[_depth]    = _menu;
+   _parentTop[_depth] = _top;
+   _parentSel[_depth] = _sel;
+   _depth++;
+   show ( item.submenu, 0, 0 );
+   return ( LCDMENU_NONE );
+}
+
+//
+// back
+int LCDMenu::back ( void )
+{
+   if ( _depth == 0 )
+   {
+      return ( 0 );
+   }
+   _depth--;
+   show ( _parent[_depth], _parentTop[_depth], _parentSel[_depth] );
+   return ( 1 );
+}
+
+//
+// selected
+uint8_t LCDMenu::selected ( void )
+{
+   t_lcdMenuItem item;
+
+   if ( _menu == NULL )
+   {
+      return ( LCDMENU_NONE );
+   }
+   readItem ( _menu, _sel, item );
+   return ( item.id );
+}
+
+// PRIVATE METHODS
+// ---------------------------------------------------------------------------
+
+//
+// show
+void LCDMenu::show ( const t_lcdMenu *menu, uint8_t top, uint8_t sel )
+{
+   char     shown[LCDMENU_MAX_COLS];
+   char     buffer[LCDMENU_MAX_COLS];
+   uint8_t  start;
+   uint8_t  end;
+   uint8_t  row;
+   uint8_t  done = 0;               // rows updated
+   uint8_t  addr = 0xFF;            // LCD address counter, unknown
+   uint16_t maxGap = _lcd.maxBridgeGap ( );
+
+   for ( uint8_t n = 0; n < _rows; n++ )
+   {
+      // Rows in DDRAM order, the address counter runs from the end of a row
+      // into the next one (see LCD::writeScreen).
+      row = 0xFF;
+      for ( uint8_t r = 0; r < _rows; r++ )
+      {
+         if ( done & ( 1 << r ) )
+         {
+            continue;
+         }
+         if ( _lcd.address ( 0, r ) == addr )
+         {
+            row = r;
+            break;
+         }
+         if ( ( row == 0xFF ) || ( _lcd.address ( 0, r ) < _lcd.address ( 0, row ) ) )
+         {
+            row = r;
+         }
+      }
+      done |= ( 1 << row );
+
+      renderRow ( buffer, menu, top, sel, row );
+      if ( !_drawn )
+      {
+         memset ( shown, 0, _cols );   // unknown, all the row is written
+      }
+      else
+      {
+         // Items are in flash, what is on the display can be rendered
+         // again instead of keeping a copy of it.
+         renderRow ( shown, _menu, _top, _sel, row );
+      }
+
+      for ( uint8_t i = 0; i < _cols; )
+      {
+         if ( shown[i] == buffer[i] )
+         {
+            i++;
+            continue;
+         }
+
+         // Run of changes, including the gaps of unchanged characters
+         // that are cheaper to rewrite than addressing the next change.
+         start = i;
+         end   = i;
+         for ( uint16_t gap = 0; ( i < _cols ) && ( gap <= maxGap ); i++ )
+         {
+            if ( shown[i] != buffer[i] )
+            {
+               end = i;
+               gap = 0;
+            }
+            else
+            {
+               gap++;
+            }
+         }
+         i = end + 1;
+
+         if ( _lcd.address ( start, row ) != addr )
+         {
+            _lcd.setCursor ( start, row );
+         }
+         _lcd.write ( (const uint8_t *)&buffer[start], end - start + 1 );
+         addr = _lcd.address ( end + 1, row );
+         if ( ( addr & 0x3F ) == 40 )
+         {
+            addr = ( addr & 0x40 ) ^ 0x40;
+         }
+      }
+   }
+
+   _menu  = menu;
+   _top   = top;
+   _sel   = sel;
+   _drawn = true;
+}
+
+//
+// renderRow
+void LCDMenu::renderRow ( char *buffer, const t_lcdMenu *menu, uint8_t top,
+                          uint8_t sel, uint8_t row )
+{
+   t_lcdMenuItem item;
+   uint8_t       i = 1;
+
+   memset ( buffer, ' ', _cols );
+   if ( ( menu == NULL ) || ( top + row >= LCDMENU_READ_BYTE ( &menu->numItems ) ) )
+   {
+      return;
+   }
+   if ( top + row == sel )
+   {
+      buffer[0] = LCDMENU_MARKER;
+   }
+   readItem ( menu, top + row, item );
+   for ( const char *text = item.text; i < _cols; i++ )
+   {
+      char c = (char)LCDMENU_READ_BYTE ( text++ );
+
+      if ( c == '\0' )
+      {
+         break;
+      }
+      buffer[i] = c;
+   }
+}
+
+//
+// readItem
+void LCDMenu::readItem ( const t_lcdMenu *menu, uint8_t index, t_lcdMenuItem &item )
+{
+   t_lcdMenu m;
+
+   LCDMENU_READ ( &m, menu, sizeof ( m ) );
+   LCDMENU_READ ( &item, &m.items[index], sizeof ( item ) );
+}
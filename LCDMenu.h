@@ -0,0 +1,211 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LCDMenu.h
+// This file implements a hierarchical menu stored in flash.
+//
+// @brief
+// The menu shows a window of as many items as rows the LCD has, the
+// selected item is marked on the first column. Only the visible items are
+// ever read from flash and rendered, and the LCD is never cleared: every
+// change (moving the selection, scrolling, entering or leaving a submenu)
+// is drawn as the difference between what is on the display and what has
+// to be shown. Moving the selection within the window only rewrites the two
+// marker characters, scrolling only rewrites the characters of the rows
+// that differ from the items they replace.
+//
+//   const char setTxt[]  PROGMEM = "Settings";
+//   const char infoTxt[] PROGMEM = "Info";
+//   const t_lcdMenuItem mainItems[] PROGMEM = { { setTxt, &settings, 0 },
+//                                               { infoTxt, NULL, 1 } };
+//   const t_lcdMenu mainMenu PROGMEM = { mainItems, 2 };
+//
+//   menu.begin ( &mainMenu );
+//   ...
+//   if ( encoderUp ) menu.prev ( );
+//   if ( encoderDown ) menu.next ( );
+//   if ( button ) id = menu.select ( );
+//
+// ---------------------------------------------------------------------------
+#ifndef LCDMenu_h
+#define LCDMenu_h
+
+#include <inttypes.h>
+
+#include "LCD.h"
+
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+
+/*!
+ @defined
+ @abstract   Maximum submenu nesting depth.
+ */
+#ifndef LCDMENU_MAX_DEPTH
+#define LCDMENU_MAX_DEPTH    4
+#endif
+
+/*!
+ @defined
+ @abstract   Maximum number of columns of the LCD.
+ */
+#define LCDMENU_MAX_COLS     20
+
+/*!
+ @defined
+ @abstract   Selection marker.
+ */
+#ifndef LCDMENU_MARKER
+#define LCDMENU_MARKER       '>'
+#endif
+
+/*!
+ @defined
+ @abstract   No item selected.
+ @discussion Returned by select when a submenu has been entered.
+ */
+#define LCDMENU_NONE         0xFF
+
+struct t_lcdMenu;
+
+/*!
+ @typedef
+ @abstract   Menu item.
+ @discussion text is a string stored in flash. Items with a submenu enter
+ it when selected, the rest return their id.
+ */
+typedef struct
+{
+   const char             *text;
+   const struct t_lcdMenu *submenu;
+   uint8_t                 id;
+} t_lcdMenuItem;
+
+/*!
+ @typedef
+ @abstract   Menu.
+ @discussion The menu and its items are stored in flash.
+ */
+typedef struct t_lcdMenu
+{
+   const t_lcdMenuItem *items;
+   uint8_t              numItems;
+} t_lcdMenu;
+
+class LCDMenu
+{
+public:
+   /*!
+    @method
+    @abstract   Class constructor.
+    @discussion Initializes class variables.
+
+    @param      lcd[in] LCD where the menu is shown, it has to be initialised
+    by the application.
+    @param      cols[in] number of columns of the LCD.
+    @param      rows[in] number of rows of the LCD.
+    */
+   LCDMenu ( LCD &lcd, uint8_t cols, uint8_t rows );
+
+   /*!
+    @function
+    @abstract   Shows a menu.
+    @discussion Shows the menu with its first item selected, the whole
+    display is rewritten.
+
+    @param      menu[in] root menu stored in flash.
+    */
+   void begin ( const t_lcdMenu *menu );
+
+   /*!
+    @function
+    @abstract   Redraws the menu.
+    @discussion Rewrites the whole display, i.e. after having used the LCD
+    directly.
+    */
+   void redraw ( void );
+
+   /*!
+    @function
+    @abstract   Selects the next item.
+    @result     1 if the selection has moved, 0 if on the last item.
+    */
+   int next ( void );
+
+   /*!
+    @function
+    @abstract   Selects the previous item.
+    @result     1 if the selection has moved, 0 if on the first item.
+    */
+   int prev ( void );
+
+   /*!
+    @function
+    @abstract   Activates the selected item.
+    @discussion Enters the submenu of the selected item, if it has one.
+
+    @result     id of the selected item or LCDMENU_NONE if a submenu has
+    been entered.
+    */
+   uint8_t select ( void );
+
+   /*!
+    @function
+    @abstract   Returns to the parent menu.
+    @discussion The parent menu is shown with the item that was selected to
+    enter the submenu selected.
+
+    @result     1 if the parent menu is shown, 0 if on the root menu.
+    */
+   int back ( void );
+
+   /*!
+    @function
+    @abstract   Returns the id of the selected item.
+    */
+   uint8_t selected ( void );
+
+private:
+   /*!
+    @function
+    @abstract   Changes the menu state updating the display.
+    @discussion Each visible row is compared against the row currently on
+    the display and only the characters that differ are written.
+    */
+   void show ( const t_lcdMenu *menu, uint8_t top, uint8_t sel );
+
+   /*!
+    @function
+    @abstract   Renders a row of a menu into a buffer.
+    */
+   void renderRow ( char *buffer, const t_lcdMenu *menu, uint8_t top,
+                    uint8_t sel, uint8_t row );
+
+   /*!
+    @function
+    @abstract   Reads an item from flash.
+    */
+   void readItem ( const t_lcdMenu *menu, uint8_t index, t_lcdMenuItem &item );
+
+   LCD             &_lcd;                       // Target LCD
+   uint8_t          _cols;                      // Display columns
+   uint8_t          _rows;                      // Display rows
+   const t_lcdMenu *_menu;                      // Menu shown (flash)
+   uint8_t          _top;                       // First item shown
+   uint8_t          _sel;                       // Selected item
+   bool             _drawn;                     // Display contents are known
+   uint8_t          _depth;                     // Submenu depth
+   const t_lcdMenu *_parent[LCDMENU_MAX_DEPTH]; // Parent menus
+   uint8_t          _parentTop[LCDMENU_MAX_DEPTH];
+   uint8_t          _parentSel[LCDMENU_MAX_DEPTH];
+};
+
+#endif
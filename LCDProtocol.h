@@ -0,0 +1,123 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: Yes
+// Extendable: Yes
+//
+// @file LCDProtocol.h
+// This file defines a compact binary protocol to drive a display remotely
+// (serial, RS-485, ...) sending only what changes between screens.
+//
+// @brief
+// Frames:
+//
+//   SYNC (0xA5) | LEN | payload (LEN bytes) | CHK
+//
+// LEN is 1 to LCDP_MAX_PAYLOAD, CHK makes LEN + payload + CHK add up to 0
+// (modulo 256). A frame with a wrong length or checksum is discarded.
+//
+// The payload is a sequence of records, each one starting with a header:
+//
+//   bit 7     LCDP_POS: a position byte follows (row << 6 | col)
+//   bits 6-5  record type
+//   bits 4-0  length - 1 (1 to 32) or control code
+//
+//   LCDP_TEXT    [pos] length characters
+//   LCDP_REPEAT  [pos] character, written length times
+//   LCDP_CONTROL LCDP_CLEAR
+//                LCDP_MODE, flags (LCDP_MODE_DISPLAY, _CURSOR, _BLINK)
+//                LCDP_BACKLIGHT, value
+//                LCDP_GLYPH, index, 8 rows of the custom character
+//
+// Text and repeat records without a position continue where the previous
+// record of the frame ended, wrapping from the end of a row to the start of
+// the next one. The first text or repeat record of a frame has a position
+// (or follows a clear), so each frame can be applied on its own.
+//
+// A 20x4 screen is sent whole in under 90 bytes, a change of a few digits
+// in 6 to 8 bytes.
+//
+// ---------------------------------------------------------------------------
+#ifndef LCDProtocol_h
+#define LCDProtocol_h
+
+/*!
+ @defined
+ @abstract   Frame start.
+ */
+#define LCDP_SYNC            0xA5
+
+/*!
+ @defined
+ @abstract   Maximum payload of a frame.
+ @discussion The decoder buffers a whole frame to check it before applying
+ it. Encoder and decoder have to agree on it.
+ */
+#ifndef LCDP_MAX_PAYLOAD
+#define LCDP_MAX_PAYLOAD     96
+#endif
+
+/*!
+ @defined
+ @abstract   Maximum number of cells of a screen (columns * rows).
+ */
+#define LCDP_MAX_CELLS       80
+
+/*!
+ @defined
+ @abstract   Maximum columns and rows of a screen.
+ */
+#define LCDP_MAX_COLS        40
+#define LCDP_MAX_ROWS        4
+
+/*!
+ @defined
+ @abstract   Output buffer size enough to encode any screen change.
+ */
+#define LCDP_MAX_ENCODED     ( 2 * ( LCDP_MAX_PAYLOAD + 3 ) )
+
+/*!
+ @defined
+ @abstract   Record header fields.
+ */
+#define LCDP_POS             0x80
+#define LCDP_TYPE_MASK       0x60
+#define LCDP_LEN_MASK        0x1F
+#define LCDP_MAX_RUN         32
+
+/*!
+ @defined
+ @abstract   Record types.
+ */
+#define LCDP_CONTROL         0x00
+#define LCDP_TEXT            0x20
+#define LCDP_REPEAT          0x40
+
+/*!
+ @defined
+ @abstract   Control codes.
+ */
+#define LCDP_CLEAR           0x00
+#define LCDP_MODE            0x01
+#define LCDP_BACKLIGHT       0x02
+#define LCDP_GLYPH           0x03
+
+/*!
+ @defined
+ @abstract   Mode flags.
+ */
+#define LCDP_MODE_DISPLAY    0x01
+#define LCDP_MODE_CURSOR     0x02
+#define LCDP_MODE_BLINK      0x04
+
+/*!
+ @defined
+ @abstract   Position byte of a cell.
+ */
+#define LCDP_POSITION(col, row)  ( (uint8_t)( ( (row) << 6 ) | (col) ) )
+
+#endif
@@ -0,0 +1,163 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: Yes (one producer, one consumer)
+// Extendable: Yes
+//
+// @file LCDQueue.cpp
+// This file implements a lock free queue of display operations to update the
+// LCD from interrupt handlers.
+//
+// @brief
+// Single producer, single consumer ring. The producer fills a slot and then
+// publishes it moving the head, the consumer reads a slot and then releases
+// it moving the tail.
+//
+// The ring depends on nothing but the compiler, applying the operations to
+// an LCD is in LCDQueueUpdate.cpp.
+//
+// ---------------------------------------------------------------------------
+#include <string.h>
+#include <inttypes.h>
+
+#include "LCDQueue.h"
+
+#if ( LCDQ_SIZE & ( LCDQ_SIZE - 1 ) ) || ( LCDQ_SIZE > 128 )
+#error "LCDQ_SIZE has to be a power of 2 up to 128"
+#endif
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+#define LCDQ_MASK          ( LCDQ_SIZE - 1 )
+
+// Index accesses: acquire loads and release stores so that a slot is never
+// read before it has been written, nor reused before it has been read.
+// Compilers without the __atomic builtins (old avr-gcc) get a volatile access
+// plus a compiler barrier, enough on single core MCUs where byte accesses
+// are atomic.
+#if defined ( __ATOMIC_ACQUIRE )
+#define LCDQ_LOAD(var)           __atomic_load_n ( &(var), __ATOMIC_ACQUIRE )
+#define LCDQ_STORE(var, value)   __atomic_store_n ( &(var), (value), __ATOMIC_RELEASE )
+#else
+#define LCDQ_BARRIER()           __asm__ __volatile__ ( "" ::: "memory" )
+static inline uint8_t lcdqLoad ( volatile uint8_t &var )
+{
+   uint8_t value = var;
+   LCDQ_BARRIER ( );
+   return ( value );
+}
+#define LCDQ_LOAD(var)           lcdqLoad ( var )
+#define LCDQ_STORE(var, value)   do { LCDQ_BARRIER ( ); (var) = (value); } while ( 0 )
+#endif
+
+// CONSTRUCTORS
+// ---------------------------------------------------------------------------
+LCDQueue::LCDQueue ( void )
+{
+   _head    = 0;
+   _tail    = 0;
+   _dropped = 0;
+}
+
+// PUBLIC METHODS
+// ---------------------------------------------------------------------------
+
+//
+// postNumber
+int LCDQueue::postNumber ( uint8_t col, uint8_t row, long value, uint8_t width )
+{
+   t_lcdOp op;
+
+   op.op  = LCDQ_NUMBER;
+   op.col = col;
+   op.row = row;
+   op.arg = width;
+   op.data.number = value;
+   return ( post ( op ) );
+}
+
+//
+// postText
+int LCDQueue::postText ( uint8_t col, uint8_t row, const char *text )
+{
+   t_lcdOp op;
+   uint8_t len;
+
+   for ( len = 0; ( len < LCDQ_TEXT_SIZE ) && ( text[len] != '\0' ); len++ )
+   {
+      op.data.text[len] = text[len];
+   }
+   op.op  = LCDQ_TEXT;
+   op.col = col;
+   op.row = row;
+   op.arg = len;
+   return ( post ( op ) );
+}
+
+//
+// postChar
+int LCDQueue::postChar ( uint8_t col, uint8_t row, uint8_t value )
+{
+   t_lcdOp op;
+
+   op.op  = LCDQ_CHAR;
+   op.col = col;
+   op.row = row;
+   op.arg = value;
+   return ( post ( op ) );
+}
+
+//
+// postBacklight
+int LCDQueue::postBacklight ( uint8_t value )
+{
+   t_lcdOp op;
+
+   op.op  = LCDQ_BACKLIGHT;
+   op.col = 0;
+   op.row = 0;
+   op.arg = value;
+   return ( post ( op ) );
+}
+
+//
+// post
+int LCDQueue::post ( const t_lcdOp &op )
+{
+   uint8_t head = _head;            // only written by this side
+
+   if ( (uint8_t)( head - LCDQ_LOAD ( _tail ) ) >= LCDQ_SIZE )
+   {
+      _dropped = _dropped + 1;
+      return ( 0 );
+   }
+   _ops[head & LCDQ_MASK] = op;
+   LCDQ_STORE ( _head, (uint8_t)( head + 1 ) );
+   return ( 1 );
+}
+
+//
+// pop
+int LCDQueue::pop ( t_lcdOp &op )
+{
+   uint8_t tail = _tail;            // only written by this side
+
+   if ( LCDQ_LOAD ( _head ) == tail )
+   {
+      return ( 0 );
+   }
+   op = _ops[tail & LCDQ_MASK];
+   LCDQ_STORE ( _tail, (uint8_t)( tail + 1 ) );
+   return ( 1 );
+}
+
+//
+// dropped
+uint8_t LCDQueue::dropped ( void )
+{
+   return ( _dropped );
+}
@@ -0,0 +1,210 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: Yes (one producer, one consumer)
+// Extendable: Yes
+//
+// @file LCDQueue.h
+// This file implements a lock free queue of display operations to update the
+// LCD from interrupt handlers.
+//
+// @brief
+// Writing to the LCD from an interrupt handler takes too long and corrupts
+// any transfer the main loop has in progress. Instead, the interrupt handler
+// posts the operation (a number, a short text or a character at a position)
+// to the queue, which takes a few microseconds, and the main loop applies
+// the queued operations to the LCD calling update.
+//
+//   LCDQueue queue;
+//
+//   ISR(INT0_vect)
+//   {
+//      queue.postNumber ( 12, 1, ++count, 4 );
+//   }
+//
+//   void loop()
+//   {
+//      queue.update ( lcd );
+//      ...
+//   }
+//
+// The queue is single producer, single consumer: one context (i.e. an
+// interrupt handler) posts and another one (the main loop) updates. It is
+// a fixed size ring (LCDQ_SIZE operations) without locks, the producer only
+// writes the head and the consumer only writes the tail. Operations posted
+// while the queue is full are dropped and counted.
+//
+// The queue doesn't depend on the LCD for posting and popping operations,
+// any thread can stand in for the interrupt handler. The ring (LCDQueue.cpp)
+// builds on its own, update is in LCDQueueUpdate.cpp.
+//
+// ---------------------------------------------------------------------------
+#ifndef LCDQueue_h
+#define LCDQueue_h
+
+#include <inttypes.h>
+
+class LCD;
+
+/*!
+ @defined
+ @abstract   Number of operations the queue holds.
+ @discussion It has to be a power of 2 up to 128.
+ */
+#ifndef LCDQ_SIZE
+#define LCDQ_SIZE          8
+#endif
+
+/*!
+ @defined
+ @abstract   Maximum length of the text of an operation.
+ */
+#define LCDQ_TEXT_SIZE     8
+
+/*!
+ @defined
+ @abstract   Display operations.
+ @discussion LCDQ_NUMBER: print a number right aligned on a given width.
+ LCDQ_TEXT: print a text (up to LCDQ_TEXT_SIZE characters).
+ LCDQ_CHAR: write a character.
+ LCDQ_BACKLIGHT: set the backlight.
+ */
+#define LCDQ_NUMBER        0
+#define LCDQ_TEXT          1
+#define LCDQ_CHAR          2
+#define LCDQ_BACKLIGHT     3
+
+/*!
+ @typedef
+ @abstract   Display operation.
+ @discussion arg is the width of a number, the length of a text, the
+ character to write or the backlight value depending on the operation.
+ */
+typedef struct
+{
+   uint8_t op;
+   uint8_t col;
+   uint8_t row;
+   uint8_t arg;
+   union
+   {
+      long number;
+      char text[LCDQ_TEXT_SIZE];
+   } data;
+} t_lcdOp;
+
+class LCDQueue
+{
+public:
+   /*!
+    @method
+    @abstract   Class constructor.
+    @discussion Initializes an empty queue.
+    */
+   LCDQueue ( void );
+
+   /*!
+    @function
+    @abstract   Posts a number.
+    @discussion To be called by the producer. The number is printed right
+    aligned on width characters, '*' if it doesn't fit.
+
+    @param      col[in] LCD column.
+    @param      row[in] LCD row.
+    @param      value[in] number to print.
+    @param      width[in] width of the field, 0 to print just the digits.
+    @result     1 if posted, 0 if the queue is full.
+    */
+   int postNumber ( uint8_t col, uint8_t row, long value, uint8_t width );
+
+   /*!
+    @function
+    @abstract   Posts a text.
+    @discussion To be called by the producer. The text is copied, up to
+    LCDQ_TEXT_SIZE characters.
+
+    @param      col[in] LCD column.
+    @param      row[in] LCD row.
+    @param      text[in] text to print.
+    @result     1 if posted, 0 if the queue is full.
+    */
+   int postText ( uint8_t col, uint8_t row, const char *text );
+
+   /*!
+    @function
+    @abstract   Posts a character.
+    @discussion To be called by the producer.
+
+    @param      col[in] LCD column.
+    @param      row[in] LCD row.
+    @param      value[in] character to write.
+    @result     1 if posted, 0 if the queue is full.
+    */
+   int postChar ( uint8_t col, uint8_t row, uint8_t value );
+
+   /*!
+    @function
+    @abstract   Posts a backlight change.
+    @discussion To be called by the producer.
+
+    @param      value[in] backlight value (LCD::setBacklight).
+    @result     1 if posted, 0 if the queue is full.
+    */
+   int postBacklight ( uint8_t value );
+
+   /*!
+    @function
+    @abstract   Posts an operation.
+    @discussion To be called by the producer.
+
+    @param      op[in] operation to post.
+    @result     1 if posted, 0 if the queue is full.
+    */
+   int post ( const t_lcdOp &op );
+
+   /*!
+    @function
+    @abstract   Takes the oldest operation.
+    @discussion To be called by the consumer.
+
+    @param      op[out] operation taken from the queue.
+    @result     1 if an operation has been taken, 0 if the queue is empty.
+    */
+   int pop ( t_lcdOp &op );
+
+   /*!
+    @function
+    @abstract   Applies the queued operations to an LCD.
+    @discussion To be called by the consumer, i.e. from the main loop. The
+    cursor is left after the last operation applied.
+
+    @param      lcd[in] LCD to apply the operations to.
+    @param      max[in] maximum number of operations to apply.
+    @result     number of operations applied.
+    */
+   uint8_t update ( LCD &lcd, uint8_t max = LCDQ_SIZE );
+
+   /*!
+    @function
+    @abstract   Number of operations dropped because the queue was full.
+    */
+   uint8_t dropped ( void );
+
+private:
+   /*!
+    @function
+    @abstract   Applies an operation to an LCD.
+    */
+   void apply ( LCD &lcd, const t_lcdOp &op );
+
+   t_lcdOp          _ops[LCDQ_SIZE];  // Ring of operations
+   volatile uint8_t _head;            // Next to post (written by the producer)
+   volatile uint8_t _tail;            // Next to pop (written by the consumer)
+   volatile uint8_t _dropped;         // Dropped operations (producer)
+};
+
+#endif
@@ -0,0 +1,109 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: Yes (one producer, one consumer)
+// Extendable: Yes
+//
+// @file LCDQueueUpdate.cpp
+// This file implements the application of the queued display operations to
+// the LCD.
+//
+// @brief
+// Kept apart from the ring (LCDQueue.cpp) so that the ring builds and is
+// tested without the LCD and the Arduino core.
+//
+// ---------------------------------------------------------------------------
+#include <inttypes.h>
+
+#if (ARDUINO <  100)
+#include <WProgram.h>
+#else
+#include <Arduino.h>
+#endif
+
+#include "LCD.h"
+#include "LCDQueue.h"
+
+// PUBLIC METHODS
+// ---------------------------------------------------------------------------
+
+//
+// update
+uint8_t LCDQueue::update ( LCD &lcd, uint8_t max )
+{
+   t_lcdOp op;
+   uint8_t count = 0;
+
+   while ( ( count < max ) && pop ( op ) )
+   {
+      apply ( lcd, op );
+      count++;
+   }
+   return ( count );
+}
+
+// PRIVATE METHODS
+// ---------------------------------------------------------------------------
+
+//
+// apply
+void LCDQueue::apply ( LCD &lcd, const t_lcdOp &op )
+{
+   char          buffer[20];        // up to a whole line
+   uint8_t       len = 0;
+   unsigned long number;
+
+   switch ( op.op )
+   {
+      case LCDQ_NUMBER:
+         // Digits from right to left, then the padding
+         number = ( op.data.number < 0 ) ? -(unsigned long)op.data.number :
+                                           (unsigned long)op.data.number;
+         do
+         {
+            buffer[sizeof ( buffer ) - 1 - len++] = '0' + ( number % 10 );
+            number /= 10;
+         } while ( number != 0 );
+         if ( op.data.number < 0 )
+         {
+            buffer[sizeof ( buffer ) - 1 - len++] = '-';
+         }
+         if ( ( op.arg != 0 ) && ( len > op.arg ) )
+         {
+            len = 0;                // doesn't fit
+            while ( len < op.arg )
+            {
+               buffer[sizeof ( buffer ) - 1 - len++] = '*';
+            }
+         }
+         while ( ( len < op.arg ) && ( len < sizeof ( buffer ) ) )
+         {
+            buffer[sizeof ( buffer ) - 1 - len++] = ' ';
+         }
+
+         lcd.setCursor ( op.col, op.row );
+         lcd.write ( (const uint8_t *)&buffer[sizeof ( buffer ) - len], len );
+         break;
+
+      case LCDQ_TEXT:
+         lcd.setCursor ( op.col, op.row );
+         lcd.write ( (const uint8_t *)op.data.text, op.arg );
+         break;
+
+      case LCDQ_CHAR:
+         lcd.setCursor ( op.col, op.row );
+         lcd.write ( op.arg );
+         break;
+
+      case LCDQ_BACKLIGHT:
+         lcd.setBacklight ( op.arg );
+         break;
+
+      default:
+         break;
+   }
+}
@@ -0,0 +1,184 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LCDRecorder.cpp
+// This file implements an LCD that records the session of an application
+// into a compact binary log while forwarding it to a display.
+//
+// @brief
+// The public LCD methods end up as commands and characters sent, which is
+// what is logged. Clear and home are forwarded as such so that the display
+// waits for them to complete, the rest of the commands go through
+// LCD::command.
+//
+// ---------------------------------------------------------------------------
+#include <inttypes.h>
+
+#if (ARDUINO <  100)
+#include <WProgram.h>
+#else
+#include <Arduino.h>
+#endif
+
+#include "LCDRecorder.h"
+
+// CONSTRUCTORS
+// ---------------------------------------------------------------------------
+LCDRecorder::LCDRecorder ( LCD &display, Print &log ) :
+   _display ( display ), _log ( log )
+{
+   _time = 0;
+}
+
+// PUBLIC METHODS
+// ---------------------------------------------------------------------------
+
+//
+// begin
+void LCDRecorder::begin ( uint8_t cols, uint8_t lines, uint8_t dotsize )
+{
+   uint8_t args[3];
+
+   // The recorder doesn't drive any hardware, just initialise its state the
+   // same way LCD::begin leaves an LCD, and initialise the display.
+   _cols     = cols;
+   _numlines = lines;
+   _displayfunction = LCD_4BITMODE | LCD_1LINE | LCD_5x8DOTS;
+   if ( lines > 1 )
+   {
+      _displayfunction |= LCD_2LINE;
+   }
+   _displaycontrol = LCD_DISPLAYON | LCD_CURSOROFF | LCD_BLINKOFF;
+   _displaymode    = LCD_ENTRYLEFT | LCD_ENTRYSHIFTDECREMENT;
+
+   _time   = millis ( );
+   args[0] = cols;
+   args[1] = lines;
+   args[2] = dotsize;
+   record ( LCDR_BEGIN, args, sizeof ( args ) );
+
+   _display.begin ( cols, lines, dotsize );
+}
+
+//
+// write
+size_t LCDRecorder::write ( const uint8_t *buffer, size_t size )
+{
+   size_t  done;
+   uint8_t length;
+
+   // Long strings are logged in several runs
+   for ( done = 0; done < size; done += length )
+   {
+      length = ( size - done > LCDR_MAX_DATA ) ? LCDR_MAX_DATA : size - done;
+      stamp ( );
+      record ( LCDR_DATA | ( length - 1 ), &buffer[done], length );
+   }
+   return ( _display.write ( buffer, size ) );
+}
+
+//
+// beginBatch
+void LCDRecorder::beginBatch ( void )
+{
+   stamp ( );
+   record ( LCDR_BATCH | 0, 0, 0 );
+   _display.beginBatch ( );
+}
+
+//
+// endBatch
+void LCDRecorder::endBatch ( void )
+{
+   stamp ( );
+   record ( LCDR_BATCH | 1, 0, 0 );
+   _display.endBatch ( );
+}
+
+//
+// setBacklight
+void LCDRecorder::setBacklight ( uint8_t value )
+{
+   stamp ( );
+   record ( LCDR_BACKLIGHT, &value, 1 );
+   _display.setBacklight ( value );
+}
+
+//
+// send
+void LCDRecorder::send ( uint8_t value, uint8_t mode )
+{
+   stamp ( );
+   if ( mode == DATA )
+   {
+      record ( LCDR_DATA, &value, 1 );
+      _display.write ( value );
+      return;
+   }
+
+   record ( LCDR_COMMAND, &value, 1 );
+   if ( value == LCD_CLEARDISPLAY )
+   {
+      _display.clear ( );
+   }
+   else if ( ( value & ~0x01 ) == LCD_RETURNHOME )
+   {
+      _display.home ( );
+   }
+   else
+   {
+      _display.command ( value );
+   }
+}
+
+// PRIVATE METHODS
+// ---------------------------------------------------------------------------
+
+//
+// stamp
+void LCDRecorder::stamp ( void )
+{
+   unsigned long now   = millis ( );
+   unsigned long delta = now - _time;
+   uint8_t       args[5];
+   uint8_t       length = 0;
+
+   if ( delta == 0 )
+   {
+      return;
+   }
+   _time = now;
+
+   if ( delta <= LCDR_ARG_MASK )
+   {
+      record ( LCDR_TIME | delta, 0, 0 );
+      return;
+   }
+
+   // Longer pauses, 7 bits at a time, least significant first
+   while ( delta > 0x7F )
+   {
+      args[length++] = ( delta & 0x7F ) | 0x80;
+      delta >>= 7;
+   }
+   args[length++] = delta;
+   record ( LCDR_TIME, args, length );
+}
+
+//
+// record
+void LCDRecorder::record ( uint8_t header, const uint8_t *args, uint8_t length )
+{
+   _log.write ( header );
+   if ( length > 0 )
+   {
+      _log.write ( args, length );
+   }
+}
@@ -0,0 +1,163 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LCDRecorder.h
+// This file implements an LCD that records the session of an application
+// into a compact binary log while forwarding it to a display.
+//
+// @brief
+// The recorder stands in for the display of an application: everything the
+// application does (begin, setCursor, print, createChar, clear, display
+// control, backlight, batches) is forwarded to the display and logged with
+// the time elapsed between operations. The log is written to any Print
+// (Serial, an SD card file, ...) and can be replayed later against any
+// driver or simulator with LCDReplay, i.e. to benchmark drivers with the
+// real workload of an application.
+//
+//   LiquidCrystal_I2C lcd(0x27, 2, 1, 0, 4, 5, 6, 7, 3, POSITIVE);
+//   LCDRecorder       recorder(lcd, Serial);
+//
+//   recorder.begin(20, 4);       // the application uses the recorder
+//   recorder.print("Hello");
+//
+// Log records, a header byte: type in bits 7-5, argument in bits 4-0:
+//
+//   LCDR_TIME       delta of 1 to 31 ms, 0: delta in ms follows (LEB128)
+//   LCDR_COMMAND    LCD command follows
+//   LCDR_DATA       length - 1 (1 to 32), the characters follow
+//   LCDR_BACKLIGHT  backlight value follows
+//   LCDR_BATCH      0 begin, 1 end of a batch
+//   LCDR_BEGIN      columns, rows and character size follow
+//
+// ---------------------------------------------------------------------------
+#ifndef LCDRecorder_h
+#define LCDRecorder_h
+
+#include <inttypes.h>
+#include <Print.h>
+
+#include "LCD.h"
+
+/*!
+ @defined
+ @abstract   Log record types.
+ */
+#define LCDR_TIME            0x00
+#define LCDR_COMMAND         0x20
+#define LCDR_DATA            0x40
+#define LCDR_BACKLIGHT       0x60
+#define LCDR_BATCH           0x80
+#define LCDR_BEGIN           0xA0
+
+/*!
+ @defined
+ @abstract   Log record header fields.
+ */
+#define LCDR_TYPE_MASK       0xE0
+#define LCDR_ARG_MASK        0x1F
+#define LCDR_MAX_DATA        32
+
+class LCDRecorder : public LCD
+{
+public:
+   /*!
+    @method
+    @abstract   Class constructor.
+
+    @param      display[in] display the session is forwarded to.
+    @param      log[in] where the log is written.
+    */
+   LCDRecorder ( LCD &display, Print &log );
+
+   /*!
+    @function
+    @abstract   LCD initialization.
+    @discussion Logs the initialisation and initialises the display to a
+    given size (col, row). Time is counted from here.
+
+    @param      cols[in] the number of columns that the display has
+    @param      rows[in] the number of rows that the display has
+    @param      charsize[in] character size, default==LCD_5x8DOTS
+    */
+   virtual void begin ( uint8_t cols, uint8_t rows, uint8_t charsize = LCD_5x8DOTS );
+
+   /*!
+    @function
+    @abstract   Writes a string of characters.
+    @discussion Logged as a single run and forwarded as a single write, so
+    that the bulk write of the display is replayed as such.
+
+    @param      buffer[in] characters to write.
+    @param      size[in] number of characters to write.
+    */
+   virtual size_t write ( const uint8_t *buffer, size_t size );
+   using LCD::write;
+
+   /*!
+    @function
+    @abstract   Starts a batch of transfers. @see LCD::beginBatch
+    */
+   virtual void beginBatch ( void );
+
+   /*!
+    @function
+    @abstract   Ends a batch of transfers. @see LCD::beginBatch
+    */
+   virtual void endBatch ( void );
+
+   /*!
+    @function
+    @abstract   Switch-on/off the backlight of the display.
+
+    @param      value: backlight value forwarded to the display.
+    */
+   void setBacklight ( uint8_t value );
+
+   /*!
+    @function
+    @abstract   Send a particular value to the display.
+    @discussion Logs the command or character and forwards it.
+
+    Users should never call this method.
+
+    @param      value[in] Value to send to the LCD.
+    @param      mode[in] DATA - write to the LCD CGRAM, COMMAND - write a
+    command to the LCD.
+    */
+   virtual void send ( uint8_t value, uint8_t mode );
+
+protected:
+   /*!
+    @function
+    @abstract   Waits for the LCD to execute a command.
+    @discussion The recorder doesn't need to wait, the display does its own
+    waits when the operations are forwarded to it.
+    */
+   virtual void waitExec ( uint16_t uSec ) { };
+
+private:
+   /*!
+    @function
+    @abstract   Logs the time elapsed since the last record.
+    */
+   void stamp ( void );
+
+   /*!
+    @function
+    @abstract   Logs a record.
+    */
+   void record ( uint8_t header, const uint8_t *args, uint8_t length );
+
+   LCD           &_display;               // Display the session goes to
+   Print         &_log;                   // Where the log is written
+   unsigned long  _time;                  // Time of the last record (ms)
+};
+
+#endif
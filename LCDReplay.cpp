@@ -0,0 +1,161 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LCDReplay.cpp
+// This file implements the replay of the sessions recorded by LCDRecorder
+// on any LCD.
+//
+// @brief
+// Each record is checked to be complete before it is replayed, a truncated
+// log (i.e. the recording was cut) is replayed up to its last whole record.
+//
+// ---------------------------------------------------------------------------
+#include <inttypes.h>
+
+#if (ARDUINO <  100)
+#include <WProgram.h>
+#else
+#include <Arduino.h>
+#endif
+
+#include "LCDReplay.h"
+
+// CONSTRUCTORS
+// ---------------------------------------------------------------------------
+LCDReplay::LCDReplay ( LCD &lcd ) : _lcd ( lcd )
+{
+   _duration   = 0;
+   _operations = 0;
+}
+
+// PUBLIC METHODS
+// ---------------------------------------------------------------------------
+
+//
+// play
+int LCDReplay::play ( const uint8_t *log, size_t size, bool timed )
+{
+   size_t        i = 0;
+   uint8_t       header;
+   uint8_t       length;
+   unsigned long delta;
+   uint8_t       shift;
+
+   _duration   = 0;
+   _operations = 0;
+
+   while ( i < size )
+   {
+      header = log[i++];
+
+      switch ( header & LCDR_TYPE_MASK )
+      {
+         case LCDR_TIME:
+            delta = header & LCDR_ARG_MASK;
+            if ( delta == 0 )
+            {
+               shift = 0;
+               do
+               {
+                  if ( ( i == size ) || ( shift > 28 ) )
+                  {
+                     return ( 0 );
+                  }
+                  delta |= ( unsigned long )( log[i] & 0x7F ) << shift;
+                  shift += 7;
+               } while ( log[i++] & 0x80 );
+            }
+            _duration += delta;
+            if ( timed )
+            {
+               delay ( delta );
+            }
+            continue;
+
+         case LCDR_COMMAND:
+            if ( i + 1 > size )
+            {
+               return ( 0 );
+            }
+            if ( log[i] == LCD_CLEARDISPLAY )
+            {
+               _lcd.clear ( );
+            }
+            else if ( ( log[i] & ~0x01 ) == LCD_RETURNHOME )
+            {
+               _lcd.home ( );
+            }
+            else
+            {
+               _lcd.command ( log[i] );
+            }
+            i += 1;
+            break;
+
+         case LCDR_DATA:
+            length = ( header & LCDR_ARG_MASK ) + 1;
+            if ( i + length > size )
+            {
+               return ( 0 );
+            }
+            _lcd.write ( &log[i], length );
+            i += length;
+            break;
+
+         case LCDR_BACKLIGHT:
+            if ( i + 1 > size )
+            {
+               return ( 0 );
+            }
+            _lcd.setBacklight ( log[i] );
+            i += 1;
+            break;
+
+         case LCDR_BATCH:
+            if ( header & 0x01 )
+            {
+               _lcd.endBatch ( );
+            }
+            else
+            {
+               _lcd.beginBatch ( );
+            }
+            break;
+
+         case LCDR_BEGIN:
+            if ( i + 3 > size )
+            {
+               return ( 0 );
+            }
+            _lcd.begin ( log[i], log[i + 1], log[i + 2] );
+            i += 3;
+            break;
+
+         default:
+            return ( 0 );
+      }
+      _operations++;
+   }
+   return ( 1 );
+}
+
+//
+// duration
+unsigned long LCDReplay::duration ( void )
+{
+   return ( _duration );
+}
+
+//
+// operations
+unsigned long LCDReplay::operations ( void )
+{
+   return ( _operations );
+}
@@ -0,0 +1,85 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LCDReplay.h
+// This file implements the replay of the sessions recorded by LCDRecorder
+// on any LCD.
+//
+// @brief
+// The replay drives an LCD (a driver, LiquidCrystal_Buffer, a simulator,
+// ...) with the operations of a recorded log, the same calls the recorded
+// application made, either as fast as possible to measure the time a
+// driver takes on the real workload, or with the original pauses to watch
+// the session again.
+//
+//   LCDReplay replay(lcd);
+//
+//   replay.play ( log, size );          // as fast as possible
+//   replay.play ( log, size, true );    // in real time
+//
+// The log is read from memory, on a host program it can be loaded from a
+// file captured on the target.
+//
+// ---------------------------------------------------------------------------
+#ifndef LCDReplay_h
+#define LCDReplay_h
+
+#include <inttypes.h>
+#include <stddef.h>
+
+#include "LCD.h"
+#include "LCDRecorder.h"
+
+class LCDReplay
+{
+public:
+   /*!
+    @method
+    @abstract   Class constructor.
+
+    @param      lcd[in] LCD the sessions are replayed on.
+    */
+   LCDReplay ( LCD &lcd );
+
+   /*!
+    @function
+    @abstract   Replays a recorded session.
+    @discussion The LCD is initialised by the begin of the session.
+
+    @param      log[in] session recorded.
+    @param      size[in] size of the log.
+    @param      timed[in] true to wait the time elapsed between operations
+    in the session, false to replay as fast as possible.
+    @result     1 if the whole log has been replayed, 0 if it is truncated or
+    corrupted (replayed up to there).
+    */
+   int play ( const uint8_t *log, size_t size, bool timed = false );
+
+   /*!
+    @function
+    @abstract   Time the recorded session lasted (ms).
+    @discussion Of the last session replayed.
+    */
+   unsigned long duration ( void );
+
+   /*!
+    @function
+    @abstract   Number of operations of the recorded session.
+    @discussion Of the last session replayed, not counting pauses.
+    */
+   unsigned long operations ( void );
+
+private:
+   LCD           &_lcd;                   // LCD the sessions are replayed on
+   unsigned long  _duration;              // Recorded time (ms)
+   unsigned long  _operations;            // Recorded operations
+};
+
+#endif
@@ -0,0 +1,290 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LCDScreen.cpp
+// This file implements retained mode screens: static labels and live fields
+// described by a template stored in flash.
+//
+// @brief
+// Labels are drawn once when entering a screen, fields only write the
+// characters that change.
+//
+// ---------------------------------------------------------------------------
+#include <string.h>
+#include <inttypes.h>
+
+#if (ARDUINO <  100)
+#include <WProgram.h>
+#else
+#include <Arduino.h>
+#endif
+
+#include "LCDScreen.h"
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+#ifdef __AVR__
+#define LCDSCR_READ(dst, src, size)   memcpy_P ( dst, src, size )
+#define LCDSCR_READ_BYTE(src)         pgm_read_byte_near ( src )
+#else
+#define LCDSCR_READ(dst, src, size)   memcpy ( dst, src, size )
+#define LCDSCR_READ_BYTE(src)         ( *(const uint8_t *)(src) )
+#endif
+
+// CONSTRUCTORS
+// ---------------------------------------------------------------------------
+LCDScreen::LCDScreen ( LCD &lcd ) : _lcd ( lcd )
+{
+   _screen = NULL;
+}
+
+// PUBLIC METHODS
+// ---------------------------------------------------------------------------
+
+//
+// enter
+int LCDScreen::enter ( const t_lcdScreen *screen )
+{
+   t_lcdField field;
+   uint8_t    numFields;
+   uint16_t   size = 0;
+
+   numFields = LCDSCR_READ_BYTE ( &screen->numFields );
+   _screen   = screen;
+   if ( numFields > 0 )
+   {
+      size = readField ( numFields - 1, field ) + field.width;
+   }
+   if ( size > LCDSCR_CACHE_SIZE )
+   {
+      _screen = NULL;
+      return ( 0 );
+   }
+
+   memset ( _cache, ' ', sizeof ( _cache ) );
+   _lcd.clear ( );
+   redraw ( );
+   return ( 1 );
+}
+
+//
+// redraw
+void LCDScreen::redraw ( void )
+{
+   t_lcdScreen scr;
+   t_lcdLabel  label;
+   t_lcdField  field;
+   char        buffer[LCDSCR_MAX_WIDTH];
+   uint8_t     len;
+   uint16_t    offset;
+
+   if ( _screen == NULL )
+   {
+      return;
+   }
+   LCDSCR_READ ( &scr, _screen, sizeof ( scr ) );
+
+   // Labels are copied from flash in chunks to write them as strings
+   for ( uint8_t i = 0; i < scr.numLabels; i++ )
+   {
+      const char *text;
+
+      LCDSCR_READ ( &label, &scr.labels[i], sizeof ( label ) );
+      _lcd.setCursor ( label.col, label.row );
+      text = label.text;
+      do
+      {
+         for ( len = 0; len < sizeof ( buffer ); len++ )
+         {
+            buffer[len] = (char)LCDSCR_READ_BYTE ( text++ );
+            if ( buffer[len] == '\0' )
+            {
+               break;
+            }
+         }
+         _lcd.write ( (const uint8_t *)buffer, len );
+      } while ( len == sizeof ( buffer ) );
+   }
+
+   // Blank fields are already blank after a clear
+   for ( uint8_t i = 0; i < scr.numFields; i++ )
+   {
+      offset = readField ( i, field );
+      for ( len = 0; len < field.width; len++ )
+      {
+         if ( _cache[offset + len] != ' ' )
+         {
+            break;
+         }
+      }
+      if ( len < field.width )
+      {
+         _lcd.setCursor ( field.col, field.row );
+         _lcd.write ( (const uint8_t *)&_cache[offset], field.width );
+      }
+   }
+}
+
+//
+// setField
+void LCDScreen::setField ( uint8_t id, long value )
+{
+   t_lcdField field;
+   char       buffer[LCDSCR_MAX_WIDTH];
+
+   if ( ( _screen == NULL ) || ( id >= LCDSCR_READ_BYTE ( &_screen->numFields ) ) )
+   {
+      return;
+   }
+   readField ( id, field );
+   format ( buffer, field.width, field.format, value );
+   update ( id, buffer );
+}
+
+//
+// setField
+void LCDScreen::setField ( uint8_t id, const char *text )
+{
+   t_lcdField field;
+   char       buffer[LCDSCR_MAX_WIDTH];
+   uint8_t    i;
+
+   if ( ( _screen == NULL ) || ( id >= LCDSCR_READ_BYTE ( &_screen->numFields ) ) )
+   {
+      return;
+   }
+   readField ( id, field );
+   for ( i = 0; ( i < field.width ) && ( text[i] != '\0' ); i++ )
+   {
+      buffer[i] = text[i];
+   }
+   for ( ; i < field.width; i++ )
+   {
+      buffer[i] = ' ';
+   }
+   update ( id, buffer );
+}
+
+// PRIVATE METHODS
+// ---------------------------------------------------------------------------
+
+//
+// readField
+uint16_t LCDScreen::readField ( uint8_t id, t_lcdField &field )
+{
+   t_lcdScreen scr;
+   uint16_t    offset = 0;
+
+   // Fields are stored one after the other in the cache
+   LCDSCR_READ ( &scr, _screen, sizeof ( scr ) );
+   for ( uint8_t i = 0; i <= id; i++ )
+   {
+      LCDSCR_READ ( &field, &scr.fields[i], sizeof ( field ) );
+      if ( field.width > LCDSCR_MAX_WIDTH )
+      {
+         field.width = LCDSCR_MAX_WIDTH;
+      }
+      if ( i < id )
+      {
+         offset += field.width;
+      }
+   }
+   return ( offset );
+}
+
+//
+// format
+void LCDScreen::format ( char *buffer, uint8_t width, uint8_t fmt, long value )
+{
+   unsigned long number;
+   uint8_t base     = ( fmt == LCDSCR_HEX ) ? 16 : 10;
+   uint8_t decimals = ( ( fmt & 0xF0 ) == LCDSCR_FIXED(0) ) ? ( fmt & 0x0F ) : 0;
+   bool    negative = ( value < 0 ) && ( base == 10 );
+   uint8_t digits   = 0;
+   int8_t  i        = width - 1;
+
+   number = negative ? -(unsigned long)value : (unsigned long)value;
+
+   // Digits from right to left, at least one before the decimal point
+   do
+   {
+      if ( ( decimals != 0 ) && ( digits == decimals ) && ( i >= 0 ) )
+      {
+         buffer[i--] = '.';
+      }
+      if ( i < 0 )
+      {
+         break;
+      }
+      buffer[i--] = "0123456789ABCDEF"[number % base];
+      number /= base;
+      digits++;
+   } while ( ( number != 0 ) || ( digits <= decimals ) );
+
+   if ( negative && ( i >= 0 ) )
+   {
+      buffer[i--] = '-';
+      negative = false;
+   }
+
+   if ( ( number != 0 ) || ( digits <= decimals ) || negative )
+   {
+      // Doesn't fit
+      memset ( buffer, '*', width );
+      return;
+   }
+   while ( i >= 0 )
+   {
+      buffer[i--] = ' ';
+   }
+}
+
+//
+// update
+void LCDScreen::update ( uint8_t id, const char *buffer )
+{
+   t_lcdField field;
+   char      *cache;
+   uint8_t    start;
+   uint8_t    end;
+   uint16_t   maxGap = _lcd.maxBridgeGap ( );
+
+   cache = &_cache[readField ( id, field )];
+
+   for ( uint8_t i = 0; i < field.width; )
+   {
+      if ( cache[i] == buffer[i] )
+      {
+         i++;
+         continue;
+      }
+
+      // Run of changes, including the gaps of unchanged characters that are
+      // cheaper to rewrite than addressing the next change.
+      start = i;
+      end   = i;
+      for ( uint16_t gap = 0; ( i < field.width ) && ( gap <= maxGap ); i++ )
+      {
+         if ( cache[i] != buffer[i] )
+         {
+            end = i;
+            gap = 0;
+         }
+         else
+         {
+            gap++;
+         }
+      }
+      i = end + 1;
+      memcpy ( &cache[start], &buffer[start], end - start + 1 );
+      _lcd.setCursor ( field.col + start, field.row );
+      _lcd.write ( (const uint8_t *)&buffer[start], end - start + 1 );
+   }
+}
@@ -0,0 +1,204 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LCDScreen.h
+// This file implements retained mode screens: static labels and live fields
+// described by a template stored in flash.
+//
+// @brief
+// A screen template lists the static labels of a screen and the fields
+// where values are shown (position, width and format). Entering a screen
+// clears the LCD and draws the labels once, from then on setField formats a
+// new value and only writes the characters of the field that have changed.
+// Labels are never rewritten and unchanged digits are never sent.
+//
+// The templates are declared in flash (PROGMEM) and only a copy of the
+// field contents is kept in RAM (LCDSCR_CACHE_SIZE bytes).
+//
+//   const char tempLbl[] PROGMEM = "Temp:      C";
+//   const char humLbl[]  PROGMEM = "Hum:       %";
+//   const t_lcdLabel labels[] PROGMEM = { { 0, 0, tempLbl }, { 0, 1, humLbl } };
+//   const t_lcdField fields[] PROGMEM = { { 6, 0, 5, LCDSCR_FIXED(1) },
+//                                         { 6, 1, 3, LCDSCR_DEC } };
+//   const t_lcdScreen mainScreen PROGMEM = { labels, 2, fields, 2 };
+//
+//   screen.enter ( &mainScreen );
+//   screen.setField ( 0, 215 );      // " 21.5"
+//   screen.setField ( 1, 48 );       // " 48"
+//
+// The LCD can still be used directly, i.e. for a status line outside
+// the fields, use redraw if the fields or labels get overwritten.
+//
+// ---------------------------------------------------------------------------
+#ifndef LCDScreen_h
+#define LCDScreen_h
+
+#include <inttypes.h>
+
+#include "LCD.h"
+
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+
+/*!
+ @defined
+ @abstract   RAM reserved to hold the contents of the fields of a screen.
+ @discussion The sum of the widths of all the fields of a screen can't
+ exceed this size.
+ */
+#ifndef LCDSCR_CACHE_SIZE
+#define LCDSCR_CACHE_SIZE    40
+#endif
+
+/*!
+ @defined
+ @abstract   Maximum width of a field.
+ */
+#define LCDSCR_MAX_WIDTH     20
+
+/*!
+ @defined
+ @abstract   Field formats.
+ @discussion LCDSCR_DEC: signed decimal, right aligned.
+ LCDSCR_HEX: hexadecimal, right aligned.
+ LCDSCR_FIXED(d): signed decimal with d decimals (value 215 with
+ LCDSCR_FIXED(1) is shown as 21.5), right aligned.
+ LCDSCR_TEXT: string, left aligned.
+ Values that don't fit in the field are shown as '*'.
+ */
+#define LCDSCR_DEC           0x00
+#define LCDSCR_HEX           0x10
+#define LCDSCR_TEXT          0x20
+#define LCDSCR_FIXED(d)      ( 0x30 | ( (d) & 0x0F ) )
+
+/*!
+ @typedef
+ @abstract   Static label of a screen.
+ @discussion text is a string stored in flash.
+ */
+typedef struct
+{
+   uint8_t     col;
+   uint8_t     row;
+   const char *text;
+} t_lcdLabel;
+
+/*!
+ @typedef
+ @abstract   Live field of a screen.
+ */
+typedef struct
+{
+   uint8_t col;
+   uint8_t row;
+   uint8_t width;
+   uint8_t format;
+} t_lcdField;
+
+/*!
+ @typedef
+ @abstract   Screen template.
+ @discussion The screen, its labels and fields are stored in flash. Fields
+ are identified by their index in the fields table.
+ */
+typedef struct
+{
+   const t_lcdLabel *labels;
+   uint8_t           numLabels;
+   const t_lcdField *fields;
+   uint8_t           numFields;
+} t_lcdScreen;
+
+class LCDScreen
+{
+public:
+   /*!
+    @method
+    @abstract   Class constructor.
+    @discussion Initializes class variables, no screen is entered.
+
+    @param      lcd[in] LCD where the screens are shown, it has to be
+    initialised by the application.
+    */
+   LCDScreen ( LCD &lcd );
+
+   /*!
+    @function
+    @abstract   Enters a screen.
+    @discussion Clears the LCD and draws the labels of the screen, all the
+    fields are left blank.
+
+    @param      screen[in] screen template stored in flash.
+    @result     1 if the screen has been entered, 0 if its fields don't fit in
+    LCDSCR_CACHE_SIZE.
+    */
+   int enter ( const t_lcdScreen *screen );
+
+   /*!
+    @function
+    @abstract   Redraws the current screen.
+    @discussion Draws again the labels and the current contents of the fields,
+    i.e. after having used the LCD directly.
+    */
+   void redraw ( void );
+
+   /*!
+    @function
+    @abstract   Updates a numeric field.
+    @discussion Formats the value as defined by the field format and only
+    writes to the LCD the characters that have changed. Any integer or
+    floating point value converts to long, except a literal 0 which is also
+    a null string: write 0L.
+
+    @param      id[in] field index in the screen fields table.
+    @param      value[in] value to show.
+    */
+   void setField ( uint8_t id, long value );
+
+   /*!
+    @function
+    @abstract   Updates a text field.
+    @discussion The text is left aligned and truncated to the width of the
+    field, only the characters that have changed are written to the LCD.
+
+    @param      id[in] field index in the screen fields table.
+    @param      text[in] string to show.
+    */
+   void setField ( uint8_t id, const char *text );
+
+private:
+   /*!
+    @function
+    @abstract   Reads a field definition from flash.
+    @result     offset of the field in the cache.
+    */
+   uint16_t readField ( uint8_t id, t_lcdField &field );
+
+   /*!
+    @function
+    @abstract   Formats a number into a buffer of a given width.
+    */
+   void format ( char *buffer, uint8_t width, uint8_t fmt, long value );
+
+   /*!
+    @function
+    @abstract   Writes the characters of a field that have changed.
+    @discussion Compares the new contents against the cache and writes the
+    runs of changed characters.
+    */
+   void update ( uint8_t id, const char *buffer );
+
+   LCD               &_lcd;                       // Target LCD
+   const t_lcdScreen *_screen;                    // Current screen (flash)
+   char               _cache[LCDSCR_CACHE_SIZE];  // Contents of the fields
+};
+
+#endif
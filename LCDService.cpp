@@ -0,0 +1,276 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: Yes
+// Extendable: Yes
+//
+// @file LCDService.cpp
+// This file implements a display service that owns an LCD on a worker thread
+// and accepts display operations from any thread.
+//
+// @brief
+// Tokens are given in posting order and operations are applied in queue
+// order, so once the worker has flushed a frame every token up to the last
+// one taken for the frame is on the display. Tokens are compared modulo
+// 2^32 so that they can wrap around.
+//
+// ---------------------------------------------------------------------------
+#include "LCDService.h"
+
+#if ( defined ( __linux__ ) || defined ( ESP_PLATFORM ) ) && ( __cplusplus >= 201103L )
+
+#include <chrono>
+
+// CONSTRUCTORS
+// ---------------------------------------------------------------------------
+LCDService::LCDService ( LCD &lcd ) : _buffer ( lcd )
+{
+   _first     = 0;
+   _count     = 0;
+   _next      = 1;
+   _last      = 0;
+   _completed = 0;
+   _running   = false;
+   _frameTime = LCDSVC_FRAME_TIME;
+}
+
+LCDService::~LCDService ( void )
+{
+   end ( );
+}
+
+// PUBLIC METHODS
+// ---------------------------------------------------------------------------
+
+//
+// begin
+int LCDService::begin ( uint8_t cols, uint8_t rows, uint16_t frameTime )
+{
+   if ( _worker.joinable ( ) )
+   {
+      return ( 0 );
+   }
+
+   // The worker isn't running yet, the LCD can be initialised from here
+   _buffer.begin ( cols, rows );
+   _frameTime = frameTime;
+   _running   = true;
+   _worker    = std::thread ( &LCDService::run, this );
+   return ( 1 );
+}
+
+//
+// end
+void LCDService::end ( void )
+{
+   {
+      std::lock_guard<std::mutex> guard ( _lock );
+
+      _running = false;
+   }
+   _posted.notify_all ( );
+   _taken.notify_all ( );
+   if ( _worker.joinable ( ) )
+   {
+      _worker.join ( );
+   }
+}
+
+//
+// print
+uint32_t LCDService::print ( uint8_t col, uint8_t row, const char *text )
+{
+   t_lcdSvcOp op;
+   uint8_t    len;
+
+   for ( len = 0; ( len < LCDSVC_TEXT_SIZE ) && ( text[len] != '\0' ); len++ )
+   {
+      op.text[len] = text[len];
+   }
+   op.op  = LCDSVC_PRINT;
+   op.col = col;
+   op.row = row;
+   op.arg = len;
+   return ( post ( op ) );
+}
+
+//
+// clear
+uint32_t LCDService::clear ( void )
+{
+   t_lcdSvcOp op;
+
+   op.op  = LCDSVC_CLEAR;
+   op.col = 0;
+   op.row = 0;
+   op.arg = 0;
+   return ( post ( op ) );
+}
+
+//
+// setBacklight
+uint32_t LCDService::setBacklight ( uint8_t value )
+{
+   t_lcdSvcOp op;
+
+   op.op  = LCDSVC_BACKLIGHT;
+   op.col = 0;
+   op.row = 0;
+   op.arg = value;
+   return ( post ( op ) );
+}
+
+//
+// post
+uint32_t LCDService::post ( const t_lcdSvcOp &op, bool block )
+{
+   std::unique_lock<std::mutex> guard ( _lock );
+   uint32_t token;
+
+   while ( _running && ( _count == LCDSVC_QUEUE_SIZE ) )
+   {
+      if ( !block )
+      {
+         return ( 0 );
+      }
+      _taken.wait ( guard );
+   }
+   if ( !_running )
+   {
+      return ( 0 );
+   }
+
+   _ops[( _first + _count ) % LCDSVC_QUEUE_SIZE] = op;
+   _count++;
+   token = _next++;
+   if ( _next == 0 )
+   {
+      _next = 1;                    // 0 is never a valid token
+   }
+   _last = token;
+   _posted.notify_one ( );
+   return ( token );
+}
+
+//
+// done
+bool LCDService::done ( uint32_t token )
+{
+   std::lock_guard<std::mutex> guard ( _lock );
+
+   return ( (int32_t)( token - _completed ) <= 0 );
+}
+
+//
+// wait
+void LCDService::wait ( uint32_t token )
+{
+   std::unique_lock<std::mutex> guard ( _lock );
+
+   while ( (int32_t)( token - _completed ) > 0 )
+   {
+      _flushed.wait ( guard );
+   }
+}
+
+// PRIVATE METHODS
+// ---------------------------------------------------------------------------
+
+//
+// run
+void LCDService::run ( void )
+{
+   std::unique_lock<std::mutex> guard ( _lock );
+   std::chrono::steady_clock::time_point lastFlush = std::chrono::steady_clock::now ( );
+   std::chrono::steady_clock::time_point frame;
+   t_lcdSvcOp ops[LCDSVC_QUEUE_SIZE];
+   uint8_t    count;
+   uint32_t   last = _completed;
+
+   for ( ;; )
+   {
+      while ( _running && ( _count == 0 ) )
+      {
+         _posted.wait ( guard );
+      }
+      if ( _count == 0 )
+      {
+         break;                     // stopped and nothing left to apply
+      }
+
+      // Operations posted until the frame is due are merged into it. After
+      // an idle period the frame is due straight away.
+      frame = lastFlush + std::chrono::milliseconds ( _frameTime );
+      do
+      {
+         count = take ( ops, last );
+         guard.unlock ( );          // posting never waits for the LCD
+         _taken.notify_all ( );
+         for ( uint8_t i = 0; i < count; i++ )
+         {
+            apply ( ops[i] );
+         }
+         guard.lock ( );
+
+         while ( _running && ( _count == 0 ) &&
+                 ( std::chrono::steady_clock::now ( ) < frame ) )
+         {
+            _posted.wait_until ( guard, frame );
+         }
+      } while ( ( _count != 0 ) && ( std::chrono::steady_clock::now ( ) < frame ) );
+
+      guard.unlock ( );
+      _buffer.flush ( );
+      lastFlush = std::chrono::steady_clock::now ( );
+      guard.lock ( );
+
+      _completed = last;
+      _flushed.notify_all ( );
+   }
+}
+
+//
+// take
+uint8_t LCDService::take ( t_lcdSvcOp *ops, uint32_t &last )
+{
+   uint8_t count;
+
+   for ( count = 0; count < _count; count++ )
+   {
+      ops[count] = _ops[( _first + count ) % LCDSVC_QUEUE_SIZE];
+   }
+   _first = ( _first + _count ) % LCDSVC_QUEUE_SIZE;
+   _count = 0;
+   last   = _last;
+   return ( count );
+}
+
+//
+// apply
+void LCDService::apply ( const t_lcdSvcOp &op )
+{
+   switch ( op.op )
+   {
+      case LCDSVC_PRINT:
+         _buffer.setCursor ( op.col, op.row );
+         _buffer.write ( (const uint8_t *)op.text, op.arg );
+         break;
+
+      case LCDSVC_CLEAR:
+         _buffer.clear ( );
+         break;
+
+      case LCDSVC_BACKLIGHT:
+         _buffer.setBacklight ( op.arg );
+         break;
+
+      default:
+         break;
+   }
+}
+
+#endif
@@ -0,0 +1,250 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: Yes
+// Extendable: Yes
+//
+// @file LCDService.h
+// This file implements a display service that owns an LCD on a worker thread
+// and accepts display operations from any thread.
+//
+// @brief
+// On multi-threaded targets (Linux boards, ESP32) several tasks may need to
+// write to the same LCD. Instead of every task holding a lock across the
+// slow transfers to the LCD, the service owns the LCD: tasks post operations
+// (print a text at a position, clear, backlight) to a bounded queue and a
+// worker thread applies them.
+//
+// The worker renders the operations into a LiquidCrystal_Buffer and flushes
+// it at most once per frame (frameTime milliseconds), so all the operations
+// posted during a frame, from any thread, are merged: a character written
+// several times is sent once and unchanged characters are not sent at all.
+//
+// Every operation posted returns a completion token, the caller can check
+// (done) or wait (wait) until the operation is on the display.
+//
+//   LiquidCrystal_I2C lcd(0x27, 2, 1, 0, 4, 5, 6, 7, 3, POSITIVE);
+//   LCDService        service(lcd);
+//
+//   service.begin ( 20, 4 );
+//   ...
+//   // any thread
+//   uint32_t token = service.print ( 0, 1, "Connected" );
+//   service.wait ( token );
+//
+// The LCD must not be used directly while the service is running.
+//
+// The service needs C++11 threads, it is only built on Linux and ESP-IDF
+// (ESP_PLATFORM) targets.
+//
+// ---------------------------------------------------------------------------
+#ifndef LCDService_h
+#define LCDService_h
+
+#if ( defined ( __linux__ ) || defined ( ESP_PLATFORM ) ) && ( __cplusplus >= 201103L )
+
+#include <inttypes.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "LCD.h"
+#include "LiquidCrystal_Buffer.h"
+
+/*!
+ @defined
+ @abstract   Number of operations the queue of the service holds.
+ @discussion Posting to a full queue blocks the caller until the worker
+ takes the queued operations.
+ */
+#ifndef LCDSVC_QUEUE_SIZE
+#define LCDSVC_QUEUE_SIZE    32
+#endif
+
+/*!
+ @defined
+ @abstract   Maximum length of the text of an operation.
+ */
+#define LCDSVC_TEXT_SIZE     20
+
+/*!
+ @defined
+ @abstract   Default frame time in milliseconds.
+ */
+#define LCDSVC_FRAME_TIME    20
+
+/*!
+ @defined
+ @abstract   Display operations.
+ @discussion LCDSVC_PRINT: print a text at a position.
+ LCDSVC_CLEAR: clear the display.
+ LCDSVC_BACKLIGHT: set the backlight.
+ */
+#define LCDSVC_PRINT         0
+#define LCDSVC_CLEAR         1
+#define LCDSVC_BACKLIGHT     2
+
+/*!
+ @typedef
+ @abstract   Display operation.
+ @discussion arg is the length of the text or the backlight value depending
+ on the operation.
+ */
+typedef struct
+{
+   uint8_t op;
+   uint8_t col;
+   uint8_t row;
+   uint8_t arg;
+   char    text[LCDSVC_TEXT_SIZE];
+} t_lcdSvcOp;
+
+class LCDService
+{
+public:
+   /*!
+    @method
+    @abstract   Class constructor.
+    @discussion Initializes class variables, the worker is not started.
+
+    @param      lcd[in] LCD owned by the service.
+    */
+   LCDService ( LCD &lcd );
+
+   /*!
+    @method
+    @abstract   Class destructor.
+    @discussion Stops the worker.
+    */
+   ~LCDService ( void );
+
+   /*!
+    @function
+    @abstract   Starts the service.
+    @discussion Initialises the LCD to a given size (cols, rows) from the
+    calling thread, and then starts the worker.
+
+    @param      cols[in] the number of columns that the display has
+    @param      rows[in] the number of rows that the display has
+    @param      frameTime[in] minimum time between updates of the display
+    in milliseconds.
+    @result     1 if the service has been started, 0 if already running.
+    */
+   int begin ( uint8_t cols, uint8_t rows, uint16_t frameTime = LCDSVC_FRAME_TIME );
+
+   /*!
+    @function
+    @abstract   Stops the service.
+    @discussion The operations already posted are applied to the display
+    before the worker stops.
+    */
+   void end ( void );
+
+   /*!
+    @function
+    @abstract   Prints a text at a position.
+    @discussion The text is copied, up to LCDSVC_TEXT_SIZE characters.
+
+    @param      col[in] LCD column.
+    @param      row[in] LCD row.
+    @param      text[in] text to print.
+    @result     completion token, 0 if the service is not running.
+    */
+   uint32_t print ( uint8_t col, uint8_t row, const char *text );
+
+   /*!
+    @function
+    @abstract   Clears the display.
+    @result     completion token, 0 if the service is not running.
+    */
+   uint32_t clear ( void );
+
+   /*!
+    @function
+    @abstract   Sets the backlight.
+
+    @param      value[in] backlight value (LCD::setBacklight).
+    @result     completion token, 0 if the service is not running.
+    */
+   uint32_t setBacklight ( uint8_t value );
+
+   /*!
+    @function
+    @abstract   Posts an operation.
+    @discussion Operations posted by a thread are applied in order. If the
+    queue is full the caller is blocked until there is room, unless block is
+    false.
+
+    @param      op[in] operation to post.
+    @param      block[in] wait for room if the queue is full.
+    @result     completion token, 0 if the service is not running or the
+    queue is full and block is false.
+    */
+   uint32_t post ( const t_lcdSvcOp &op, bool block = true );
+
+   /*!
+    @function
+    @abstract   Checks if an operation is on the display.
+
+    @param      token[in] completion token of the operation.
+    @result     true once the operation has been sent to the LCD.
+    */
+   bool done ( uint32_t token );
+
+   /*!
+    @function
+    @abstract   Waits until an operation is on the display.
+
+    @param      token[in] completion token of the operation.
+    */
+   void wait ( uint32_t token );
+
+private:
+   /*!
+    @function
+    @abstract   Worker thread.
+    @discussion Takes the queued operations and renders them into the
+    buffer until the frame is due, and then flushes it.
+    */
+   void run ( void );
+
+   /*!
+    @function
+    @abstract   Takes all the queued operations.
+    @discussion To be called holding the lock.
+
+    @param      ops[out] operations taken, in posting order.
+    @param      last[out] token of the last operation taken.
+    @result     number of operations taken.
+    */
+   uint8_t take ( t_lcdSvcOp *ops, uint32_t &last );
+
+   /*!
+    @function
+    @abstract   Renders an operation into the buffer.
+    */
+   void apply ( const t_lcdSvcOp &op );
+
+   LiquidCrystal_Buffer    _buffer;                   // Frame being built
+   std::thread             _worker;                   // Owner of the LCD
+   std::mutex              _lock;                     // Guards the members below
+   std::condition_variable _posted;                   // Queue not empty or stop
+   std::condition_variable _taken;                    // Queue not full
+   std::condition_variable _flushed;                  // Frame on the display
+   t_lcdSvcOp              _ops[LCDSVC_QUEUE_SIZE];   // Queued operations
+   uint8_t                 _first;                    // Oldest queued
+   uint8_t                 _count;                    // Operations queued
+   uint32_t                _next;                     // Next token to give
+   uint32_t                _last;                     // Last token given
+   uint32_t                _completed;                // Last token displayed
+   bool                    _running;                  // Worker running
+   uint16_t                _frameTime;                // ms between frames
+};
+
+#endif
+
+#endif
@@ -0,0 +1,368 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LCDSimulator.cpp
+// This file implements an LCD driver for a model of the HD44780 controller
+// held in memory.
+//
+// @brief
+// The address counter follows the HD44780 datasheet: in 2 line mode the end
+// of a line (0x27, 0x67) continues at the start of the other one, in 1 line
+// mode the 80 characters are a single line. The display shift moves the
+// window shown over each line.
+//
+// ---------------------------------------------------------------------------
+#include <string.h>
+#include <inttypes.h>
+
+#if (ARDUINO <  100)
+#include <WProgram.h>
+#else
+#include <Arduino.h>
+#endif
+
+#include "LCDSimulator.h"
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+
+// DDRAM contents after a clear
+#define BLANK         ' '
+
+// CONSTRUCTORS
+// ---------------------------------------------------------------------------
+LCDSimulator::LCDSimulator ( uint16_t sendTime )
+{
+   _sendTime  = sendTime;
+   _backlight = 0;
+   reset ( );
+   resetCounters ( );
+}
+
+// PUBLIC METHODS
+// ---------------------------------------------------------------------------
+
+//
+// begin
+void LCDSimulator::begin ( uint8_t cols, uint8_t lines, uint8_t dotsize )
+{
+   reset ( );
+   _displayfunction = LCD_4BITMODE | LCD_1LINE | LCD_5x8DOTS;
+   LCD::begin ( cols, lines, dotsize );
+}
+
+//
+// send
+void LCDSimulator::send ( uint8_t value, uint8_t mode )
+{
+   _sends++;
+   _busTime += _sendTime;
+
+   // Initialisation nibbles, the interface is always in 4 bit mode here
+   if ( mode == FOUR_BITS )
+   {
+      return;
+   }
+
+   if ( mode == DATA )
+   {
+      if ( _cgMode )
+      {
+         _cgram[_ac & ( LCDSIM_CGRAM_SIZE - 1 )] = value;
+         step ( _entry & LCD_ENTRYLEFT );
+         return;
+      }
+      _ddram[index ( _ac )] = value;
+      step ( _entry & LCD_ENTRYLEFT );
+      if ( _entry & LCD_ENTRYSHIFTINCREMENT )
+      {
+         // The display follows the cursor
+         shiftDisplay ( _entry & LCD_ENTRYLEFT );
+      }
+      return;
+   }
+
+   // Commands, from the highest bit set down
+   if ( value & LCD_SETDDRAMADDR )
+   {
+      _ac     = value & 0x7F;
+      _cgMode = false;
+   }
+   else if ( value & LCD_SETCGRAMADDR )
+   {
+      _ac     = value & 0x3F;
+      _cgMode = true;
+   }
+   else if ( value & LCD_FUNCTIONSET )
+   {
+      _twoLines = ( value & LCD_2LINE ) != 0;
+   }
+   else if ( value & LCD_CURSORSHIFT )
+   {
+      if ( value & LCD_DISPLAYMOVE )
+      {
+         shiftDisplay ( !( value & LCD_MOVERIGHT ) );
+      }
+      else
+      {
+         step ( value & LCD_MOVERIGHT );
+      }
+   }
+   else if ( value & LCD_DISPLAYCONTROL )
+   {
+      _control = value & ( LCD_DISPLAYON | LCD_CURSORON | LCD_BLINKON );
+   }
+   else if ( value & LCD_ENTRYMODESET )
+   {
+      _entry = value & ( LCD_ENTRYLEFT | LCD_ENTRYSHIFTINCREMENT );
+   }
+   else if ( value & LCD_RETURNHOME )
+   {
+      _ac     = 0;
+      _cgMode = false;
+      _shift  = 0;
+   }
+   else if ( value & LCD_CLEARDISPLAY )
+   {
+      memset ( _ddram, BLANK, sizeof ( _ddram ) );
+      _ac     = 0;
+      _cgMode = false;
+      _shift  = 0;
+      _entry |= LCD_ENTRYLEFT;
+   }
+}
+
+//
+// dataCost
+uint16_t LCDSimulator::dataCost ( void )
+{
+   return ( _sendTime );
+}
+
+//
+// commandCost
+uint16_t LCDSimulator::commandCost ( void )
+{
+   return ( _sendTime );
+}
+
+//
+// maxSendTime
+uint16_t LCDSimulator::maxSendTime ( void )
+{
+   return ( _sendTime );
+}
+
+//
+// setBacklight
+void LCDSimulator::setBacklight ( uint8_t value )
+{
+   _backlight = value;
+}
+
+//
+// charAt
+uint8_t LCDSimulator::charAt ( uint8_t col, uint8_t row )
+{
+   uint8_t addr = address ( col, row );
+
+   if ( _twoLines )
+   {
+      addr = ( addr & 0x40 ) | ( ( ( addr & 0x3F ) + _shift ) % LCDSIM_LINE_SIZE );
+   }
+   else
+   {
+      addr = ( addr + _shift ) % LCDSIM_DDRAM_SIZE;
+   }
+   return ( _ddram[index ( addr )] );
+}
+
+//
+// ddram
+const uint8_t *LCDSimulator::ddram ( void )
+{
+   return ( _ddram );
+}
+
+//
+// cgram
+const uint8_t *LCDSimulator::cgram ( void )
+{
+   return ( _cgram );
+}
+
+//
+// control
+uint8_t LCDSimulator::control ( void )
+{
+   return ( _control );
+}
+
+//
+// shift
+uint8_t LCDSimulator::shift ( void )
+{
+   return ( _shift );
+}
+
+//
+// addressCounter
+uint8_t LCDSimulator::addressCounter ( void )
+{
+   return ( _ac );
+}
+
+//
+// viewAddress
+uint8_t LCDSimulator::viewAddress ( void )
+{
+   if ( _twoLines )
+   {
+      return ( ( _ac & 0x40 ) |
+               ( ( ( _ac & 0x3F ) + LCDSIM_LINE_SIZE - _shift ) % LCDSIM_LINE_SIZE ) );
+   }
+   return ( ( _ac + LCDSIM_DDRAM_SIZE - _shift ) % LCDSIM_DDRAM_SIZE );
+}
+
+//
+// backlightValue
+uint8_t LCDSimulator::backlightValue ( void )
+{
+   return ( _backlight );
+}
+
+//
+// sends
+unsigned long LCDSimulator::sends ( void )
+{
+   return ( _sends );
+}
+
+//
+// busTime
+unsigned long LCDSimulator::busTime ( void )
+{
+   return ( _busTime );
+}
+
+//
+// resetCounters
+void LCDSimulator::resetCounters ( void )
+{
+   _sends   = 0;
+   _busTime = 0;
+}
+
+//
+// dump
+void LCDSimulator::dump ( Print &out )
+{
+   for ( uint8_t row = 0; row < _numlines; row++ )
+   {
+      out.write ( '|' );
+      for ( uint8_t col = 0; col < _cols; col++ )
+      {
+         out.write ( charAt ( col, row ) );
+      }
+      out.write ( '|' );
+      out.println ( );
+   }
+}
+
+// PROTECTED METHODS
+// ---------------------------------------------------------------------------
+
+//
+// waitExec
+void LCDSimulator::waitExec ( uint16_t uSec )
+{
+   _busTime += uSec;
+}
+
+// PRIVATE METHODS
+// ---------------------------------------------------------------------------
+
+//
+// reset
+void LCDSimulator::reset ( void )
+{
+   memset ( _ddram, BLANK, sizeof ( _ddram ) );
+   memset ( _cgram, 0, sizeof ( _cgram ) );
+   _ac       = 0;
+   _cgMode   = false;
+   _twoLines = false;
+   _entry    = LCD_ENTRYLEFT;
+   _control  = LCD_DISPLAYOFF;
+   _shift    = 0;
+}
+
+//
+// shiftDisplay
+void LCDSimulator::shiftDisplay ( bool left )
+{
+   uint8_t span = _twoLines ? LCDSIM_LINE_SIZE : LCDSIM_DDRAM_SIZE;
+
+   _shift = left ? _shift + 1 : _shift + span - 1;
+   _shift %= span;
+}
+
+//
+// step
+void LCDSimulator::step ( bool increment )
+{
+   uint8_t line;
+   uint8_t col;
+
+   if ( _cgMode )
+   {
+      _ac = ( increment ? _ac + 1 : _ac - 1 ) & ( LCDSIM_CGRAM_SIZE - 1 );
+   }
+   else if ( _twoLines )
+   {
+      line = _ac & 0x40;
+      col  = _ac & 0x3F;
+      if ( increment )
+      {
+         col++;
+         if ( col >= LCDSIM_LINE_SIZE )
+         {
+            col   = 0;
+            line ^= 0x40;
+         }
+      }
+      else
+      {
+         if ( col == 0 )
+         {
+            col   = LCDSIM_LINE_SIZE;
+            line ^= 0x40;
+         }
+         col--;
+      }
+      _ac = line | col;
+   }
+   else
+   {
+      _ac = increment ? _ac + 1 : _ac + LCDSIM_DDRAM_SIZE - 1;
+      _ac %= LCDSIM_DDRAM_SIZE;
+   }
+}
+
+//
+// index
+uint8_t LCDSimulator::index ( uint8_t address )
+{
+   if ( _twoLines )
+   {
+      return ( ( ( address & 0x40 ) ? LCDSIM_LINE_SIZE : 0 ) +
+               ( address & 0x3F ) % LCDSIM_LINE_SIZE );
+   }
+   return ( address % LCDSIM_DDRAM_SIZE );
+}
@@ -0,0 +1,246 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LCDSimulator.h
+// This file implements an LCD driver for a model of the HD44780 controller
+// held in memory.
+//
+// @brief
+// The simulator executes the commands and characters sent to it the way
+// an HD44780 does: display data RAM (DDRAM) and character generator RAM
+// (CGRAM) contents, address counter, entry mode, display control and
+// display shift. Instead of waiting, it adds up the time the LCD would be
+// busy, so the bus time taken by a sequence of operations can be measured
+// without hardware, on the board or on a host.
+//
+//   LCDSimulator lcd;
+//
+//   lcd.begin ( 20, 4 );
+//   lcd.resetCounters ( );
+//   lcd.print ( "Hello" );
+//   // lcd.sends() == 5, lcd.busTime() == 5 * LCD_EXEC_TIME
+//
+// It is the reference for checking that an optimised path (buffers,
+// skipped commands, ...) leaves the LCD as plain writes do, @see
+// LCDEquivalence.
+//
+// ---------------------------------------------------------------------------
+#ifndef LCDSimulator_h
+#define LCDSimulator_h
+
+#include <inttypes.h>
+#include <Print.h>
+
+#include "LCD.h"
+
+/*!
+ @defined
+ @abstract   Size of the LCD display data RAM and of a line in 2 line mode.
+ */
+#define LCDSIM_DDRAM_SIZE       80
+#define LCDSIM_LINE_SIZE        40
+
+/*!
+ @defined
+ @abstract   Size of the LCD character generator RAM.
+ */
+#define LCDSIM_CGRAM_SIZE       64
+
+class LCDSimulator : public LCD
+{
+public:
+   /*!
+    @method
+    @abstract   Class constructor.
+
+    @param      sendTime[in] time a character or command keeps the bus and
+    the LCD busy (us).
+    */
+   LCDSimulator ( uint16_t sendTime = LCD_EXEC_TIME );
+
+   /*!
+    @function
+    @abstract   LCD initialization.
+    @discussion Powers up the model, as an HD44780 after its internal reset
+    with a blank DDRAM and a zeroed CGRAM, and initialises it to a given
+    size (col, row).
+
+    @param      cols[in] the number of columns that the display has
+    @param      rows[in] the number of rows that the display has
+    @param      charsize[in] character size, default==LCD_5x8DOTS
+    */
+   virtual void begin ( uint8_t cols, uint8_t rows, uint8_t charsize = LCD_5x8DOTS );
+
+   /*!
+    @function
+    @abstract   Executes a command or character.
+
+    Users should never call this method.
+
+    @param      value[in] Value to send to the LCD.
+    @param      mode[in] DATA - write to the LCD CGRAM, COMMAND - write a
+    command to the LCD.
+    */
+   virtual void send ( uint8_t value, uint8_t mode );
+
+   /*!
+    @function
+    @abstract   Time a character takes. @see LCD::dataCost
+    */
+   virtual uint16_t dataCost ( void );
+
+   /*!
+    @function
+    @abstract   Time a command takes. @see LCD::commandCost
+    */
+   virtual uint16_t commandCost ( void );
+
+   /*!
+    @function
+    @abstract   Worst case time of a send, the send time given to the
+    constructor. @see LCD::maxSendTime
+    */
+   virtual uint16_t maxSendTime ( void );
+
+   /*!
+    @function
+    @abstract   Switch-on/off the LCD backlight.
+    */
+   void setBacklight ( uint8_t value );
+
+   /*!
+    @function
+    @abstract   Character shown at a position of the display.
+    @discussion Takes the display shift into account.
+    */
+   uint8_t charAt ( uint8_t col, uint8_t row );
+
+   /*!
+    @function
+    @abstract   Contents of the DDRAM, LCDSIM_DDRAM_SIZE bytes: the 2 lines
+    one after the other in 2 line mode.
+    */
+   const uint8_t *ddram ( void );
+
+   /*!
+    @function
+    @abstract   Contents of the CGRAM, LCDSIM_CGRAM_SIZE bytes.
+    */
+   const uint8_t *cgram ( void );
+
+   /*!
+    @function
+    @abstract   Display control flags (LCD_DISPLAYON, LCD_CURSORON,
+    LCD_BLINKON) of the last display control command.
+    */
+   uint8_t control ( void );
+
+   /*!
+    @function
+    @abstract   Display shift, in positions to the left (0 to 39, 0 to 79
+    in 1 line mode).
+    */
+   uint8_t shift ( void );
+
+   /*!
+    @function
+    @abstract   Address counter, the DDRAM address of the cursor.
+    */
+   uint8_t addressCounter ( void );
+
+   /*!
+    @function
+    @abstract   Address of the cursor on the display.
+    @discussion The address counter with the display shift taken out, the
+    same for a cursor shown at the same position of the display whatever
+    the shift.
+    */
+   uint8_t viewAddress ( void );
+
+   /*!
+    @function
+    @abstract   Backlight value.
+    */
+   uint8_t backlightValue ( void );
+
+   /*!
+    @function
+    @abstract   Number of characters and commands sent.
+    */
+   unsigned long sends ( void );
+
+   /*!
+    @function
+    @abstract   Time the bus and the LCD have been busy (us).
+    @discussion Each character or command sent plus the execution time
+    waited for (clear, home, CGRAM writes).
+    */
+   unsigned long busTime ( void );
+
+   /*!
+    @function
+    @abstract   Resets the send and time counters.
+    */
+   void resetCounters ( void );
+
+   /*!
+    @function
+    @abstract   Prints the display contents as the LCD shows it.
+    */
+   void dump ( Print &out );
+
+protected:
+   /*!
+    @function
+    @abstract   Waits for the LCD to execute a command.
+    @discussion Adds the time to the bus time instead of waiting.
+    */
+   virtual void waitExec ( uint16_t uSec );
+
+private:
+   /*!
+    @function
+    @abstract   Internal reset of the HD44780 at power up.
+    */
+   void reset ( void );
+
+   /*!
+    @function
+    @abstract   Shifts the display one position.
+    */
+   void shiftDisplay ( bool left );
+
+   /*!
+    @function
+    @abstract   Moves the address counter one position.
+    */
+   void step ( bool increment );
+
+   /*!
+    @function
+    @abstract   Converts the address counter into a DDRAM index.
+    */
+   uint8_t index ( uint8_t address );
+
+   uint16_t      _sendTime;                     // Time of a send (us)
+   uint8_t       _ddram[LCDSIM_DDRAM_SIZE];     // Display data RAM
+   uint8_t       _cgram[LCDSIM_CGRAM_SIZE];     // Character generator RAM
+   uint8_t       _ac;                           // Address counter
+   bool          _cgMode;                       // Address counter in the CGRAM
+   bool          _twoLines;                     // 2 line mode set
+   uint8_t       _entry;                        // Entry mode flags
+   uint8_t       _control;                      // Display control flags
+   uint8_t       _shift;                        // Display shift to the left
+   uint8_t       _backlight;                    // Backlight value
+   unsigned long _sends;                        // Characters and commands
+   unsigned long _busTime;                      // Busy time (us)
+};
+
+#endif
@@ -0,0 +1,214 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LCDViewport.cpp
+// This file implements a window of an LCDCanvas shown on an LCD.
+//
+// @brief
+// Rows are compared one at a time. The LCD cursor moves along a row as it
+// is written, so a run following the previous one on the same row doesn't
+// need addressing; across rows it is always addressed as rows are not
+// consecutive in the DDRAM.
+//
+// ---------------------------------------------------------------------------
+#include <string.h>
+#include <inttypes.h>
+
+#if (ARDUINO <  100)
+#include <WProgram.h>
+#else
+#include <Arduino.h>
+#endif
+
+#include "LCDViewport.h"
+#include "LCDDiff.h"
+
+// CONSTRUCTORS
+// ---------------------------------------------------------------------------
+LCDViewport::LCDViewport ( LCDCanvas &canvas, LCD &lcd ) :
+   _canvas ( canvas ), _lcd ( lcd )
+{
+   _cols  = 0;
+   _rows  = 0;
+   _col   = 0;
+   _row   = 0;
+   _valid = false;
+}
+
+// PUBLIC METHODS
+// ---------------------------------------------------------------------------
+
+//
+// begin
+int LCDViewport::begin ( uint8_t cols, uint8_t rows )
+{
+   if ( ( ( uint16_t )cols * rows > LCDVP_MAX_CELLS ) ||
+        ( cols > LCDVP_MAX_COLS ) )
+   {
+      return ( 0 );
+   }
+   _cols = cols;
+   _rows = rows;
+   _col  = 0;
+   _row  = 0;
+
+   // The LCD is left blank
+   _lcd.begin ( cols, rows );
+   memset ( _shown, ' ', sizeof ( _shown ) );
+   _valid = true;
+   return ( 1 );
+}
+
+//
+// moveTo
+void LCDViewport::moveTo ( int16_t col, int16_t row )
+{
+   int16_t maxCol = ( int16_t )_canvas.cols ( ) - _cols;
+   int16_t maxRow = ( int16_t )_canvas.rows ( ) - _rows;
+
+   if ( col > maxCol )
+   {
+      col = maxCol;
+   }
+   if ( row > maxRow )
+   {
+      row = maxRow;
+   }
+   if ( col < 0 )
+   {
+      col = 0;
+   }
+   if ( row < 0 )
+   {
+      row = 0;
+   }
+   _col = col;
+   _row = row;
+}
+
+//
+// scroll
+void LCDViewport::scroll ( int16_t cols, int16_t rows )
+{
+   moveTo ( ( int16_t )_col + cols, ( int16_t )_row + rows );
+}
+
+//
+// col
+uint8_t LCDViewport::col ( void )
+{
+   return ( _col );
+}
+
+//
+// row
+uint8_t LCDViewport::row ( void )
+{
+   return ( _row );
+}
+
+//
+// update
+void LCDViewport::update ( void )
+{
+   uint8_t  run[LCDVP_MAX_COLS];
+   uint8_t *shown;
+   const uint8_t *line;               // canvas row, 0 if not all on the canvas
+   uint8_t  next;                     // LCD cursor column, on this row
+   uint8_t  length;
+   uint8_t  gap;
+   uint8_t  value;
+   uint16_t maxGap = _lcd.maxBridgeGap ( );
+
+   _lcd.beginBatch ( );             // the whole update in one transfer
+   for ( uint8_t row = 0; row < _rows; row++ )
+   {
+      shown = &_shown[row * _cols];
+      next  = _cols;                  // not known
+      line  = _canvas.line ( _row + row );
+      if ( ( line != 0 ) && ( _col + _cols <= _canvas.cols ( ) ) )
+      {
+         line += _col;
+      }
+      else
+      {
+         line = 0;
+      }
+
+      for ( uint8_t col = 0; col < _cols; )
+      {
+         // Skip the unchanged characters, a word at a time on the canvas
+         if ( _valid )
+         {
+            if ( line != 0 )
+            {
+               col += lcd_diffFirst ( &line[col], &shown[col], _cols - col );
+            }
+            else
+            {
+               while ( ( col < _cols ) && ( source ( col, row ) == shown[col] ) )
+               {
+                  col++;
+               }
+            }
+            if ( col == _cols )
+            {
+               break;
+            }
+         }
+
+         // A run of changes up to the last one, bridging short gaps
+         length = 0;
+         gap    = 0;
+         for ( uint8_t i = col; i < _cols; i++ )
+         {
+            value  = source ( i, row );
+            run[i - col] = value;
+            if ( !_valid || ( value != shown[i] ) )
+            {
+               length = i - col + 1;
+               gap    = 0;
+            }
+            else if ( ++gap > maxGap )
+            {
+               break;
+            }
+         }
+
+         if ( next != col )
+         {
+            _lcd.setCursor ( col, row );
+         }
+         _lcd.write ( run, length );
+         memcpy ( &shown[col], run, length );
+         col += length;
+         next = col;
+      }
+   }
+   _lcd.endBatch ( );
+   _valid = true;
+}
+
+//
+// invalidate
+void LCDViewport::invalidate ( void )
+{
+   _valid = false;
+}
+
+// PRIVATE METHODS
+// ---------------------------------------------------------------------------
+
+//
+// source
+uint8_t LCDViewport::source ( uint8_t col, uint8_t row )
+{
+   return ( _canvas.charAt ( _col + col, _row + row ) );
+}
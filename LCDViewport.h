@@ -0,0 +1,150 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LCDViewport.h
+// This file implements a window of an LCDCanvas shown on an LCD.
+//
+// @brief
+// The viewport shows the part of a canvas starting at a given column and
+// row on an LCD the size of the window (i.e. 16x2 or 20x4). It keeps a copy
+// of what the LCD shows: update compares the window with it and only sends
+// the characters that differ, whether the canvas has been written or the
+// window has been moved. Panning over a log or a table only sends the
+// characters that actually change on screen, not the whole window.
+//
+//   uint8_t     cells[64 * 16];
+//   LCDCanvas   canvas(cells, 64, 16);
+//   LCDViewport view(canvas, lcd);
+//
+//   view.begin ( 20, 4 );            // initialises the LCD
+//   canvas.print ( ... );
+//   view.scroll ( 0, 1 );            // one row down
+//   view.update ( );
+//
+// The LCD must be written only through the viewport, or invalidate has to
+// be called afterwards. Horizontal pans can also be sent as display shifts
+// by showing the viewport on a LiquidCrystal_Buffer.
+//
+// ---------------------------------------------------------------------------
+#ifndef LCDViewport_h
+#define LCDViewport_h
+
+#include <inttypes.h>
+
+#include "LCD.h"
+#include "LCDCanvas.h"
+
+/*!
+ @defined
+ @abstract   Largest window, in characters.
+ @discussion The copy of what the LCD shows takes this many bytes of RAM,
+ 80 covers all HD44780 displays.
+ */
+#ifndef LCDVP_MAX_CELLS
+#define LCDVP_MAX_CELLS        80
+#endif
+
+/*!
+ @defined
+ @abstract   Largest number of columns of the window.
+ */
+#ifndef LCDVP_MAX_COLS
+#define LCDVP_MAX_COLS         40
+#endif
+
+class LCDViewport
+{
+public:
+   /*!
+    @method
+    @abstract   Class constructor.
+
+    @param      canvas[in] canvas shown.
+    @param      lcd[in] LCD the window is shown on.
+    */
+   LCDViewport ( LCDCanvas &canvas, LCD &lcd );
+
+   /*!
+    @function
+    @abstract   Initialises the LCD to the size of the window.
+    @discussion The window is placed at the top left corner of the canvas,
+    nothing is sent until update.
+
+    @param      cols[in] columns of the LCD.
+    @param      rows[in] rows of the LCD.
+    @result     1 if initialised, 0 if the window is larger than
+    LCDVP_MAX_CELLS or LCDVP_MAX_COLS.
+    */
+   int begin ( uint8_t cols, uint8_t rows );
+
+   /*!
+    @function
+    @abstract   Moves the window.
+    @discussion The window is kept within the canvas.
+
+    @param      col[in] canvas column shown at the left of the LCD.
+    @param      row[in] canvas row shown at the top of the LCD.
+    */
+   void moveTo ( int16_t col, int16_t row );
+
+   /*!
+    @function
+    @abstract   Moves the window by a number of columns and rows.
+    @discussion Positive values move it right and down.
+    */
+   void scroll ( int16_t cols, int16_t rows );
+
+   /*!
+    @function
+    @abstract   Canvas column shown at the left of the LCD.
+    */
+   uint8_t col ( void );
+
+   /*!
+    @function
+    @abstract   Canvas row shown at the top of the LCD.
+    */
+   uint8_t row ( void );
+
+   /*!
+    @function
+    @abstract   Sends the characters of the window that differ from what the
+    LCD shows.
+    @discussion Runs of changes are sent as a single string, short gaps of
+    unchanged characters are rewritten when it is cheaper than addressing
+    the next change (see LCD::dataCost and LCD::commandCost).
+    */
+   void update ( void );
+
+   /*!
+    @function
+    @abstract   Forgets what the LCD shows, the next update rewrites the
+    whole window.
+    */
+   void invalidate ( void );
+
+private:
+   /*!
+    @function
+    @abstract   Character of the canvas shown at a position of the LCD.
+    */
+   uint8_t source ( uint8_t col, uint8_t row );
+
+   LCDCanvas &_canvas;                    // Canvas shown
+   LCD       &_lcd;                       // LCD showing the window
+   uint8_t    _cols;                      // Window columns
+   uint8_t    _rows;                      // Window rows
+   uint8_t    _col;                       // Window position on the canvas
+   uint8_t    _row;
+   bool       _valid;                     // _shown is what the LCD shows
+   uint8_t    _shown[LCDVP_MAX_CELLS];    // What the LCD shows
+};
+
+#endif
@@ -0,0 +1,44 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: Yes
+// Extendable: Yes
+//
+// @file LinuxIO.cpp
+// This file defines the system calls used by the Linux userspace drivers.
+//
+// @brief
+// ioctl is variadic, it can't be taken as a function pointer, hence the
+// wrappers.
+//
+// ---------------------------------------------------------------------------
+#include "LinuxIO.h"
+
+#if defined ( __linux__ )
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+
+static int sysOpen ( const char *path, int flags )
+{
+   return ( ::open ( path, flags ) );
+}
+
+static int sysClose ( int fd )
+{
+   return ( ::close ( fd ) );
+}
+
+static int sysIoctl ( int fd, unsigned long request, void *arg )
+{
+   return ( ::ioctl ( fd, request, arg ) );
+}
+
+const t_linuxIO linuxSystemIO = { sysOpen, sysClose, sysIoctl };
+
+#endif
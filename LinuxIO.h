@@ -0,0 +1,47 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: Yes
+// Extendable: Yes
+//
+// @file LinuxIO.h
+// This file defines the system calls used by the Linux userspace drivers.
+//
+// @brief
+// The Linux drivers (i2c-dev, ...) don't call open, close and ioctl
+// directly but through a table of functions given to their constructor.
+// linuxSystemIO is the table of the actual system calls, the default;
+// a different table can stand in for the device nodes, i.e. to check the
+// transfers of a driver on a machine without the hardware.
+//
+// ---------------------------------------------------------------------------
+#ifndef LinuxIO_h
+#define LinuxIO_h
+
+#if defined ( __linux__ )
+
+/*!
+ @typedef
+ @abstract   System calls used by the Linux drivers.
+ @discussion Same arguments and results as the system calls.
+ */
+typedef struct
+{
+   int (*open) ( const char *path, int flags );
+   int (*close) ( int fd );
+   int (*ioctl) ( int fd, unsigned long request, void *arg );
+} t_linuxIO;
+
+/*!
+ @var
+ @abstract   The actual system calls.
+ */
+extern const t_linuxIO linuxSystemIO;
+
+#endif
+
+#endif
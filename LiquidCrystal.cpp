@@ -36,6 +36,7 @@
 #include <Arduino.h>
 #endif
 #include "LiquidCrystal.h"
+#include "LCDBusTrace.h"
 
 // CONSTANT  definitions
 // ---------------------------------------------------------------------------
@@ -123,6 +124,7 @@ void LiquidCrystal::send(uint8_t value, uint8_t mode)
 {
    // Only interested in COMMAND or DATA
    digitalWrite( _rs_pin, ( mode == DATA ) );
+   LCD_TRACE_BUS( mode == DATA );
    
    // if there is a RW pin indicated, set it low to Write
    // ---------------------------------------------------
@@ -150,6 +152,13 @@ void LiquidCrystal::send(uint8_t value, uint8_t mode)
    waitUsec ( EXEC_TIME ); // wait for the command to execute by the LCD
 }
 
+//
+// maxSendTime
+uint16_t LiquidCrystal::maxSendTime ( void )
+{
+   return ( LC_MAX_SEND );
+}
+
 //
 // setBacklightPin
 void LiquidCrystal::setBacklightPin ( uint8_t pin, t_backlighPol pol )
@@ -293,6 +302,7 @@ void LiquidCrystal::writeNbits(uint8_t value, uint8_t numBits)
    {
       digitalWrite(_data_pins[i], (value >> i) & 0x01);
    }
+   LCD_TRACE_BUS(value);
    pulseEnable();
 }
 
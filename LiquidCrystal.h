@@ -41,6 +41,26 @@
  */
 #define EXEC_TIME 37
 
+/*!
+ @defined 
+ @abstract   Worst case time of a digitalWrite (us).
+ @discussion Upper estimate, about 4us on a 16MHz AVR.
+ */
+#define LC_PIN_TIME 5
+
+/*!
+ @defined 
+ @abstract   Worst case time of a send (us).
+ @discussion RS and RW, then the 4 data pins and the enable pulse of each
+ nibble (8 data pins and a single pulse in 8 bit mode) and, unless they are
+ skipped (FAST_MODE), the enable pulse and execution waits.
+ */
+#ifdef FAST_MODE
+#define LC_MAX_SEND ( 14 * LC_PIN_TIME )
+#else
+#define LC_MAX_SEND ( 14 * LC_PIN_TIME + 2 + EXEC_TIME )
+#endif
+
 class LiquidCrystal : public LCD
 {
 public:
@@ -97,6 +117,12 @@ public:
     the LCD.
     */
    virtual void send(uint8_t value, uint8_t mode);
+
+   /*!
+    @function
+    @abstract   Worst case time of a send. @see LCD::maxSendTime
+    */
+   virtual uint16_t maxSendTime ( void );
    
    /*!
     @function
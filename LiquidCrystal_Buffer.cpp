@@ -0,0 +1,729 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LiquidCrystal_Buffer.cpp
+// This file implements a buffered LCD that forwards its contents to one or
+// more physical LCDs.
+//
+// @brief
+// This class implements the LCD interface on top of an in memory copy of
+// the LCD display data RAM (DDRAM). Only the characters that change are sent
+// to each of the attached displays when flushing the buffer.
+//
+// ---------------------------------------------------------------------------
+#include <string.h>
+#include <inttypes.h>
+
+#if (ARDUINO <  100)
+#include <WProgram.h>
+#else
+#include <Arduino.h>
+#endif
+
+#include "LiquidCrystal_Buffer.h"
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+/*!
+ @defined
+ @abstract   Blank character, DDRAM contents after a clear.
+ */
+#define LCDBUF_BLANK            ' '
+
+/*!
+ @defined
+ @abstract   No address, forces addressing before writing.
+ */
+#define LCDBUF_NO_ADDR          0xFF
+
+// CONSTRUCTORS
+// ---------------------------------------------------------------------------
+LiquidCrystal_Buffer::LiquidCrystal_Buffer ( LCD &display )
+{
+   init ( );
+   addDisplay ( display );
+}
+
+LiquidCrystal_Buffer::LiquidCrystal_Buffer ( LCD &display1, LCD &display2 )
+{
+   init ( );
+   addDisplay ( display1 );
+   addDisplay ( display2 );
+}
+
+// PUBLIC METHODS
+// ---------------------------------------------------------------------------
+
+//
+// addDisplay
+int LiquidCrystal_Buffer::addDisplay ( LCD &display )
+{
+   if ( _numDisplays >= LCDBUF_MAX_DISPLAYS )
+   {
+      return ( 0 );
+   }
+   _display[_numDisplays] = &display;
+   invalidate ( _numDisplays );
+   _numDisplays++;
+   return ( 1 );
+}
+
+//
+// begin
+void LiquidCrystal_Buffer::begin(uint8_t cols, uint8_t lines, uint8_t dotsize)
+{
+   // The buffer doesn't drive any hardware, just initialise its state the
+   // same way LCD::begin leaves an LCD, and initialise the displays.
+   _cols     = cols;
+   _numlines = lines;
+   _displayfunction = LCD_4BITMODE | LCD_1LINE | LCD_5x8DOTS;
+   if ( lines > 1 )
+   {
+      _displayfunction |= LCD_2LINE;
+   }
+   _displaycontrol = LCD_DISPLAYON | LCD_CURSOROFF | LCD_BLINKOFF;
+   _displaymode    = LCD_ENTRYLEFT | LCD_ENTRYSHIFTDECREMENT;
+
+   memset ( _ddram, LCDBUF_BLANK, sizeof ( _ddram ) );
+   memset ( _dirty, 0, sizeof ( _dirty ) );
+   _pendingClear = false;
+   _cursorDirty = 0;
+   _reshift = 0;
+   _ac     = 0;
+   _shift  = 0;
+   _offset = 0;
+   _cgram  = false;
+   _pageMode = false;
+   _back   = 0;
+#if ( LCDBUF_MAX_SHIFT > 0 )
+   memset ( _prev, LCDBUF_BLANK, sizeof ( _prev ) );
+   _inSync = true;
+#endif
+
+   for ( uint8_t i = 0; i < _numDisplays; i++ )
+   {
+      _display[i]->begin ( cols, lines, dotsize );
+   }
+}
+
+//
+// flush
+void LiquidCrystal_Buffer::flush ( void )
+{
+#if ( LCDBUF_MAX_SHIFT > 0 )
+   applyClear ( );
+   if ( _inSync && !_pageMode )
+   {
+      detectShift ( );
+   }
+#endif
+   for ( uint8_t i = 0; i < _numDisplays; i++ )
+   {
+      flush ( i );
+   }
+#if ( LCDBUF_MAX_SHIFT > 0 )
+   // All the displays show the buffer
+   memcpy ( _prev, _ddram, sizeof ( _prev ) );
+   _inSync = true;
+#endif
+}
+
+//
+// flush
+void LiquidCrystal_Buffer::flush ( uint8_t display )
+{
+   // Every character and an address for each of them at most
+   flush ( display, 2 * LCDBUF_DDRAM_SIZE );
+}
+
+//
+// flush
+int LiquidCrystal_Buffer::flush ( uint8_t display, uint8_t budget )
+{
+   LCD     *lcd;
+   uint8_t *dirty;
+   uint8_t addr = LCDBUF_NO_ADDR;   // display address counter
+   uint8_t run;
+   uint8_t window;
+   uint16_t maxGap;
+
+   if ( display >= _numDisplays )
+   {
+      return ( 1 );
+   }
+   lcd   = _display[display];
+   dirty = _dirty[display];
+   lcd->beginBatch ( );             // the whole update in one transfer
+
+   applyClear ( );
+#if ( LCDBUF_MAX_SHIFT > 0 )
+   _inSync = false;
+#endif
+
+   // A display that has been reinitialised has to show the same window
+   if ( _reshift & ( 1 << display ) )
+   {
+      _reshift &= ~( 1 << display );
+      window = ( _offset + shiftPeriod ( ) - _shift ) % shiftPeriod ( );
+      if ( window != 0 )
+      {
+         lcd->home ( );
+         shiftDisplay ( lcd, window );
+      }
+   }
+
+   maxGap = lcd->maxBridgeGap ( );
+
+   // Walk the buffer in DDRAM order sending runs of changed characters,
+   // the display address counter moves along so consecutive runs don't need
+   // to be addressed.
+   for ( uint8_t i = 0; i < LCDBUF_DDRAM_SIZE; )
+   {
+      // Skip blocks without changes quickly
+      if ( ( ( i & 0x7 ) == 0 ) && ( dirty[i >> 3] == 0 ) )
+      {
+         i += 8;
+         continue;
+      }
+      if ( !( dirty[i >> 3] & ( 1 << ( i & 0x7 ) ) ) )
+      {
+         i++;
+         continue;
+      }
+
+      if ( addr != indexToAddr ( i ) )
+      {
+         if ( budget < 2 )
+         {
+            break;
+         }
+         addr = indexToAddr ( i );
+         lcd->command ( LCD_SETDDRAMADDR | addr );
+         budget--;
+      }
+      if ( budget == 0 )
+      {
+         break;
+      }
+      run = span ( dirty, i, maxGap, budget );
+      lcd->write ( &_ddram[i], run );
+      budget -= run;
+      i      += run;
+      addr    = nextAddr ( indexToAddr ( i - 1 ) );
+   }
+
+   for ( uint8_t i = 0; i < sizeof ( _dirty[display] ); i++ )
+   {
+      if ( dirty[i] != 0 )
+      {
+         lcd->endBatch ( );
+         return ( 0 );
+      }
+   }
+
+   // Leave the display cursor where it is in the buffer when it is visible
+   if ( _cursorDirty & ( 1 << display ) )
+   {
+      _cursorDirty &= ~( 1 << display );
+      if ( ( _displaycontrol & ( LCD_CURSORON | LCD_BLINKON ) ) && ( !_cgram ) &&
+           ( addr != indexToAddr ( _ac ) ) )
+      {
+         lcd->command ( LCD_SETDDRAMADDR | indexToAddr ( _ac ) );
+      }
+   }
+   lcd->endBatch ( );
+   return ( 1 );
+}
+
+//
+// setPageFlip
+int LiquidCrystal_Buffer::setPageFlip ( uint8_t enable )
+{
+   if ( !enable )
+   {
+      _pageMode = false;
+      return ( 1 );
+   }
+
+   // Both pages have to fit in a DDRAM line, 4 line displays use the
+   // second half of the lines for lines 2 and 3.
+   if ( !( _displayfunction & LCD_2LINE ) || ( _numlines > 2 ) ||
+        ( _cols > ( LCDBUF_LINE_SIZE / 2 ) ) )
+   {
+      return ( 0 );
+   }
+   _pageMode = true;
+   _back  = ( LCDBUF_LINE_SIZE - _shift + _cols ) % LCDBUF_LINE_SIZE;
+   _ac    = _back;
+   _cgram = false;
+   return ( 1 );
+}
+
+//
+// flip
+void LiquidCrystal_Buffer::flip ( void )
+{
+   uint8_t front;
+   uint8_t moves;
+
+   if ( !_pageMode )
+   {
+      return;
+   }
+
+   // Complete the back page and move the displays to it
+   flush ( );
+   front = ( LCDBUF_LINE_SIZE - _shift ) % LCDBUF_LINE_SIZE;
+   moves = ( _back + LCDBUF_LINE_SIZE - front ) % LCDBUF_LINE_SIZE;
+   for ( uint8_t i = 0; i < _numDisplays; i++ )
+   {
+      shiftDisplay ( _display[i], moves );
+   }
+   _shift = ( _shift + LCDBUF_LINE_SIZE - moves ) % LCDBUF_LINE_SIZE;
+
+   // The page that was shown is the next one to be drawn
+   _back  = front;
+   _ac    = _back;
+   _cgram = false;
+   _cursorDirty = 0xFF;
+}
+
+//
+// invalidate
+void LiquidCrystal_Buffer::invalidate ( uint8_t display )
+{
+   if ( display < LCDBUF_MAX_DISPLAYS )
+   {
+      memset ( _dirty[display], 0xFF, sizeof ( _dirty[display] ) );
+      _cursorDirty |= ( 1 << display );
+      _reshift     |= ( 1 << display );
+#if ( LCDBUF_MAX_SHIFT > 0 )
+      _inSync = false;
+#endif
+   }
+}
+
+//
+// setBacklight
+void LiquidCrystal_Buffer::setBacklight ( uint8_t value )
+{
+   for ( uint8_t i = 0; i < _numDisplays; i++ )
+   {
+      _display[i]->setBacklight ( value );
+   }
+}
+
+//
+// send - apply commands and data to the buffer
+void LiquidCrystal_Buffer::send(uint8_t value, uint8_t mode)
+{
+   if ( mode == FOUR_BITS )
+   {
+      return;                      // interface initialisation, nothing to do
+   }
+
+   if ( mode == DATA )
+   {
+      if ( _cgram )
+      {
+         // Custom characters go straight to the displays
+         for ( uint8_t i = 0; i < _numDisplays; i++ )
+         {
+            _display[i]->write ( value );
+         }
+         return;
+      }
+      if ( _pendingClear )
+      {
+         _written[_ac >> 3] |= ( 1 << ( _ac & 0x7 ) );
+      }
+      if ( _ddram[_ac] != value )
+      {
+         _ddram[_ac] = value;
+         for ( uint8_t i = 0; i < _numDisplays; i++ )
+         {
+            _dirty[i][_ac >> 3] |= ( 1 << ( _ac & 0x7 ) );
+         }
+      }
+      advance ( _displaymode & LCD_ENTRYLEFT );
+
+      // Autoscroll moves the display with every character written
+      if ( _displaymode & LCD_ENTRYSHIFTINCREMENT )
+      {
+         send ( LCD_CURSORSHIFT | LCD_DISPLAYMOVE |
+                ( ( _displaymode & LCD_ENTRYLEFT ) ? LCD_MOVELEFT : LCD_MOVERIGHT ),
+                COMMAND );
+      }
+      return;
+   }
+
+   // Commands, from the highest bit set down
+   if ( value & LCD_SETDDRAMADDR )
+   {
+      _cgram = false;
+      _ac = pageIndex ( addrToIndex ( value & 0x7F ) );
+      _cursorDirty = 0xFF;
+   }
+   else if ( value & LCD_SETCGRAMADDR )
+   {
+      _cgram = true;
+      forward ( value );
+   }
+   else if ( value & LCD_FUNCTIONSET )
+   {
+      // The displays have been configured by their own begin
+   }
+   else if ( value & LCD_CURSORSHIFT )
+   {
+      if ( value & LCD_DISPLAYMOVE )
+      {
+         _shift = ( value & LCD_MOVERIGHT ) ? _shift + 1 : _shift + shiftPeriod ( ) - 1;
+         _shift %= shiftPeriod ( );
+         forward ( value );
+      }
+      else
+      {
+         advance ( value & LCD_MOVERIGHT );
+      }
+   }
+   else if ( value & LCD_DISPLAYCONTROL )
+   {
+      forward ( value );
+      _cursorDirty = 0xFF;
+   }
+   else if ( value & LCD_ENTRYMODESET )
+   {
+      // The displays are always written left to right without shifting,
+      // the entry mode only applies to the buffer.
+   }
+   else if ( value & ( LCD_RETURNHOME | LCD_CLEARDISPLAY ) )
+   {
+      if ( value & LCD_CLEARDISPLAY )
+      {
+         // Don't clear the displays, the buffer is blanked when flushing
+         // keeping the characters rewritten since then. The usual clear and
+         // print sequence only sends what has actually changed.
+         _pendingClear = true;
+         memset ( _written, 0, sizeof ( _written ) );
+         _displaymode |= LCD_ENTRYLEFT;
+
+         // Only the page being drawn is cleared
+         if ( _pageMode )
+         {
+            for ( uint8_t i = 0; i < LCDBUF_DDRAM_SIZE; i++ )
+            {
+               if ( ( ( i % LCDBUF_LINE_SIZE ) + LCDBUF_LINE_SIZE - _back ) %
+                    LCDBUF_LINE_SIZE >= _cols )
+               {
+                  _written[i >> 3] |= ( 1 << ( i & 0x7 ) );
+               }
+            }
+         }
+      }
+      // Both commands undo any display shift, the displays keep the shift
+      // of their DDRAM contents though. Flipping pages moves the displays.
+      if ( ( _shift != 0 ) && !_pageMode )
+      {
+         for ( uint8_t i = 0; i < _numDisplays; i++ )
+         {
+            if ( _offset == 0 )
+            {
+               _display[i]->home ( );
+            }
+            else
+            {
+               shiftDisplay ( _display[i], _shift );
+            }
+         }
+         _shift = 0;
+      }
+      _cgram = false;
+      _ac = pageIndex ( 0 );
+      _cursorDirty = 0xFF;
+   }
+}
+
+// PRIVATE METHODS
+// ---------------------------------------------------------------------------
+
+//
+// init
+void LiquidCrystal_Buffer::init ( void )
+{
+   _numDisplays = 0;
+   _cursorDirty = 0;
+   _reshift = 0;
+   _ac     = 0;
+   _shift  = 0;
+   _offset = 0;
+   _cgram  = false;
+   _pageMode = false;
+   _back   = 0;
+   _displayfunction = LCD_4BITMODE | LCD_1LINE | LCD_5x8DOTS;
+   _displaycontrol  = LCD_DISPLAYON | LCD_CURSOROFF | LCD_BLINKOFF;
+   _displaymode     = LCD_ENTRYLEFT | LCD_ENTRYSHIFTDECREMENT;
+   _numlines = 1;
+   _cols     = 0;
+   _polarity = POSITIVE;
+   memset ( _ddram, LCDBUF_BLANK, sizeof ( _ddram ) );
+   memset ( _dirty, 0, sizeof ( _dirty ) );
+   _pendingClear = false;
+#if ( LCDBUF_MAX_SHIFT > 0 )
+   memset ( _prev, LCDBUF_BLANK, sizeof ( _prev ) );
+   _inSync = false;
+#endif
+}
+
+//
+// applyClear
+void LiquidCrystal_Buffer::applyClear ( void )
+{
+   if ( !_pendingClear )
+   {
+      return;
+   }
+   _pendingClear = false;
+
+   // Blank whatever hasn't been written since the clear
+   for ( uint8_t i = 0; i < LCDBUF_DDRAM_SIZE; i++ )
+   {
+      if ( !( _written[i >> 3] & ( 1 << ( i & 0x7 ) ) ) &&
+           ( _ddram[i] != LCDBUF_BLANK ) )
+      {
+         _ddram[i] = LCDBUF_BLANK;
+         for ( uint8_t j = 0; j < _numDisplays; j++ )
+         {
+            _dirty[j][i >> 3] |= ( 1 << ( i & 0x7 ) );
+         }
+      }
+   }
+}
+
+//
+// forward
+void LiquidCrystal_Buffer::forward ( uint8_t value )
+{
+   for ( uint8_t i = 0; i < _numDisplays; i++ )
+   {
+      _display[i]->command ( value );
+   }
+}
+
+//
+// addrToIndex
+uint8_t LiquidCrystal_Buffer::addrToIndex ( uint8_t addr )
+{
+   if ( _displayfunction & LCD_2LINE )
+   {
+      // Line 1 starts at 0x40, 40 characters per line
+      return ( ( ( addr & 0x40 ) ? LCDBUF_LINE_SIZE : 0 ) +
+               ( ( addr & 0x3F ) % LCDBUF_LINE_SIZE ) );
+   }
+   return ( addr % LCDBUF_DDRAM_SIZE );
+}
+
+//
+// indexToAddr
+uint8_t LiquidCrystal_Buffer::indexToAddr ( uint8_t index )
+{
+   if ( _displayfunction & LCD_2LINE )
+   {
+      // The displays may hold the lines rotated (see detectShift)
+      return ( ( ( index >= LCDBUF_LINE_SIZE ) ? 0x40 : 0 ) +
+               ( ( index % LCDBUF_LINE_SIZE ) + _offset ) % LCDBUF_LINE_SIZE );
+   }
+   return ( index );
+}
+
+//
+// pageIndex
+uint8_t LiquidCrystal_Buffer::pageIndex ( uint8_t index )
+{
+   uint8_t line = ( index >= LCDBUF_LINE_SIZE ) ? LCDBUF_LINE_SIZE : 0;
+
+   if ( !_pageMode )
+   {
+      return ( index );
+   }
+   return ( line + ( index - line + _back ) % LCDBUF_LINE_SIZE );
+}
+
+//
+// nextAddr
+uint8_t LiquidCrystal_Buffer::nextAddr ( uint8_t addr )
+{
+   if ( _displayfunction & LCD_2LINE )
+   {
+      // The end of a line continues on the other one
+      if ( ( addr & 0x3F ) == ( LCDBUF_LINE_SIZE - 1 ) )
+      {
+         return ( ( addr ^ 0x40 ) & 0x40 );
+      }
+      return ( addr + 1 );
+   }
+   return ( ( addr + 1 ) % LCDBUF_DDRAM_SIZE );
+}
+
+//
+// shiftPeriod
+uint8_t LiquidCrystal_Buffer::shiftPeriod ( void )
+{
+   return ( ( _displayfunction & LCD_2LINE ) ? LCDBUF_LINE_SIZE : LCDBUF_DDRAM_SIZE );
+}
+
+//
+// span
+uint8_t LiquidCrystal_Buffer::span ( uint8_t *dirty, uint8_t index, uint16_t maxGap,
+                                     uint8_t maxLength )
+{
+   uint8_t  addr   = indexToAddr ( index );
+   uint8_t  length = 0;             // up to the last changed character
+   uint16_t gap    = 0;
+
+   // Changed characters at consecutive display addresses, bridging gaps of
+   // up to maxGap unchanged characters.
+   for ( uint8_t i = index; ( i < LCDBUF_DDRAM_SIZE ) && ( i - index < maxLength ) &&
+         ( indexToAddr ( i ) == addr ); i++ )
+   {
+      if ( dirty[i >> 3] & ( 1 << ( i & 0x7 ) ) )
+      {
+         dirty[i >> 3] &= ~( 1 << ( i & 0x7 ) );
+         length = i - index + 1;
+         gap    = 0;
+      }
+      else if ( ++gap > maxGap )
+      {
+         break;
+      }
+      addr = nextAddr ( addr );
+   }
+   return ( length );
+}
+
+//
+// shiftDisplay
+void LiquidCrystal_Buffer::shiftDisplay ( LCD *lcd, uint8_t moves )
+{
+   // Whatever direction takes less commands
+   if ( moves <= ( shiftPeriod ( ) / 2 ) )
+   {
+      for ( uint8_t i = 0; i < moves; i++ )
+      {
+         lcd->command ( LCD_CURSORSHIFT | LCD_DISPLAYMOVE | LCD_MOVELEFT );
+      }
+   }
+   else
+   {
+      for ( uint8_t i = moves; i < shiftPeriod ( ); i++ )
+      {
+         lcd->command ( LCD_CURSORSHIFT | LCD_DISPLAYMOVE | LCD_MOVERIGHT );
+      }
+   }
+}
+
+#if ( LCDBUF_MAX_SHIFT > 0 )
+//
+// detectShift
+void LiquidCrystal_Buffer::detectShift ( void )
+{
+   uint8_t changed = 0;
+   uint8_t cost;
+   uint8_t moves;
+   uint8_t best = 0;
+
+   // Shifting moves both lines, 1 line mode would shift the whole DDRAM.
+   if ( !( _displayfunction & LCD_2LINE ) || ( _numDisplays == 0 ) )
+   {
+      return;
+   }
+
+   for ( uint8_t i = 0; i < LCDBUF_DDRAM_SIZE; i++ )
+   {
+      if ( _ddram[i] != _prev[i] )
+      {
+         changed++;
+      }
+   }
+
+   // Moving the display k positions costs k commands, and then, the
+   // characters that still differ from the moved frame have to be written.
+   for ( uint8_t k = 1; ( k <= LCDBUF_MAX_SHIFT ) && ( k < changed ); k++ )
+   {
+      for ( uint8_t dir = 0; dir < 2; dir++ )
+      {
+         moves = dir ? ( LCDBUF_LINE_SIZE - k ) : k;
+         cost  = k;
+         for ( uint8_t i = 0; ( i < LCDBUF_DDRAM_SIZE ) && ( cost < changed ); i++ )
+         {
+            if ( _ddram[i] != _prev[rotate ( i, moves )] )
+            {
+               cost++;
+            }
+         }
+         if ( cost < changed )
+         {
+            changed = cost;
+            best    = moves;
+         }
+      }
+   }
+
+   if ( best == 0 )
+   {
+      return;
+   }
+
+   // Move the displays, each position now shows the previous frame moved,
+   // only what differs from it is pending.
+   for ( uint8_t d = 0; d < _numDisplays; d++ )
+   {
+      shiftDisplay ( _display[d], best );
+      for ( uint8_t i = 0; i < LCDBUF_DDRAM_SIZE; i++ )
+      {
+         if ( _ddram[i] != _prev[rotate ( i, best )] )
+         {
+            _dirty[d][i >> 3] |= ( 1 << ( i & 0x7 ) );
+         }
+         else
+         {
+            _dirty[d][i >> 3] &= ~( 1 << ( i & 0x7 ) );
+         }
+      }
+   }
+   _offset = ( _offset + best ) % LCDBUF_LINE_SIZE;
+   _cursorDirty = 0xFF;
+}
+
+//
+// rotate
+uint8_t LiquidCrystal_Buffer::rotate ( uint8_t index, uint8_t moves )
+{
+   uint8_t line = ( index >= LCDBUF_LINE_SIZE ) ? LCDBUF_LINE_SIZE : 0;
+
+   return ( line + ( index - line + moves ) % LCDBUF_LINE_SIZE );
+}
+#endif
+
+//
+// advance
+void LiquidCrystal_Buffer::advance ( uint8_t increment )
+{
+   // The address counter wraps around the whole DDRAM, on 2 line mode the
+   // end of the first line continues on the second one.
+   if ( increment )
+   {
+      _ac = ( _ac + 1 ) % LCDBUF_DDRAM_SIZE;
+   }
+   else
+   {
+      _ac = ( _ac == 0 ) ? LCDBUF_DDRAM_SIZE - 1 : _ac - 1;
+   }
+   _cursorDirty = 0xFF;
+}
@@ -0,0 +1,362 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LiquidCrystal_Buffer.h
+// This file implements a buffered LCD that forwards its contents to one or
+// more physical LCDs.
+//
+// @brief
+// This class implements the LCD interface on top of an in memory copy of
+// the LCD display data RAM (DDRAM). Everything written to it (print, write,
+// setCursor, clear, ...) is rendered once into the copy, and only the
+// characters that actually change are marked as pending for each attached
+// display. Calling flush sends each display its own pending changes using
+// the display's own driver, so the same screen can be shown on displays
+// connected through different transports (i.e. a parallel LCD and a remote
+// I2C one) formatting and comparing the contents just once.
+//
+//   LiquidCrystal      local(8, 9, 4, 5, 6, 7);
+//   LiquidCrystal_I2C  remote(0x27, 2, 1, 0, 4, 5, 6, 7, 3, POSITIVE);
+//   LiquidCrystal_Buffer lcd(local, remote);
+//
+//   lcd.begin(20, 4);                 // initialises both displays
+//   lcd.setCursor(0, 0);
+//   lcd.print(temperature);
+//   lcd.flush();                      // send the changes to both displays
+//
+// Display control (display on/off, cursor, blink), display shifts, custom
+// characters and backlight are forwarded to the displays straight away.
+// All displays should have the same geometry.
+//
+// ---------------------------------------------------------------------------
+#ifndef LiquidCrystal_Buffer_h
+#define LiquidCrystal_Buffer_h
+
+#include <inttypes.h>
+#include <Print.h>
+
+#include "LCD.h"
+
+/*!
+ @defined
+ @abstract   Maximum number of displays attached to a buffer.
+ @discussion Each display takes LCDBUF_DDRAM_SIZE/8 bytes of RAM to keep
+ track of its pending changes. The cursor and window restores pending are
+ kept one bit per display in a byte, up to 8 displays.
+ */
+#ifndef LCDBUF_MAX_DISPLAYS
+#define LCDBUF_MAX_DISPLAYS     2
+#endif
+
+#if ( LCDBUF_MAX_DISPLAYS > 8 )
+#error "LCDBUF_MAX_DISPLAYS can't be above 8"
+#endif
+
+/*!
+ @defined
+ @abstract   Maximum display shift detected when flushing.
+ @discussion When a new frame is the previous one moved horizontally up to
+ this number of positions (i.e. a ticker or a panned view), flush moves the
+ displays with display shift commands and only writes the characters that
+ come into view. Detecting it takes LCDBUF_DDRAM_SIZE bytes of RAM to keep
+ the previous frame, 0 disables it.
+ */
+#ifndef LCDBUF_MAX_SHIFT
+#define LCDBUF_MAX_SHIFT        8
+#endif
+
+/*!
+ @defined
+ @abstract   Size of the LCD display data RAM.
+ @discussion HD44780 DDRAM holds 80 characters: 2 lines of 40 characters or
+ a single line of 80 characters.
+ */
+#define LCDBUF_DDRAM_SIZE       80
+
+/*!
+ @defined
+ @abstract   Characters per DDRAM line in 2 line mode.
+ */
+#define LCDBUF_LINE_SIZE        40
+
+class LiquidCrystal_Buffer : public LCD
+{
+public:
+   /*!
+    @method
+    @abstract   Class constructor.
+    @discussion Initializes the buffer and attaches the display(s) it will
+    forward its contents to. More displays can be attached with addDisplay.
+
+    @param      display[in] first display.
+    */
+   LiquidCrystal_Buffer ( LCD &display );
+   LiquidCrystal_Buffer ( LCD &display1, LCD &display2 );
+
+   /*!
+    @function
+    @abstract   Attaches a display to the buffer.
+    @discussion Attaches a display that will receive the contents of the
+    buffer. The display is not initialised, either attach it before calling
+    begin or initialise it independently and then call invalidate.
+
+    @param      display[in] display to attach.
+    @result     1 if the display was attached, 0 if the maximum number of
+    displays (LCDBUF_MAX_DISPLAYS) has been reached.
+    */
+   int addDisplay ( LCD &display );
+
+   /*!
+    @function
+    @abstract   LCD initialization.
+    @discussion Initializes all the attached displays and the buffer to a
+    given size (col, row). The buffer is left blank.
+
+    @param      cols[in] the number of columns that the display has
+    @param      rows[in] the number of rows that the display has
+    @param      charsize[in] character size, default==LCD_5x8DOTS
+    */
+   virtual void begin(uint8_t cols, uint8_t rows, uint8_t charsize = LCD_5x8DOTS);
+
+   /*!
+    @function
+    @abstract   Sends pending changes to the displays.
+    @discussion Writes to each attached display the characters that have
+    changed since it was last flushed. Runs of consecutive changed characters
+    are sent with a single addressing command, short gaps of unchanged
+    characters are rewritten when it is cheaper than addressing the next
+    change on the display (see LCD::dataCost and LCD::commandCost).
+    */
+   void flush ( void );
+
+   /*!
+    @function
+    @abstract   Sends pending changes to a display.
+    @discussion Writes to a single display the characters that have changed
+    since it was last flushed. Displays can be flushed at different rates,
+    each one keeps track of its own pending changes.
+
+    @param      display[in] index of the display (order in which it was attached).
+    */
+   void flush ( uint8_t display );
+
+   /*!
+    @function
+    @abstract   Sends part of the pending changes to a display.
+    @discussion Same as flush but limiting the bus operations (characters
+    written and addressing commands) done in a single call, so that updates
+    can trickle out to the display a bit on every loop, i.e. while drawing
+    the next page (see setPageFlip).
+
+    @param      display[in] index of the display.
+    @param      budget[in] maximum number of characters and commands to send.
+    @result     1 if the display is up to date, 0 if there are changes left.
+    */
+   int flush ( uint8_t display, uint8_t budget );
+
+   /*!
+    @function
+    @abstract   Marks the whole contents as pending for a display.
+    @discussion Forces the next flush to rewrite the whole display, i.e.
+    after a display has been reinitialised or hot plugged.
+
+    @param      display[in] index of the display.
+    */
+   void invalidate ( uint8_t display );
+
+   /*!
+    @function
+    @abstract   Enables page flipping.
+    @discussion A 2 line display only shows part of its 40 characters per
+    line. With page flipping enabled everything written to the buffer
+    (setCursor, print, clear, ...) goes to a page beyond the visible
+    columns while the current page stays on view, so the next page can be
+    flushed to the displays little by little without being seen. flip then
+    brings it into view at once with display shift commands.
+
+      lcd.setPageFlip ( true );
+      lcd.clear ( );                  // draw the next page
+      lcd.print ( ... );
+      while ( !lcd.flush ( 0, 8 ) )   // trickle it out
+      {
+         ...
+      }
+      lcd.flip ( );                   // show it
+
+    Pages are cols characters apart in the DDRAM, so it needs the LCD in
+    2 line mode with up to 2 lines and 20 columns. The cursor stays on the
+    page being drawn, out of view. When disabling page flipping the displays
+    are left shifted until the next clear or home.
+
+    @param      enable[in] true to enable page flipping.
+    @result     1 if successful, 0 if the geometry doesn't allow it.
+    */
+   int setPageFlip ( uint8_t enable );
+
+   /*!
+    @function
+    @abstract   Shows the page being drawn.
+    @discussion Completes the flush of the page being drawn to all the
+    displays and moves them to it. The page that was shown becomes the
+    page to draw, its contents are not cleared. @see setPageFlip
+    */
+   void flip ( void );
+
+   /*!
+    @function
+    @abstract   Switch-on/off the backlight of all the displays.
+
+    @param      value: backlight value forwarded to each display.
+    */
+   void setBacklight ( uint8_t value );
+
+   /*!
+    @function
+    @abstract   Send a particular value to the buffer.
+    @discussion Interprets the LCD commands and data applying them to the
+    buffer.
+
+    Users should never call this method.
+
+    @param      value[in] Value to send to the LCD.
+    @param      mode[in] DATA - write to the LCD CGRAM, COMMAND - write a
+    command to the LCD.
+    */
+   virtual void send(uint8_t value, uint8_t mode);
+
+protected:
+   /*!
+    @function
+    @abstract   Waits for the LCD to execute a command.
+    @discussion The buffer doesn't need to wait, the displays do their own
+    waits when the operations are forwarded to them.
+    */
+   virtual void waitExec ( uint16_t uSec ) { };
+
+private:
+   /*!
+    @function
+    @abstract   Initialises the buffer.
+    */
+   void init ( void );
+
+   /*!
+    @function
+    @abstract   Completes a pending clear.
+    @discussion Blanks the characters that haven't been written since the
+    last clear command.
+    */
+   void applyClear ( void );
+
+   /*!
+    @function
+    @abstract   Forwards a command to all the displays.
+    */
+   void forward ( uint8_t value );
+
+   /*!
+    @function
+    @abstract   Converts a DDRAM address into a buffer index.
+    */
+   uint8_t addrToIndex ( uint8_t addr );
+
+   /*!
+    @function
+    @abstract   Converts a buffer index into a DDRAM address.
+    */
+   uint8_t indexToAddr ( uint8_t index );
+
+   /*!
+    @function
+    @abstract   Moves a buffer index to the page being drawn.
+    */
+   uint8_t pageIndex ( uint8_t index );
+
+   /*!
+    @function
+    @abstract   Returns the display address following a given one.
+    */
+   uint8_t nextAddr ( uint8_t addr );
+
+   /*!
+    @function
+    @abstract   Number of positions the display shift goes through.
+    @discussion A DDRAM line (40) in 2 line mode, the whole DDRAM (80) in 1
+    line mode.
+    */
+   uint8_t shiftPeriod ( void );
+
+   /*!
+    @function
+    @abstract   Finds a run of changes to be written in one go.
+    @discussion Clears the pending changes of the run.
+    @param      dirty[in] pending changes of a display.
+    @param      index[in] first change of the run.
+    @param      maxGap[in] longest gap of unchanged characters to rewrite.
+    @param      maxLength[in] longest run to write.
+    @result     number of characters to write.
+    */
+   uint8_t span ( uint8_t *dirty, uint8_t index, uint16_t maxGap,
+                  uint8_t maxLength );
+
+   /*!
+    @function
+    @abstract   Moves the address counter one position.
+    */
+   void advance ( uint8_t increment );
+
+   /*!
+    @function
+    @abstract   Moves the window shown by a display.
+    @param      lcd[in] display to move.
+    @param      moves[in] positions to the left (below shiftPeriod), moving
+    to the right is used when shorter.
+    */
+   void shiftDisplay ( LCD *lcd, uint8_t moves );
+
+#if ( LCDBUF_MAX_SHIFT > 0 )
+   /*!
+    @function
+    @abstract   Detects that the new frame is the previous one moved.
+    @discussion When moving the displays and writing what differs costs less
+    than writing all the changes, the displays are moved and their pending
+    changes are updated accordingly. From then on, the displays hold their
+    lines rotated by _offset positions.
+    */
+   void detectShift ( void );
+
+   /*!
+    @function
+    @abstract   Index of a character moved within its line.
+    */
+   uint8_t rotate ( uint8_t index, uint8_t moves );
+#endif
+
+   LCD    *_display[LCDBUF_MAX_DISPLAYS];    // Attached displays
+   uint8_t _numDisplays;                     // Number of attached displays
+   uint8_t _ddram[LCDBUF_DDRAM_SIZE];        // DDRAM contents
+   uint8_t _dirty[LCDBUF_MAX_DISPLAYS][LCDBUF_DDRAM_SIZE / 8]; // Pending changes
+   uint8_t _written[LCDBUF_DDRAM_SIZE / 8];  // Written since a clear
+   bool    _pendingClear;                    // Clear to be applied on flush
+   uint8_t _cursorDirty;                     // Cursor to be placed (display bitmap)
+   uint8_t _reshift;                         // Window to be restored (display bitmap)
+   uint8_t _ac;                              // DDRAM address counter (index)
+   uint8_t _shift;                           // Display shift (0..shiftPeriod-1)
+   uint8_t _offset;                          // Rotation of the displays lines
+   bool    _cgram;                           // Address counter is on CGRAM
+   bool    _pageMode;                        // Page flipping enabled
+   uint8_t _back;                            // First column of the page drawn
+#if ( LCDBUF_MAX_SHIFT > 0 )
+   uint8_t _prev[LCDBUF_DDRAM_SIZE];         // Frame shown by all the displays
+   bool    _inSync;                          // All the displays show _prev
+#endif
+};
+
+#endif
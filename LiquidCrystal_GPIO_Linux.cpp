@@ -0,0 +1,256 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LiquidCrystal_GPIO_Linux.cpp
+// This file implements a driver for parallel LCDs (4 bit mode) connected to
+// the GPIO lines of a Linux board, through the GPIO character device
+// interface (/dev/gpiochipN).
+//
+// @brief
+// The lines are requested in the order RS, EN, D4-D7 and backlight, so the
+// bits of a line values request follow that order.
+//
+// ---------------------------------------------------------------------------
+#include "LiquidCrystal_GPIO_Linux.h"
+
+#if defined ( __linux__ )
+
+#if (ARDUINO <  100)
+#include <WProgram.h>
+#else
+#include <Arduino.h>
+#endif
+#include <inttypes.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/gpio.h>
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+#define LINE_RS         0x01
+#define LINE_EN         0x02
+#define LINE_DATA       0x3C
+#define LINE_BACKLIGHT  0x40
+
+// CONSTRUCTORS
+// ---------------------------------------------------------------------------
+LiquidCrystal_GPIO_Linux::LiquidCrystal_GPIO_Linux ( const char *chip,
+                                                     uint8_t rs, uint8_t enable,
+                                                     uint8_t d4, uint8_t d5,
+                                                     uint8_t d6, uint8_t d7,
+                                                     const t_linuxIO &io )
+{
+   config ( chip, rs, enable, d4, d5, d6, d7, io );
+}
+
+LiquidCrystal_GPIO_Linux::LiquidCrystal_GPIO_Linux ( const char *chip,
+                                                     uint8_t rs, uint8_t enable,
+                                                     uint8_t d4, uint8_t d5,
+                                                     uint8_t d6, uint8_t d7,
+                                                     uint8_t backlightPin,
+                                                     t_backlighPol pol,
+                                                     const t_linuxIO &io )
+{
+   config ( chip, rs, enable, d4, d5, d6, d7, io );
+   _lines[6] = backlightPin;
+   _polarity = pol;
+   setBacklight ( BACKLIGHT_OFF );
+}
+
+LiquidCrystal_GPIO_Linux::~LiquidCrystal_GPIO_Linux ( void )
+{
+   if ( _linesFd >= 0 )
+   {
+      _io->close ( _linesFd );
+   }
+   if ( _chipFd >= 0 )
+   {
+      _io->close ( _chipFd );
+   }
+}
+
+// PUBLIC METHODS
+// ---------------------------------------------------------------------------
+
+//
+// begin
+void LiquidCrystal_GPIO_Linux::begin ( uint8_t cols, uint8_t lines, uint8_t dotsize )
+{
+   struct gpio_v2_line_request request;
+
+   if ( _chipFd < 0 )
+   {
+      _chipFd = _io->open ( _chip, O_RDWR );
+   }
+   if ( ( _chipFd >= 0 ) && ( _linesFd < 0 ) )
+   {
+      memset ( &request, 0, sizeof ( request ) );
+      request.num_lines = ( _lines[6] == LCDGPIO_NO_LINE ) ? 6 : 7;
+      for ( uint8_t i = 0; i < request.num_lines; i++ )
+      {
+         request.offsets[i] = _lines[i];
+      }
+      strncpy ( request.consumer, "LCD", sizeof ( request.consumer ) - 1 );
+      request.config.flags = GPIO_V2_LINE_FLAG_OUTPUT;
+
+      // Outputs start low, the backlight as last set
+      if ( _backlight )
+      {
+         request.config.num_attrs = 1;
+         request.config.attrs[0].attr.id     = GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES;
+         request.config.attrs[0].attr.values = LINE_BACKLIGHT;
+         request.config.attrs[0].mask        = LINE_BACKLIGHT;
+      }
+      if ( _io->ioctl ( _chipFd, GPIO_V2_GET_LINE_IOCTL, &request ) == 0 )
+      {
+         _linesFd = request.fd;
+      }
+   }
+
+   deadline ( _ready, 0 );
+   _rs = 0xFF;
+   _displayfunction = LCD_4BITMODE | LCD_1LINE | LCD_5x8DOTS;
+   LCD::begin ( cols, lines, dotsize );
+}
+
+//
+// send - write either command or data
+void LiquidCrystal_GPIO_Linux::send ( uint8_t value, uint8_t mode )
+{
+   if ( mode == FOUR_BITS )
+   {
+      write4bits ( ( value & 0x0F ), COMMAND );
+   }
+   else
+   {
+      write4bits ( ( value >> 4 ), mode );
+      write4bits ( ( value & 0x0F ), mode );
+   }
+   deadline ( _ready, LCD_EXEC_TIME * 1000L );
+}
+
+//
+// setBacklight
+void LiquidCrystal_GPIO_Linux::setBacklight ( uint8_t value )
+{
+   if ( _lines[6] == LCDGPIO_NO_LINE )
+   {
+      return;
+   }
+   _backlight = ( ( ( _polarity == POSITIVE ) && ( value > 0 ) ) ||
+                  ( ( _polarity == NEGATIVE ) && ( value == 0 ) ) ) ?
+                LINE_BACKLIGHT : 0;
+   setLines ( _backlight, LINE_BACKLIGHT );
+}
+
+// PROTECTED METHODS
+// ---------------------------------------------------------------------------
+
+//
+// waitExec
+void LiquidCrystal_GPIO_Linux::waitExec ( uint16_t uSec )
+{
+   deadline ( _ready, uSec * 1000L );
+}
+
+// PRIVATE METHODS
+// ---------------------------------------------------------------------------
+
+//
+// config
+void LiquidCrystal_GPIO_Linux::config ( const char *chip, uint8_t rs,
+                                        uint8_t enable, uint8_t d4, uint8_t d5,
+                                        uint8_t d6, uint8_t d7,
+                                        const t_linuxIO &io )
+{
+   _io       = &io;
+   _chip     = chip;
+   _chipFd   = -1;
+   _linesFd  = -1;
+   _lines[0] = rs;
+   _lines[1] = enable;
+   _lines[2] = d4;
+   _lines[3] = d5;
+   _lines[4] = d6;
+   _lines[5] = d7;
+   _lines[6] = LCDGPIO_NO_LINE;
+   _backlight = 0;
+   _rs        = 0xFF;
+   _polarity  = POSITIVE;
+   deadline ( _ready, 0 );
+}
+
+//
+// write4bits
+void LiquidCrystal_GPIO_Linux::write4bits ( uint8_t value, uint8_t mode )
+{
+   struct timespec pulse;
+   uint8_t         data = ( value & 0x0F ) << 2;
+   uint8_t         rs   = ( mode == DATA ) ? LINE_RS : 0;
+
+   sleepUntil ( _ready );
+   if ( rs != _rs )
+   {
+      // RS is set up before EN rises (tAS), with the data
+      setLines ( data | rs, LINE_DATA | LINE_RS );
+      setLines ( LINE_EN, LINE_EN );
+      _rs = rs;
+   }
+   else
+   {
+      // The data is only needed when EN falls, it goes with EN rising
+      setLines ( data | LINE_EN, LINE_DATA | LINE_EN );
+   }
+   deadline ( pulse, LCDGPIO_PULSE_TIME );
+   deadline ( _ready, LCDGPIO_CYCLE_TIME );
+   sleepUntil ( pulse );
+   setLines ( 0, LINE_EN );       // the LCD latches the nibble
+}
+
+//
+// setLines
+void LiquidCrystal_GPIO_Linux::setLines ( uint8_t values, uint8_t mask )
+{
+   struct gpio_v2_line_values lines;
+
+   if ( _linesFd < 0 )
+   {
+      return;
+   }
+   lines.bits = values;
+   lines.mask = mask;
+   _io->ioctl ( _linesFd, GPIO_V2_LINE_SET_VALUES_IOCTL, &lines );
+}
+
+//
+// deadline
+void LiquidCrystal_GPIO_Linux::deadline ( struct timespec &t, long nsec )
+{
+   clock_gettime ( CLOCK_MONOTONIC, &t );
+   t.tv_nsec += nsec;
+   while ( t.tv_nsec >= 1000000000L )
+   {
+      t.tv_nsec -= 1000000000L;
+      t.tv_sec++;
+   }
+}
+
+//
+// sleepUntil
+void LiquidCrystal_GPIO_Linux::sleepUntil ( const struct timespec &t )
+{
+   // Restarted if interrupted by a signal, the deadline doesn't move
+   while ( clock_nanosleep ( CLOCK_MONOTONIC, TIMER_ABSTIME, &t, NULL ) == EINTR )
+   {
+   }
+}
+
+#endif
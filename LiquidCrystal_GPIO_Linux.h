@@ -0,0 +1,199 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LiquidCrystal_GPIO_Linux.h
+// This file implements a driver for parallel LCDs (4 bit mode) connected to
+// the GPIO lines of a Linux board, through the GPIO character device
+// interface (/dev/gpiochipN).
+//
+// @brief
+// All the LCD lines (RS, EN, D4-D7 and optionally the backlight) are
+// requested at once from the GPIO chip and set with
+// GPIO_V2_LINE_SET_VALUES_IOCTL, several lines per call instead of a write
+// per pin to sysfs.
+//
+// A nibble can't be a single call: the LCD latches it on the falling edge
+// of EN, which has to be a call of its own after the pulse width, and the
+// data has to stay 10ns (tH) after it, so it changes in the next call at
+// the earliest. The data only has to be there before EN falls, it is set
+// with the rising edge of EN: a nibble takes two calls. RS is different,
+// it has to be set 40ns (tAS) before EN rises. When RS changes, from
+// commands to characters or back, the nibble takes a third call setting
+// RS and the data before EN rises. A string or a command sequence only
+// changes RS once.
+//
+// Timing is kept with deadlines on the monotonic clock (clock_nanosleep):
+// each write records when the LCD will be ready and the next one only
+// sleeps what is left of it, so the time taken by the system calls counts
+// towards the execution time of the LCD.
+//
+//   LiquidCrystal_GPIO_Linux lcd("/dev/gpiochip0", 25, 24, 23, 17, 18, 22);
+//
+// The system calls are made through a t_linuxIO table, the last argument
+// of the constructors, so that the driver can be run against a stand in for
+// the GPIO chip.
+//
+// Only built on Linux.
+//
+// ---------------------------------------------------------------------------
+#ifndef LiquidCrystal_GPIO_Linux_h
+#define LiquidCrystal_GPIO_Linux_h
+
+#if defined ( __linux__ )
+
+#include <inttypes.h>
+#include <time.h>
+
+#include "LCD.h"
+#include "LinuxIO.h"
+
+/*!
+ @defined
+ @abstract   Minimum enable pulse width (ns).
+ */
+#define LCDGPIO_PULSE_TIME      450
+
+/*!
+ @defined
+ @abstract   Minimum enable cycle time (ns).
+ */
+#define LCDGPIO_CYCLE_TIME      1000
+
+/*!
+ @defined
+ @abstract   No backlight line.
+ */
+#define LCDGPIO_NO_LINE         0xFF
+
+class LiquidCrystal_GPIO_Linux : public LCD
+{
+public:
+   /*!
+    @method
+    @abstract   Class constructor.
+    @discussion Defines the GPIO lines (offsets within the chip) the LCD is
+    connected to. The constructor does not initialize the LCD nor requests
+    the lines.
+
+    @param      chip[in] GPIO chip device node, i.e. "/dev/gpiochip0".
+    @param      rs[in] RS line.
+    @param      enable[in] EN line.
+    @param      d4[in] D4 line.
+    @param      d5[in] D5 line.
+    @param      d6[in] D6 line.
+    @param      d7[in] D7 line.
+    @param      io[in] system calls to use.
+    */
+   LiquidCrystal_GPIO_Linux ( const char *chip, uint8_t rs, uint8_t enable,
+                              uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7,
+                              const t_linuxIO &io = linuxSystemIO );
+
+   // Constructor with backlight control
+   LiquidCrystal_GPIO_Linux ( const char *chip, uint8_t rs, uint8_t enable,
+                              uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7,
+                              uint8_t backlightPin, t_backlighPol pol,
+                              const t_linuxIO &io = linuxSystemIO );
+
+   /*!
+    @method
+    @abstract   Class destructor.
+    @discussion Releases the lines and closes the chip.
+    */
+   ~LiquidCrystal_GPIO_Linux ( void );
+
+   /*!
+    @function
+    @abstract   LCD initialization.
+    @discussion Requests the lines as outputs and initializes the LCD to a
+    given size (col, row).
+
+    @param      cols[in] the number of columns that the display has
+    @param      rows[in] the number of rows that the display has
+    @param      charsize[in] size of the characters of the LCD: LCD_5x8DOTS or
+    LCD_5x10DOTS.
+    */
+   virtual void begin ( uint8_t cols, uint8_t rows, uint8_t charsize = LCD_5x8DOTS );
+
+   /*!
+    @function
+    @abstract   Send a particular value to the LCD.
+    @discussion Sends a particular value to the LCD for writing to the LCD or
+    as an LCD command.
+
+    Users should never call this method.
+
+    @param      value[in] Value to send to the LCD.
+    @param      mode[in] DATA - write to the LCD CGRAM, COMMAND - write a
+    command to the LCD.
+    */
+   virtual void send ( uint8_t value, uint8_t mode );
+
+   /*!
+    @function
+    @abstract   Switch-on/off the LCD backlight.
+
+    @param      value: backlight mode (HIGH|LOW)
+    */
+   void setBacklight ( uint8_t value );
+
+protected:
+   /*!
+    @function
+    @abstract   Waits for the LCD to execute a command.
+    @discussion Doesn't wait, it moves the deadline of the next write.
+    */
+   virtual void waitExec ( uint16_t uSec );
+
+private:
+   /*!
+    @function
+    @abstract   Initialises class private variables.
+    */
+   void config ( const char *chip, uint8_t rs, uint8_t enable, uint8_t d4,
+                 uint8_t d5, uint8_t d6, uint8_t d7, const t_linuxIO &io );
+
+   /*!
+    @function
+    @abstract   Writes a nibble to the LCD.
+    */
+   void write4bits ( uint8_t value, uint8_t mode );
+
+   /*!
+    @function
+    @abstract   Sets the value of the lines in mask.
+    @discussion Bit 0 is RS, 1 EN, 2 to 5 D4 to D7 and 6 the backlight.
+    */
+   void setLines ( uint8_t values, uint8_t mask );
+
+   /*!
+    @function
+    @abstract   Sets a deadline from now.
+    */
+   void deadline ( struct timespec &t, long nsec );
+
+   /*!
+    @function
+    @abstract   Sleeps until a deadline.
+    */
+   void sleepUntil ( const struct timespec &t );
+
+   const t_linuxIO *_io;            // System calls
+   const char      *_chip;          // Chip device node
+   int              _chipFd;        // Open chip, -1 if not
+   int              _linesFd;       // Lines requested, -1 if not
+   uint8_t          _lines[7];      // RS, EN, D4-D7, backlight line offsets
+   uint8_t          _backlight;     // Backlight line value
+   uint8_t          _rs;            // RS line value, 0xFF if not known
+   struct timespec  _ready;         // When the LCD can take the next write
+};
+
+#endif
+
+#endif
@@ -167,6 +167,7 @@ void LiquidCrystal_I2C::begin(uint8_t cols, uint8_t lines, uint8_t dotsize)
 void LiquidCrystal_I2C::setBacklightPin ( uint8_t value, t_backlighPol pol = POSITIVE )
 {
    _backlightPinMask = ( 1 << value );
+   _lcdMask |= _backlightPinMask;
    _polarity = pol;
    setBacklight(BACKLIGHT_OFF);
 }
@@ -190,10 +191,17 @@ void LiquidCrystal_I2C::setBacklight( uint8_t value )
       {
          _backlightStsMask = _backlightPinMask & LCD_NOBACKLIGHT;
       }
-      _i2cio.write( MCP23008_GPIO, _backlightStsMask );
+      _i2cio.writeMask( _lcdMask, _backlightStsMask );
    }
 }
 
+//
+// getI2CIO
+I2CIO &LiquidCrystal_I2C::getI2CIO ( void )
+{
+   return ( _i2cio );
+}
+
 
 // PRIVATE METHODS
 // ---------------------------------------------------------------------------
@@ -238,6 +246,9 @@ void LiquidCrystal_I2C::config (uint8_t lcd_Addr, uint8_t En, uint8_t Rw, uint8_
    _data_pins[1] = ( 1 << d5 );
    _data_pins[2] = ( 1 << d6 );
    _data_pins[3] = ( 1 << d7 );   
+   
+   _lcdMask = _En | _Rw | _Rs | _data_pins[0] | _data_pins[1] | _data_pins[2] |
+              _data_pins[3];
 }
 
 
@@ -264,6 +275,13 @@ void LiquidCrystal_I2C::send(uint8_t value, uint8_t mode)
    }
 }
 
+//
+// maxSendTime
+uint16_t LiquidCrystal_I2C::maxSendTime ( void )
+{
+   return ( LCI2C_MAX_SEND );
+}
+
 //
 // write4bits
 void LiquidCrystal_I2C::write4bits ( uint8_t value, uint8_t mode ) 
@@ -296,6 +314,7 @@ void LiquidCrystal_I2C::write4bits ( uint8_t value, uint8_t mode )
 // pulseEnable
 void LiquidCrystal_I2C::pulseEnable (uint8_t data)
 {
-   _i2cio.write (MCP23008_GPIO, data | _En);   // En HIGH
-   _i2cio.write (MCP23008_GPIO, data & ~_En);  // En LOW
+   // Only the LCD pins are written, spare expander pins are left as they are
+   _i2cio.writeMask (_lcdMask, data | _En);   // En HIGH
+   _i2cio.writeMask (_lcdMask, data & ~_En);  // En LOW
 }
\ No newline at end of file
@@ -37,6 +37,22 @@
 #define LCI2C_MCP23008 0
 #define LCI2C_OTHER 1
 
+/*!
+ @defined 
+ @abstract   Time to transfer a byte on the I2C bus (us).
+ @discussion 9 clock cycles at the default 100kHz Wire clock.
+ */
+#define LCI2C_BYTE_TIME 90
+
+/*!
+ @defined 
+ @abstract   Worst case time of a send (us).
+ @discussion 4 expander writes (enable high and low for each nibble) of up
+ to 3 bytes on an MCP23008, of 2 bytes on a PCF8574 followed by a 2 byte
+ input read when an interrupt pin is set.
+ */
+#define LCI2C_MAX_SEND ( 16 * LCI2C_BYTE_TIME )
+
 class LiquidCrystal_I2C : public LCD 
 {
 public:
@@ -129,6 +145,12 @@ public:
     command to the LCD.
     */
    virtual void send(uint8_t value, uint8_t mode);
+
+   /*!
+    @function
+    @abstract   Worst case time of a send. @see LCD::maxSendTime
+    */
+   virtual uint16_t maxSendTime ( void );
    
    /*!
     @function
@@ -151,6 +173,19 @@ public:
     */
    void setBacklight ( uint8_t value );
    
+   /*!
+    @function
+    @abstract   Gets the IO expander driver of the backpack.
+    @discussion Gives access to the IO expander driving the LCD to use its
+    spare pins (the ones not connected to the LCD or the backlight). The
+    LCD port writes only change the LCD pins, the rest keep the levels set
+    through this object and pending batched changes are sent along with the
+    next LCD write. @see I2CIO::beginBatch.
+    
+    @result     IO expander driver.
+    */
+   I2CIO &getI2CIO ( void );
+   
 private:
    
    /*!
@@ -205,6 +240,7 @@ private:
    uint8_t _Rw;               // LCD expander word for R/W pin
    uint8_t _Rs;               // LCD expander word for Register Select pin
    uint8_t _data_pins[4];     // LCD data lines
+   uint8_t _lcdMask;          // Expander pins used by the LCD and backlight
    uint8_t _chipType;
    
 };
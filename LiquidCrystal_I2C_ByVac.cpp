@@ -32,13 +32,14 @@
 #endif
 #include <inttypes.h>
 #include "LiquidCrystal_I2C_ByVac.h"
+#include "LCDBusTrace.h"
 
 // CONSTRUCTORS
 // ---------------------------------------------------------------------------
 LiquidCrystal_I2C_ByVac::LiquidCrystal_I2C_ByVac( uint8_t lcd_Addr )
 {
    _Addr = lcd_Addr;
-   _polarity == NEGATIVE;
+   _polarity = NEGATIVE;
 }
 
 // PUBLIC METHODS
@@ -59,10 +60,9 @@ void LiquidCrystal_I2C_ByVac::begin(uint8_t cols, uint8_t lines, uint8_t dotsize
 // setBacklight
 void LiquidCrystal_I2C_ByVac::setBacklight( uint8_t value ) 
 {
-  Wire.beginTransmission(_Addr);
-  Wire.write(0x03); 					//  ByVac command code 0x03 for backlight
-  if (value==0) Wire.write(1); else Wire.write((byte)0); 	// 1 for off since polarity is NEGATIVE
-  Wire.endTransmission();
+  uint8_t data = ( value == 0 ) ? 1 : 0;   // 1 for off since polarity is NEGATIVE
+  
+  transmit ( BYVAC_CMD_BACKLIGHT, &data, 1 );
 }
 
 // Turn the contrast off/on
@@ -70,10 +70,62 @@ void LiquidCrystal_I2C_ByVac::setBacklight( uint8_t value )
 // setContrast
 void LiquidCrystal_I2C_ByVac::setContrast( uint8_t value ) 
 {
-  Wire.beginTransmission(_Addr);
-  Wire.write(0x05); 					//  ByVac command code 0x05 for contrast
-  if (value==0) Wire.write((byte)0); else Wire.write(1); 
-  Wire.endTransmission();
+  uint8_t data = ( value == 0 ) ? 0 : 1;
+  
+  transmit ( BYVAC_CMD_CONTRAST, &data, 1 );
+}
+
+//
+// write - pack a string of characters in as few transactions as possible
+#if (ARDUINO <  100)
+void LiquidCrystal_I2C_ByVac::write(const uint8_t *buffer, size_t size)
+#else
+size_t LiquidCrystal_I2C_ByVac::write(const uint8_t *buffer, size_t size)
+#endif
+{
+  size_t  left = size;
+  uint8_t chunk;
+  
+  LCD_HOOK_START(LCD_OP_BULK, size);
+  while ( left > 0 )
+  {
+    chunk = ( left > BYVAC_STRING_CHUNK ) ? BYVAC_STRING_CHUNK : left;
+    if ( chunk == 1 )
+    {
+      send ( *buffer, DATA );   // single characters don't need a string
+    }
+    else
+    {
+      transmit ( BYVAC_CMD_STRING, buffer, chunk );
+    }
+    buffer += chunk;
+    left   -= chunk;
+  }
+  LCD_HOOK_END(LCD_OP_BULK, size);
+#if (ARDUINO >=  100)
+  return ( size );
+#endif
+}
+
+//
+// dataCost
+uint16_t LiquidCrystal_I2C_ByVac::dataCost ( void )
+{
+   return ( BYVAC_BYTE_TIME );
+}
+
+//
+// commandCost
+uint16_t LiquidCrystal_I2C_ByVac::commandCost ( void )
+{
+   return ( 3 * BYVAC_BYTE_TIME );
+}
+
+//
+// maxSendTime
+uint16_t LiquidCrystal_I2C_ByVac::maxSendTime ( void )
+{
+   return ( BYVAC_MAX_SEND );
 }
 
 // PRIVATE METHODS
@@ -98,8 +150,41 @@ int LiquidCrystal_I2C_ByVac::init()
 // send - write either command or data
 void LiquidCrystal_I2C_ByVac::send(uint8_t value, uint8_t mode) 
 {
-  Wire.beginTransmission(_Addr);
-  Wire.write(mode+1); // map COMMAND (0) -> ByVac command code 0x01/ DATA  (1) ->  ByVac command code 0x02
-  Wire.write(value);
-  Wire.endTransmission();
+  // The backpack firmware initialises the LCD interface by itself, there is
+  // no 4 bit interface initialisation sequence to send.
+  if ( mode == FOUR_BITS )
+  {
+    return;
+  }
+  // map COMMAND (0) -> ByVac command code 0x01/ DATA  (1) ->  ByVac command code 0x02
+  transmit ( ( mode == DATA ) ? BYVAC_CMD_DATA : BYVAC_CMD_COMMAND, &value, 1 );
+}
+
+//
+// transmit - send a command to the backpack, retry while it is busy
+uint8_t LiquidCrystal_I2C_ByVac::transmit ( uint8_t cmd, const uint8_t *data, 
+                                            uint8_t len )
+{
+  uint8_t status;
+  uint8_t retries = 0;
+  
+  // Retries depend on the backpack, only what is sent is traced
+  LCD_TRACE_BUS(cmd);
+  for ( uint8_t i = 0; i < len; i++ )
+  {
+    LCD_TRACE_BUS(data[i]);
+  }
+  
+  do
+  {
+    Wire.beginTransmission(_Addr);
+    Wire.write(cmd);
+    Wire.write(data, len);
+    status = Wire.endTransmission();
+    
+    // A NACK on the address means the backpack is still busy with the
+    // previous command, no data has been taken so it is safe to retry.
+  } while ( ( status == 2 ) && ( ++retries < BYVAC_MAX_RETRIES ) );
+  
+  return ( status );
 }
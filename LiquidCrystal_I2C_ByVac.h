@@ -33,6 +33,58 @@
 #include <../Wire/Wire.h>
 #include "LCD.h"
 
+/*!
+ @defined 
+ @abstract   ByVac backpack command codes.
+ @discussion Command codes understood by the BV4218/BV4208 firmware. Each
+ I2C transaction starts with one of these codes followed by its arguments.
+ BYVAC_CMD_STRING carries any number of characters to be written to the
+ display in a single transaction.
+ */
+#define BYVAC_CMD_COMMAND       0x01
+#define BYVAC_CMD_DATA          0x02
+#define BYVAC_CMD_BACKLIGHT     0x03
+#ifndef BYVAC_CMD_STRING
+#define BYVAC_CMD_STRING        0x04
+#endif
+#define BYVAC_CMD_CONTRAST      0x05
+
+/*!
+ @defined 
+ @abstract   Maximum number of attempts to address a busy backpack.
+ @discussion The backpack firmware does not acknowledge its address while it
+ is executing a command on the LCD. A transaction is retried up to this number
+ of times before it is given up.
+ */
+#define BYVAC_MAX_RETRIES       100
+
+/*!
+ @defined 
+ @abstract   Number of characters packed in a single string transaction.
+ @discussion Limited by the Wire library transmit buffer, one byte is used by
+ the command code.
+ */
+#ifdef BUFFER_LENGTH
+#define BYVAC_STRING_CHUNK      (BUFFER_LENGTH - 1)
+#else
+#define BYVAC_STRING_CHUNK      31
+#endif
+
+/*!
+ @defined 
+ @abstract   Time to transfer a byte on the I2C bus (us).
+ @discussion 9 clock cycles at the default 100kHz Wire clock.
+ */
+#define BYVAC_BYTE_TIME         90
+
+/*!
+ @defined 
+ @abstract   Worst case time of a send (us).
+ @discussion The address of the backpack not acknowledged on all the
+ retries but the last one, then address, command and value.
+ */
+#define BYVAC_MAX_SEND          ( ( BYVAC_MAX_RETRIES + 2 ) * BYVAC_BYTE_TIME )
+
 
 class LiquidCrystal_I2C_ByVac : public LCD 
 {
@@ -81,6 +133,46 @@ public:
     */
    virtual void send(uint8_t value, uint8_t mode);
    
+   /*!
+    @function
+    @abstract   Writes a string of characters to the LCD.
+    @discussion Writes size characters to the LCD at the current cursor
+    position. The characters are packed in as few I2C transactions as the Wire
+    buffer allows using the backpack's string command, instead of one 
+    transaction per character. All Print class string methods end up calling
+    this method.
+    
+    @param      buffer[in] characters to write to the LCD.
+    @param      size[in] number of characters to write.
+    */
+#if (ARDUINO <  100)
+   virtual void write(const uint8_t *buffer, size_t size);
+#else
+   virtual size_t write(const uint8_t *buffer, size_t size);
+#endif
+   using LCD::write;
+   
+   /*!
+    @function
+    @abstract   Cost of writing a character.
+    @discussion Characters written as a string take a single byte each on
+    the bus.
+    */
+   virtual uint16_t dataCost ( void );
+   
+   /*!
+    @function
+    @abstract   Cost of sending a command.
+    @discussion A command takes a whole transaction: address, command code
+    and the command itself.
+    */
+   virtual uint16_t commandCost ( void );
+   
+   /*!
+    @function
+    @abstract   Worst case time of a send. @see LCD::maxSendTime
+    */
+   virtual uint16_t maxSendTime ( void );
    
    /*!
     @function
@@ -101,6 +193,16 @@ public:
     */
    void setContrast ( uint8_t value );
  
+protected:
+   /*!
+    @function
+    @abstract   Waits for the LCD to execute a command.
+    @discussion The backpack firmware does not acknowledge any transaction
+    until the LCD has completed the previous one, therefore there is no need
+    to wait here. @see transmit.
+    */
+   virtual void waitExec ( uint16_t uSec ) { };
+   
 private:
    
    /*!
@@ -110,6 +212,21 @@ private:
     */
    int  init();
    
+   /*!
+    @function
+    @abstract   Sends a command to the backpack.
+    @discussion Sends a command code followed by its arguments in a single
+    I2C transaction. If the backpack is busy executing a previous command it
+    will not acknowledge its address; in that case the transaction is retried
+    (BYVAC_MAX_RETRIES) rather than waiting a fixed time.
+    
+    @param      cmd[in] ByVac command code.
+    @param      data[in] command arguments.
+    @param      len[in] number of arguments (max BYVAC_STRING_CHUNK).
+    @result     Wire status of the transaction, 0 on success.
+    */
+   uint8_t transmit ( uint8_t cmd, const uint8_t *data, uint8_t len );
+   
    /*!
     @function
     @abstract   Initialises class private variables
@@ -0,0 +1,296 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LiquidCrystal_I2C_Linux.cpp
+// This file implements a driver for I2C expander backpacks (PCF8574) on
+// Linux boards through the i2c-dev interface (/dev/i2c-N).
+//
+// @brief
+// The expander writes are queued in a buffer and sent as the data of a
+// single I2C write message: the PCF8574 latches each byte of a write as a
+// new output value, so a message of n bytes is n consecutive port writes.
+//
+// ---------------------------------------------------------------------------
+#include "LiquidCrystal_I2C_Linux.h"
+
+#if defined ( __linux__ )
+
+#if (ARDUINO <  100)
+#include <WProgram.h>
+#else
+#include <Arduino.h>
+#endif
+#include <inttypes.h>
+#include <fcntl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+
+// Default pin mapping, the same as LiquidCrystal_I2C
+#define EN 6  // Enable bit
+#define RW 5  // Read/Write bit
+#define RS 4  // Register select bit
+#define D4 0
+#define D5 1
+#define D6 2
+#define D7 3
+
+// CONSTRUCTORS
+// ---------------------------------------------------------------------------
+LiquidCrystal_I2C_Linux::LiquidCrystal_I2C_Linux ( const char *device,
+                                                   uint8_t lcd_Addr,
+                                                   const t_linuxIO &io )
+{
+   config ( device, lcd_Addr, EN, RW, RS, D4, D5, D6, D7, io );
+}
+
+LiquidCrystal_I2C_Linux::LiquidCrystal_I2C_Linux ( const char *device,
+                                                   uint8_t lcd_Addr,
+                                                   uint8_t En, uint8_t Rw,
+                                                   uint8_t Rs, uint8_t d4,
+                                                   uint8_t d5, uint8_t d6,
+                                                   uint8_t d7,
+                                                   uint8_t backlighPin,
+                                                   t_backlighPol pol,
+                                                   const t_linuxIO &io )
+{
+   config ( device, lcd_Addr, En, Rw, Rs, d4, d5, d6, d7, io );
+   _backlightPinMask = ( 1 << backlighPin );
+   _polarity = pol;
+   setBacklight ( BACKLIGHT_OFF );
+}
+
+LiquidCrystal_I2C_Linux::~LiquidCrystal_I2C_Linux ( void )
+{
+   if ( _fd >= 0 )
+   {
+      _io->close ( _fd );
+   }
+}
+
+// PUBLIC METHODS
+// ---------------------------------------------------------------------------
+
+//
+// begin
+void LiquidCrystal_I2C_Linux::begin ( uint8_t cols, uint8_t lines, uint8_t dotsize )
+{
+   if ( _fd < 0 )
+   {
+      _fd = _io->open ( _device, O_RDWR );
+   }
+   _displayfunction = LCD_4BITMODE | LCD_1LINE | LCD_5x8DOTS;
+   LCD::begin ( cols, lines, dotsize );
+}
+
+//
+// send - write either command or data
+void LiquidCrystal_I2C_Linux::send ( uint8_t value, uint8_t mode )
+{
+   if ( mode == FOUR_BITS )
+   {
+      write4bits ( ( value & 0x0F ), COMMAND );
+   }
+   else
+   {
+      write4bits ( ( value >> 4 ), mode );
+      write4bits ( ( value & 0x0F ), mode );
+   }
+
+   if ( _batch == 0 )
+   {
+      transmit ( );
+   }
+}
+
+//
+// write - a string in a single message
+size_t LiquidCrystal_I2C_Linux::write ( const uint8_t *buffer, size_t size )
+{
+   LCD_HOOK_START ( LCD_OP_BULK, size );
+   beginBatch ( );
+   for ( size_t i = 0; i < size; i++ )
+   {
+      send ( buffer[i], DATA );
+   }
+   endBatch ( );
+   LCD_HOOK_END ( LCD_OP_BULK, size );
+   return ( size );
+}
+
+//
+// beginBatch
+void LiquidCrystal_I2C_Linux::beginBatch ( void )
+{
+   _batch++;
+}
+
+//
+// endBatch
+void LiquidCrystal_I2C_Linux::endBatch ( void )
+{
+   if ( _batch > 0 )
+   {
+      _batch--;
+   }
+   if ( _batch == 0 )
+   {
+      transmit ( );
+   }
+}
+
+//
+// dataCost
+uint16_t LiquidCrystal_I2C_Linux::dataCost ( void )
+{
+   return ( 4 * LCDI2CL_BYTE_TIME );
+}
+
+//
+// commandCost
+uint16_t LiquidCrystal_I2C_Linux::commandCost ( void )
+{
+   return ( ( _batch != 0 ) ? ( 4 * LCDI2CL_BYTE_TIME ) :
+                              ( 4 * LCDI2CL_BYTE_TIME + LCDI2CL_CALL_TIME ) );
+}
+
+//
+// setBacklight
+void LiquidCrystal_I2C_Linux::setBacklight ( uint8_t value )
+{
+   if ( _backlightPinMask == 0x0 )
+   {
+      return;
+   }
+
+   if ( ( ( _polarity == POSITIVE ) && ( value > 0 ) ) ||
+        ( ( _polarity == NEGATIVE ) && ( value == 0 ) ) )
+   {
+      _backlightStsMask = _backlightPinMask;
+   }
+   else
+   {
+      _backlightStsMask = 0;
+   }
+
+   if ( _length == LCDI2CL_BUFFER_SIZE )
+   {
+      transmit ( );
+   }
+   _buffer[_length++] = _backlightStsMask;
+   if ( _batch == 0 )
+   {
+      transmit ( );
+   }
+}
+
+// PROTECTED METHODS
+// ---------------------------------------------------------------------------
+
+//
+// waitExec
+void LiquidCrystal_I2C_Linux::waitExec ( uint16_t uSec )
+{
+   transmit ( );
+   LCD::waitExec ( uSec );
+}
+
+// PRIVATE METHODS
+// ---------------------------------------------------------------------------
+
+//
+// config
+void LiquidCrystal_I2C_Linux::config ( const char *device, uint8_t lcd_Addr,
+                                       uint8_t En, uint8_t Rw, uint8_t Rs,
+                                       uint8_t d4, uint8_t d5, uint8_t d6,
+                                       uint8_t d7, const t_linuxIO &io )
+{
+   _io     = &io;
+   _device = device;
+   _fd     = -1;
+   _Addr   = lcd_Addr;
+
+   _backlightPinMask = 0;
+   _backlightStsMask = 0;
+   _polarity = POSITIVE;
+
+   _En = ( 1 << En );
+   _Rw = ( 1 << Rw );
+   _Rs = ( 1 << Rs );
+
+   _data_pins[0] = ( 1 << d4 );
+   _data_pins[1] = ( 1 << d5 );
+   _data_pins[2] = ( 1 << d6 );
+   _data_pins[3] = ( 1 << d7 );
+
+   _batch  = 0;
+   _length = 0;
+}
+
+//
+// write4bits
+void LiquidCrystal_I2C_Linux::write4bits ( uint8_t value, uint8_t mode )
+{
+   uint8_t pinMapValue = 0;
+
+   // Map the value to LCD pin mapping
+   for ( uint8_t i = 0; i < 4; i++ )
+   {
+      if ( ( value & 0x1 ) == 1 )
+      {
+         pinMapValue |= _data_pins[i];
+      }
+      value = ( value >> 1 );
+   }
+
+   if ( mode == DATA )
+   {
+      mode = _Rs;
+   }
+   pinMapValue |= mode | _backlightStsMask;
+
+   // Enable pulse, the bus is slow enough for the pulse width and for the
+   // LCD to execute the previous command (@see LCDI2CL_BUS_KHZ).
+   if ( _length + 2 > LCDI2CL_BUFFER_SIZE )
+   {
+      transmit ( );
+   }
+   _buffer[_length++] = pinMapValue | _En;
+   _buffer[_length++] = pinMapValue & ~_En;
+}
+
+//
+// transmit
+int LiquidCrystal_I2C_Linux::transmit ( void )
+{
+   struct i2c_msg             msg;
+   struct i2c_rdwr_ioctl_data data;
+   int                        status;
+
+   if ( _length == 0 )
+   {
+      return ( 1 );
+   }
+
+   msg.addr   = _Addr;
+   msg.flags  = 0;                  // write
+   msg.len    = _length;
+   msg.buf    = _buffer;
+   data.msgs  = &msg;
+   data.nmsgs = 1;
+
+   status = ( _fd >= 0 ) && ( _io->ioctl ( _fd, I2C_RDWR, &data ) == 1 );
+   _length = 0;
+   return ( status );
+}
+
+#endif
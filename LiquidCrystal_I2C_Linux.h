@@ -0,0 +1,263 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LiquidCrystal_I2C_Linux.h
+// This file implements a driver for I2C expander backpacks (PCF8574) on
+// Linux boards through the i2c-dev interface (/dev/i2c-N).
+//
+// @brief
+// Same backpacks and pin mappings as LiquidCrystal_I2C, but driven from
+// Linux userspace (i.e. a Raspberry Pi) instead of the Wire library.
+//
+// Each nibble sent to the LCD takes two expander writes (enable high and
+// low). Instead of a system call per expander write, the writes of a whole
+// string, or of a whole batch (@see LCD::beginBatch, LiquidCrystal_Buffer
+// flushes each display in a batch), are packed in a single I2C message
+// sent with one I2C_RDWR ioctl. The bus clock paces the writes: up to
+// 400kHz it is slower than the LCD execution time, so no delays are needed
+// between them. Faster buses are not supported (@see LCDI2CL_BUS_KHZ).
+//
+//   LiquidCrystal_I2C_Linux lcd("/dev/i2c-1", 0x27, 2, 1, 0, 4, 5, 6, 7, 3,
+//                               POSITIVE);
+//
+// The system calls are made through a t_linuxIO table, the last argument
+// of the constructors, so that the driver can be run against a stand in for
+// the device node.
+//
+// Only built on Linux.
+//
+// ---------------------------------------------------------------------------
+#ifndef LiquidCrystal_I2C_Linux_h
+#define LiquidCrystal_I2C_Linux_h
+
+#if defined ( __linux__ )
+
+#include <inttypes.h>
+#include <Print.h>
+
+#include "LCD.h"
+#include "LinuxIO.h"
+
+/*!
+ @defined
+ @abstract   Size of the I2C message buffer.
+ @discussion Each character takes 4 expander writes, the default holds the
+ whole LCD (80 characters) plus a few commands. Longer batches are sent in
+ several messages.
+ */
+#ifndef LCDI2CL_BUFFER_SIZE
+#define LCDI2CL_BUFFER_SIZE     352
+#endif
+
+/*!
+ @defined
+ @abstract   Clock of the I2C bus (kHz).
+ @discussion Set it to the clock of the adapter (i.e. i2c_arm_baudrate on a
+ Raspberry Pi). The expander writes of a message follow each other with no
+ wait: the LCD has 2 expander writes after a character or command before the
+ next nibble is latched, which covers its execution time up to 400kHz. A
+ faster bus (Fast-mode Plus, 1MHz) is refused at compile time.
+ */
+#ifndef LCDI2CL_BUS_KHZ
+#define LCDI2CL_BUS_KHZ         100
+#endif
+
+#if ( 2 * 9000 / LCDI2CL_BUS_KHZ < LCD_EXEC_TIME )
+#error "LCDI2CL_BUS_KHZ: the I2C bus is too fast for the LCD execution time"
+#endif
+
+/*!
+ @defined
+ @abstract   Time taken by an expander write on the bus (us).
+ @discussion Address and data bytes, 9 bits each, at LCDI2CL_BUS_KHZ.
+ */
+#define LCDI2CL_BYTE_TIME       ( ( 9000 + LCDI2CL_BUS_KHZ - 1 ) / LCDI2CL_BUS_KHZ )
+
+/*!
+ @defined
+ @abstract   Overhead of an I2C_RDWR ioctl (us).
+ @discussion Approximate time of the system call and the transaction
+ start and address byte.
+ */
+#define LCDI2CL_CALL_TIME       150
+
+class LiquidCrystal_I2C_Linux : public LCD
+{
+public:
+   /*!
+    @method
+    @abstract   Class constructor.
+    @discussion Initializes class variables, the pin mapping is the one of
+    LiquidCrystal_I2C(lcd_Addr). The constructor does not initialize the LCD
+    nor opens the device.
+
+    @param      device[in] i2c-dev device node, i.e. "/dev/i2c-1".
+    @param      lcd_Addr[in] I2C address of the IO expansion module.
+    @param      io[in] system calls to use.
+    */
+   LiquidCrystal_I2C_Linux ( const char *device, uint8_t lcd_Addr,
+                             const t_linuxIO &io = linuxSystemIO );
+
+   /*!
+    @method
+    @abstract   Class constructor.
+    @discussion Initializes class variables with the pin mapping of the
+    backpack. The constructor does not initialize the LCD nor opens the
+    device.
+
+    @param      device[in] i2c-dev device node, i.e. "/dev/i2c-1".
+    @param      lcd_Addr[in] I2C address of the IO expansion module.
+    @param      En[in] LCD En (Enable) pin connected to the IO extender module
+    @param      Rw[in] LCD Rw (Read/write) pin connected to the IO extender module
+    @param      Rs[in] LCD Rs (Reset) pin connected to the IO extender module
+    @param      d4[in] LCD data 0 pin map on IO extender module
+    @param      d5[in] LCD data 1 pin map on IO extender module
+    @param      d6[in] LCD data 2 pin map on IO extender module
+    @param      d7[in] LCD data 3 pin map on IO extender module
+    @param      backlighPin[in] backlight pin on IO extender module
+    @param      pol[in] backlight polarity
+    @param      io[in] system calls to use.
+    */
+   LiquidCrystal_I2C_Linux ( const char *device, uint8_t lcd_Addr,
+                             uint8_t En, uint8_t Rw, uint8_t Rs,
+                             uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7,
+                             uint8_t backlighPin, t_backlighPol pol,
+                             const t_linuxIO &io = linuxSystemIO );
+
+   /*!
+    @method
+    @abstract   Class destructor.
+    @discussion Closes the device.
+    */
+   ~LiquidCrystal_I2C_Linux ( void );
+
+   /*!
+    @function
+    @abstract   LCD initialization.
+    @discussion Opens the device and initializes the LCD to a given size
+    (col, row).
+
+    @param      cols[in] the number of columns that the display has
+    @param      rows[in] the number of rows that the display has
+    @param      charsize[in] size of the characters of the LCD: LCD_5x8DOTS or
+    LCD_5x10DOTS.
+    */
+   virtual void begin ( uint8_t cols, uint8_t rows, uint8_t charsize = LCD_5x8DOTS );
+
+   /*!
+    @function
+    @abstract   Send a particular value to the LCD.
+    @discussion Sends a particular value to the LCD for writing to the LCD or
+    as an LCD command. Within a batch the expander writes are queued.
+
+    Users should never call this method.
+
+    @param      value[in] Value to send to the LCD.
+    @param      mode[in] DATA - write to the LCD CGRAM, COMMAND - write a
+    command to the LCD.
+    */
+   virtual void send ( uint8_t value, uint8_t mode );
+
+   /*!
+    @function
+    @abstract   Writes a string of characters to the LCD.
+    @discussion The whole string is sent in a single I2C message.
+
+    @param      buffer[in] characters to write to the LCD.
+    @param      size[in] number of characters to write.
+    */
+   virtual size_t write ( const uint8_t *buffer, size_t size );
+   using LCD::write;
+
+   /*!
+    @function
+    @abstract   Starts a batch of transfers. @see LCD::beginBatch
+    */
+   virtual void beginBatch ( void );
+
+   /*!
+    @function
+    @abstract   Ends a batch of transfers, sending the queued expander writes
+    in a single I2C message. @see LCD::beginBatch
+    */
+   virtual void endBatch ( void );
+
+   /*!
+    @function
+    @abstract   Cost of writing a character.
+    @discussion 4 expander writes within a message.
+    */
+   virtual uint16_t dataCost ( void );
+
+   /*!
+    @function
+    @abstract   Cost of sending a command.
+    @discussion 4 expander writes, plus a message of its own when it isn't
+    part of a batch.
+    */
+   virtual uint16_t commandCost ( void );
+
+   /*!
+    @function
+    @abstract   Switch-on/off the LCD backlight.
+
+    @param      value: backlight mode (HIGH|LOW)
+    */
+   void setBacklight ( uint8_t value );
+
+protected:
+   /*!
+    @function
+    @abstract   Waits for the LCD to execute a command.
+    @discussion Sends the queued expander writes before waiting, the wait is
+    measured from when the command reaches the LCD.
+    */
+   virtual void waitExec ( uint16_t uSec );
+
+private:
+   /*!
+    @function
+    @abstract   Initialises class private variables.
+    */
+   void config ( const char *device, uint8_t lcd_Addr, uint8_t En, uint8_t Rw,
+                 uint8_t Rs, uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7,
+                 const t_linuxIO &io );
+
+   /*!
+    @function
+    @abstract   Queues the expander writes of a nibble.
+    */
+   void write4bits ( uint8_t value, uint8_t mode );
+
+   /*!
+    @function
+    @abstract   Sends the queued expander writes in one I2C message.
+    @result     1 on success, 0 otherwise.
+    */
+   int transmit ( void );
+
+   const t_linuxIO *_io;                          // System calls
+   const char      *_device;                      // Device node
+   int              _fd;                          // Open device, -1 if not
+   uint8_t          _Addr;                        // I2C address of the device
+   uint8_t          _backlightPinMask;            // Backlight IO pin mask
+   uint8_t          _backlightStsMask;            // Backlight status mask
+   uint8_t          _En;                          // LCD expander word for enable pin
+   uint8_t          _Rw;                          // LCD expander word for R/W pin
+   uint8_t          _Rs;                          // LCD expander word for Register Select pin
+   uint8_t          _data_pins[4];                // LCD data lines
+   uint8_t          _batch;                       // Batch nesting level
+   uint16_t         _length;                      // Expander writes queued
+   uint8_t          _buffer[LCDI2CL_BUFFER_SIZE]; // Queued expander writes
+};
+
+#endif
+
+#endif
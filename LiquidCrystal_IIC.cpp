@@ -36,6 +36,7 @@
 #include <inttypes.h>
 
 #include "LiquidCrystal_IIC.h"
+#include "LCDBusTrace.h"
 
 // include the Wire.h header
 // The reference is relative to the "core" directory which is always on
@@ -417,6 +418,13 @@ void LiquidCrystal_IIC::send(uint8_t value, uint8_t mode)
 	}
 }
 
+//
+// maxSendTime
+uint16_t LiquidCrystal_IIC::maxSendTime ( void )
+{
+	return ( IIC_MAX_SEND );
+}
+
 //
 // write4bits
 void LiquidCrystal_IIC::write4bits ( uint8_t value, uint8_t mode ) 
@@ -451,4 +459,6 @@ void LiquidCrystal_IIC::pulseEnable (uint8_t data)
 {
 	Wire.write(data |_En);   // En HIGH
 	Wire.write(data & ~_En); // En LOW
+	LCD_TRACE_BUS(data |_En);
+	LCD_TRACE_BUS(data & ~_En);
 }
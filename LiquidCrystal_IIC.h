@@ -84,6 +84,21 @@ typedef enum
 
 #define IIC_ADDR_UNKNOWN 0xff // use to auto locate device (only works if only device on bus)
 
+/*!
+ @defined 
+ @abstract   Time to transfer a byte on the I2C bus (us).
+ @discussion 9 clock cycles at the default 100kHz Wire clock.
+ */
+#define IIC_BYTE_TIME 90
+
+/*!
+ @defined 
+ @abstract   Worst case time of a send (us).
+ @discussion A single transaction: address, OLAT register on an MCP23008 and
+ the 4 port values of the 2 nibbles.
+ */
+#define IIC_MAX_SEND ( 6 * IIC_BYTE_TIME )
+
 
 class LiquidCrystal_IIC : public LCD 
 {
@@ -154,6 +169,12 @@ public:
 	 command to the LCD.
 	 */
 	virtual void send(uint8_t value, uint8_t mode);
+
+	/*!
+	 @function
+	 @abstract   Worst case time of a send. @see LCD::maxSendTime
+	 */
+	virtual uint16_t maxSendTime ( void );
 	
 	/*!
 	 @function
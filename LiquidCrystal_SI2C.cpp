@@ -0,0 +1,308 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LiquidCrystal_SI2C.cpp
+// This file implements a basic liquid crystal library that comes as standard
+// in the Arduino SDK using IIC backpacks driven by a software (bit banged)
+// I2C master on any two digital pins.
+//
+// @brief
+// This class implements the all methods to command an LCD based
+// on the Hitachi HD44780 and compatible chipsets using IIC backpacks
+// that use a simple IIC i/o expander chip (PCF8574 or MCP23008), without
+// using the Wire library.
+//
+// The functionality provided by this class and its base class is identical
+// to the original functionality of the Arduino LiquidCrystal library.
+//
+// ---------------------------------------------------------------------------
+#if (ARDUINO <  100)
+#include <WProgram.h>
+#else
+#include <Arduino.h>
+#endif
+
+#include <inttypes.h>
+
+#include "LiquidCrystal_SI2C.h"
+#include "LCDBusTrace.h"
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+/*!
+ @defined
+ @abstract   MCP23008 output latch register.
+ */
+#define SI2C_MCP23008_OLAT  0x0A
+
+// CONSTRUCTORS
+// ---------------------------------------------------------------------------
+LiquidCrystal_SI2C::LiquidCrystal_SI2C(uint8_t sda, uint8_t scl, uint8_t iic_addr,
+                                       iicChipType iic_type, uint8_t En, uint8_t Rw,
+                                       uint8_t Rs, uint8_t d4, uint8_t d5,
+                                       uint8_t d6, uint8_t d7 )
+{
+   config(sda, scl, iic_addr, iic_type, En, Rw, Rs, d4, d5, d6, d7);
+}
+
+LiquidCrystal_SI2C::LiquidCrystal_SI2C(uint8_t sda, uint8_t scl, uint8_t iic_addr,
+                                       iicChipType iic_type, uint8_t En, uint8_t Rw,
+                                       uint8_t Rs, uint8_t d4, uint8_t d5,
+                                       uint8_t d6, uint8_t d7,
+                                       uint8_t backlightPin, t_backlighPol pol)
+{
+   config(sda, scl, iic_addr, iic_type, En, Rw, Rs, d4, d5, d6, d7);
+   setBacklightPin(backlightPin, pol);
+}
+
+// PUBLIC METHODS
+// ---------------------------------------------------------------------------
+
+//
+// begin
+void LiquidCrystal_SI2C::begin(uint8_t cols, uint8_t lines, uint8_t dotsize)
+{
+   init();     // Initialise the bus and the IIC expander
+   LCD::begin ( cols, lines, dotsize );
+}
+
+//
+// write - stream a whole string in a single transaction
+#if (ARDUINO <  100)
+void LiquidCrystal_SI2C::write(const uint8_t *buffer, size_t size)
+#else
+size_t LiquidCrystal_SI2C::write(const uint8_t *buffer, size_t size)
+#endif
+{
+   LCD_HOOK_START(LCD_OP_BULK, size);
+   beginPort();
+   for ( size_t i = 0; i < size; i++ )
+   {
+      write4bits( (buffer[i] >> 4), DATA );
+      write4bits( (buffer[i] & 0x0F), DATA );
+#if ( SI2C_EXEC_WAIT > 0 )
+      // The bus is faster than the LCD executes the write
+      delayMicroseconds ( SI2C_EXEC_WAIT );
+#endif
+   }
+   endPort();
+   LCD_HOOK_END(LCD_OP_BULK, size);
+#if (ARDUINO >=  100)
+   return ( size );
+#endif
+}
+
+//
+// dataCost
+uint16_t LiquidCrystal_SI2C::dataCost ( void )
+{
+   return ( 4 * SI2C_BYTE_TIME + SI2C_EXEC_WAIT );
+}
+
+//
+// commandCost
+uint16_t LiquidCrystal_SI2C::commandCost ( void )
+{
+   uint16_t cost = ( _iicType == IIC_MCP23008 ) ? 6 * SI2C_BYTE_TIME : 5 * SI2C_BYTE_TIME;
+
+   return ( cost + SI2C_EXEC_WAIT );
+}
+
+// User commands - users can expand this section
+//----------------------------------------------------------------------------
+// Turn the (optional) backlight off/on
+
+//
+// setBacklightPin
+void LiquidCrystal_SI2C::setBacklightPin ( uint8_t value, t_backlighPol pol )
+{
+   // Only configure, the bus is not initialised until begin is called
+   // LCD::begin will set the backlight.
+   _backlightPinMask = ( 1 << value );
+   _polarity = pol;
+}
+
+//
+// setBacklight
+void LiquidCrystal_SI2C::setBacklight( uint8_t value )
+{
+   // Check if backlight is available
+   // ----------------------------------------------------
+   if ( _backlightPinMask != 0x0 )
+   {
+      // Check for polarity to configure status mask accordingly
+      // ----------------------------------------------------------
+      if  (((_polarity == POSITIVE) && (value > 0)) ||
+           ((_polarity == NEGATIVE ) && ( value == 0 )))
+      {
+         _backlightStsMask = _backlightPinMask;
+      }
+      else
+      {
+         _backlightStsMask = 0;
+      }
+      beginPort();
+      writeByte( _backlightStsMask );
+      endPort();
+   }
+}
+
+// PRIVATE METHODS
+// ---------------------------------------------------------------------------
+
+//
+// init
+int LiquidCrystal_SI2C::init()
+{
+   // Idle bus: both lines HIGH
+   _sda_reg = fio_pinToOutputRegister(_sdaPin, HIGH);
+   _sda     = fio_pinToBit(_sdaPin);
+   _scl_reg = fio_pinToOutputRegister(_sclPin, HIGH);
+   _scl     = fio_pinToBit(_sclPin);
+
+   if ( _iicType == IIC_MCP23008 )
+   {
+      // BYTE mode (no address increment) so that the output latch can be
+      // written over and over within the same transaction, then set all
+      // pins as outputs.
+      fio_i2cStart(_sda_reg, _sda, _scl_reg, _scl);
+      writeByte( _Addr << 1 );
+      writeByte( 0x05 );          // IOCON
+      writeByte( 0x20 );          // disable sequential mode
+      endPort();
+
+      fio_i2cStart(_sda_reg, _sda, _scl_reg, _scl);
+      writeByte( _Addr << 1 );
+      writeByte( 0x00 );          // IODIR
+      writeByte( 0x00 );          // all pins output
+      endPort();
+   }
+   beginPort();
+   writeByte( 0 );                // Set the entire output port to LOW
+   endPort();
+
+   _displayfunction = LCD_4BITMODE | LCD_1LINE | LCD_5x8DOTS;
+   return ( 1 );
+}
+
+//
+// config
+void LiquidCrystal_SI2C::config (uint8_t sda, uint8_t scl, uint8_t iic_addr,
+                                 iicChipType iic_type, uint8_t En, uint8_t Rw,
+                                 uint8_t Rs, uint8_t d4, uint8_t d5,
+                                 uint8_t d6, uint8_t d7 )
+{
+   _sdaPin  = sda;
+   _sclPin  = scl;
+   _Addr    = iic_addr;
+   // The expander can't be identified without reading from the bus
+   _iicType = ( iic_type == IIC_MCP23008 ) ? IIC_MCP23008 : IIC_PCF8574;
+
+   _backlightPinMask = 0;
+   _backlightStsMask = 0;
+   _polarity = POSITIVE;
+
+   _En = ( 1 << En );
+   _Rw = ( 1 << Rw );
+   _Rs = ( 1 << Rs );
+
+   // Initialise pin mapping
+   _data_pins[0] = ( 1 << d4 );
+   _data_pins[1] = ( 1 << d5 );
+   _data_pins[2] = ( 1 << d6 );
+   _data_pins[3] = ( 1 << d7 );
+}
+
+// low level data pushing commands
+//----------------------------------------------------------------------------
+
+//
+// send - write either command or data
+void LiquidCrystal_SI2C::send(uint8_t value, uint8_t mode)
+{
+   beginPort();
+   if ( mode == FOUR_BITS )
+   {
+      write4bits( (value & 0x0F), COMMAND );
+   }
+   else
+   {
+      // send both nibbles in same i2c transaction
+      write4bits( (value >> 4), mode );
+      write4bits( (value & 0x0F), mode );
+   }
+   endPort();
+#if ( SI2C_EXEC_WAIT > 0 )
+   delayMicroseconds ( SI2C_EXEC_WAIT ); // the bus is faster than the LCD
+#endif
+}
+
+//
+// maxSendTime
+uint16_t LiquidCrystal_SI2C::maxSendTime ( void )
+{
+   return ( SI2C_MAX_SEND );
+}
+
+//
+// beginPort
+void LiquidCrystal_SI2C::beginPort()
+{
+   fio_i2cStart(_sda_reg, _sda, _scl_reg, _scl);
+   writeByte( _Addr << 1 );       // address, write
+   if ( _iicType == IIC_MCP23008 )
+   {
+      writeByte( SI2C_MCP23008_OLAT );
+   }
+}
+
+//
+// endPort
+void LiquidCrystal_SI2C::endPort()
+{
+   fio_i2cStop(_sda_reg, _sda, _scl_reg, _scl);
+}
+
+//
+// write4bits
+void LiquidCrystal_SI2C::write4bits ( uint8_t value, uint8_t mode )
+{
+   uint8_t pinMapValue = 0;
+
+   // Map the value to LCD pin mapping
+   // --------------------------------
+   for ( uint8_t i = 0; i < 4; i++ )
+   {
+      if ( ( value & 0x1 ) == 1 )
+      {
+         pinMapValue |= _data_pins[i];
+      }
+      value = ( value >> 1 );
+   }
+
+   // Is it a command or data
+   // -----------------------
+   if ( mode == DATA )
+   {
+      mode = _Rs;
+   }
+
+   pinMapValue |= mode | _backlightStsMask;
+   writeByte( pinMapValue | _En );   // En HIGH
+   writeByte( pinMapValue & ~_En );  // En LOW
+}
+
+//
+// writeByte
+void LiquidCrystal_SI2C::writeByte ( uint8_t value )
+{
+   fio_i2cWrite(_sda_reg, _sda, _scl_reg, _scl, value);
+   LCD_TRACE_BUS(value);
+}
@@ -0,0 +1,269 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LiquidCrystal_SI2C.h
+// This file implements a basic liquid crystal library that comes as standard
+// in the Arduino SDK using IIC backpacks driven by a software (bit banged)
+// I2C master on any two digital pins.
+//
+// @brief
+// This class implements the all methods to command an LCD based
+// on the Hitachi HD44780 and compatible chipsets using IIC backpacks
+// that use a simple IIC i/o expander chip (PCF8574 or MCP23008), without
+// using the Wire library.
+//
+// The I2C master is write only: the bus is driven push-pull through the
+// FastIO routines, acknowledges are clocked but never read and clock
+// stretching is not supported. This is fine for the IO expanders used on LCD
+// backpacks. The bus is clocked at FIO_I2C_KHZ, 100kHz by default as the
+// PCF8574 requires, MCP23008 backpacks can be clocked up to 1700kHz. Each LCD
+// write (or a whole string, see write) is streamed in a single transaction
+// without any intermediate buffering.
+//
+// As there is no bus read back, the io expander can't be detected or located
+// and its type and address must be given. The canned IIC_BOARD_XXX
+// parameters of LiquidCrystal_IIC can be used:
+// LiquidCrystal_SI2C lcd(sda, scl, addr, IIC_BOARD_XXX);
+// LiquidCrystal_SI2C lcd(sda, scl, addr, chiptype, e,rw,rs,d4,d5,d6,d7,bl,blpol);
+//
+// Several displays can be driven from different pin pairs.
+//
+// The functionality provided by this class and its base class is identical
+// to the original functionality of the Arduino LiquidCrystal library.
+//
+// ---------------------------------------------------------------------------
+#ifndef LiquidCrystal_SI2C_h
+#define LiquidCrystal_SI2C_h
+#include <inttypes.h>
+#include <Print.h>
+
+#include "LCD.h"
+#include "FastIO.h"
+#include "LiquidCrystal_IIC.h"
+
+/*!
+ @defined
+ @abstract   Time to clock a byte out on the bus (us).
+ @discussion 9 clock periods at FIO_I2C_KHZ.
+ */
+#define SI2C_BYTE_TIME     ( 18 * FIO_I2C_HALF )
+
+/*!
+ @defined
+ @abstract   Wait for the LCD after a write (us).
+ @discussion The next enable pulse is a byte later on the bus, only a bus
+ clocked faster than that needs to wait for the rest of the execution time.
+ */
+#if ( SI2C_BYTE_TIME < LCD_EXEC_TIME )
+#define SI2C_EXEC_WAIT     ( LCD_EXEC_TIME - SI2C_BYTE_TIME )
+#else
+#define SI2C_EXEC_WAIT     0
+#endif
+
+/*!
+ @defined
+ @abstract   Worst case time of a send (us).
+ @discussion A single transaction: address, OLAT register on an MCP23008 and
+ the 4 port values of the 2 nibbles, start and stop (less than a byte) and
+ the wait for the LCD.
+ */
+#define SI2C_MAX_SEND      ( 7 * SI2C_BYTE_TIME + SI2C_EXEC_WAIT )
+
+
+class LiquidCrystal_SI2C : public LCD
+{
+public:
+
+   /*!
+    @method
+    @abstract   Class constructor.
+    @discussion Initializes class variables and defines the pins of the bus
+    and the IIC address of the LCD. The constructor does not initialize the
+    LCD.
+
+    @param      sda[in] digital IO used as I2C data line.
+    @param      scl[in] digital IO used as I2C clock line.
+    @param      iic_addr[in] IIC address of the IO expansion module.
+    @param      iic_type[in] IIC chip type used on the i/o expansion module,
+    IIC_UNKNOWN is handled as IIC_PCF8574.
+    @param      En[in] LCD En (Enable) pin connected to the IO extender module
+    @param      Rw[in] LCD Rw (Read/write) pin connected to the IO extender module
+    @param      Rs[in] LCD Rs (Reset) pin connected to the IO extender module
+    @param      d4[in] LCD data 0 pin map on IO extender module
+    @param      d5[in] LCD data 1 pin map on IO extender module
+    @param      d6[in] LCD data 2 pin map on IO extender module
+    @param      d7[in] LCD data 3 pin map on IO extender module
+    */
+   LiquidCrystal_SI2C(uint8_t sda, uint8_t scl, uint8_t iic_addr,
+                      iicChipType iic_type, uint8_t En, uint8_t Rw, uint8_t Rs,
+                      uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7 );
+   // Constructor with backlight control
+   LiquidCrystal_SI2C(uint8_t sda, uint8_t scl, uint8_t iic_addr,
+                      iicChipType iic_type, uint8_t En, uint8_t Rw, uint8_t Rs,
+                      uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7,
+                      uint8_t backlightPin, t_backlighPol pol = POSITIVE);
+
+   /*!
+    @function
+    @abstract   LCD initialization and associated HW.
+    @discussion Initializes the LCD to a given size (col, row). This methods
+    initializes the LCD, therefore, it MUST be called prior to using any other
+    method from this class or parent class.
+
+    @param      cols[in] the number of columns that the display has
+    @param      rows[in] the number of rows that the display has
+    @param      charsize[in] size of the characters of the LCD: LCD_5x8DOTS or
+    LCD_5x10DOTS.
+    */
+   virtual void begin(uint8_t cols, uint8_t rows, uint8_t charsize = LCD_5x8DOTS);
+
+   /*!
+    @function
+    @abstract   Send a particular value to the LCD.
+    @discussion Sends a particular value to the LCD for writing to the LCD or
+    as an LCD command.
+
+    Users should never call this method.
+
+    @param      value[in] Value to send to the LCD.
+    @param      mode[in] DATA - write to the LCD CGRAM, COMMAND - write a
+    command to the LCD.
+    */
+   virtual void send(uint8_t value, uint8_t mode);
+
+   /*!
+    @function
+    @abstract   Worst case time of a send. @see LCD::maxSendTime
+    */
+   virtual uint16_t maxSendTime ( void );
+
+   /*!
+    @function
+    @abstract   Writes a string of characters to the LCD.
+    @discussion Writes size characters to the LCD at the current cursor
+    position streaming all the nibbles in a single I2C transaction.
+    All Print class string methods end up calling this method.
+
+    @param      buffer[in] characters to write to the LCD.
+    @param      size[in] number of characters to write.
+    */
+#if (ARDUINO <  100)
+   virtual void write(const uint8_t *buffer, size_t size);
+#else
+   virtual size_t write(const uint8_t *buffer, size_t size);
+#endif
+   using LCD::write;
+
+   /*!
+    @function
+    @abstract   Cost of writing a character.
+    @discussion Characters written as a string take the 4 bytes of their two
+    nibbles each.
+    */
+   virtual uint16_t dataCost ( void );
+
+   /*!
+    @function
+    @abstract   Cost of sending a command.
+    @discussion A command takes a whole transaction: start, address, the
+    register on the MCP23008, its two nibbles and stop.
+    */
+   virtual uint16_t commandCost ( void );
+
+   /*!
+    @function
+    @abstract   Sets the pin to control the backlight.
+    @discussion Sets the pin in the device to control the backlight. This device
+    doesn't support dimming backlight capability.
+
+    @param      0: backlight off, 1..255: backlight on.
+    */
+   void setBacklightPin ( uint8_t value, t_backlighPol pol = POSITIVE );
+
+   /*!
+    @function
+    @abstract   Switch-on/off the LCD backlight.
+    @discussion Switch-on/off the LCD backlight.
+    The setBacklightPin has to be called before setting the backlight for
+    this method to work. @see setBacklightPin.
+
+    @param      value: backlight mode (BACKLIGHT_ON|BACKLIGHT_OFF)
+    */
+   void setBacklight ( uint8_t value );
+
+private:
+
+   /*!
+    @method
+    @abstract   Initializes the bus and the IO expander.
+    @discussion Configures the bus pins and initialises the IO expansion
+    module, all expander pins are set as outputs driven LOW.
+    */
+   int  init();
+
+   /*!
+    @function
+    @abstract   Initialises class private variables
+    @discussion This is the class single point for initialising private variables.
+    */
+   void config (uint8_t sda, uint8_t scl, uint8_t iic_addr, iicChipType iic_type,
+                uint8_t En, uint8_t Rw, uint8_t Rs,
+                uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7 );
+
+   /*!
+    @method
+    @abstract   Starts a transaction to the expander output port.
+    @discussion Issues the start condition and the address, and points the
+    MCP23008 to its output latch.
+    */
+   void beginPort();
+
+   /*!
+    @method
+    @abstract   Ends a transaction.
+    */
+   void endPort();
+
+   /*!
+    @method
+    @abstract   Writes an 4 bit value to the LCD.
+    @discussion Writes 4 bits (the least significant) to the LCD control data
+    lines within an open transaction.
+    @param      value[in] Value to write to the LCD
+    @param      mode[in]  Value to distinguish between command and data.
+    COMMAND == command, DATA == data.
+    */
+   void write4bits(uint8_t value, uint8_t mode);
+
+   /*!
+    @method
+    @abstract   Writes a byte to the bus.
+    */
+   void writeByte(uint8_t value);
+
+
+   fio_register _sda_reg;        // SDA pin MCU register
+   fio_bit      _sda;            // SDA pin
+   fio_register _scl_reg;        // SCL pin MCU register
+   fio_bit      _scl;            // SCL pin
+   uint8_t _sdaPin;              // SDA digital IO
+   uint8_t _sclPin;              // SCL digital IO
+   uint8_t _Addr;                // IIC Address of the IO expander
+   uint8_t _iicType;             // IIC chip type used on the IO expander
+   uint8_t _backlightPinMask;    // Backlight IO pin mask
+   uint8_t _backlightStsMask;    // Backlight status mask
+   uint8_t _En;                  // LCD expander IO pin mask for enable pin
+   uint8_t _Rw;                  // LCD expander IO pin mask for R/W pin
+   uint8_t _Rs;                  // LCD expander IO pin mask for Register Select pin
+   uint8_t _data_pins[4];        // LCD expander IO pin masks for data lines
+
+};
+
+#endif
@@ -90,6 +90,7 @@
 #include "LiquidCrystal_SR.h"
 
 #include "FastIO.h"
+#include "LCDBusTrace.h"
 
 
 // CONSTRUCTORS
@@ -146,6 +147,7 @@ void LiquidCrystal_SR::shiftIt(uint8_t val)
       fio_shiftOut(_srDataRegister, _srDataBit, _srClockRegister, _srClockBit);
    }
    fio_shiftOut(_srDataRegister, _srDataBit, _srClockRegister, _srClockBit, val, MSBFIRST);
+   LCD_TRACE_BUS(val);
    
    // LCD ENABLE PULSE
    //
@@ -197,6 +199,13 @@ void LiquidCrystal_SR::send(uint8_t value, uint8_t mode)
 
 }
 
+//
+// maxSendTime
+uint16_t LiquidCrystal_SR::maxSendTime ( void )
+{
+   return ( SR_MAX_SEND );
+}
+
 //
 // setBacklightPin
 void LiquidCrystal_SR::setBacklightPin ( uint8_t pin, t_backlighPol pol )
@@ -91,6 +91,19 @@
 #define SR_RS_BIT 0x04
 #define SR_EN_BIT 0x80
 
+/*!
+ @defined 
+ @abstract   Worst case time of a send (us).
+ @discussion 2 nibbles, each shifted out after clearing the register in two
+ wire mode, with a 1us enable pulse, and the wait for the LCD (17us in
+ three wire mode up to 16MHz, 37us on faster MCUs).
+ */
+#if (F_CPU <= 16000000)
+#define SR_MAX_SEND ( 4 * FIO_SHIFTOUT_TIME + 2 + 17 )
+#else
+#define SR_MAX_SEND ( 4 * FIO_SHIFTOUT_TIME + 2 + 37 )
+#endif
+
 class LiquidCrystal_SR : public LCD
 {
 public:
@@ -120,6 +133,12 @@ public:
     the LCD.
     */
    virtual void send(uint8_t value, uint8_t mode);
+
+   /*!
+    @function
+    @abstract   Worst case time of a send. @see LCD::maxSendTime
+    */
+   virtual uint16_t maxSendTime ( void );
    
    
    /*!
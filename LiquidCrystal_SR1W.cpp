@@ -33,6 +33,7 @@
 // ---------------------------------------------------------------------------
 
 #include "LiquidCrystal_SR1W.h"
+#include "LCDBusTrace.h"
 
 // CONSTRUCTORS
 // ---------------------------------------------------------------------------
@@ -120,6 +121,8 @@ uint8_t LiquidCrystal_SR1W::loadSR(uint8_t val)
 	// NOTE: This assumes the Serial PIN is already HIGH and the Data capacitor is fully charged
 	uint8_t previousBit = 1;
    
+	LCD_TRACE_BUS(val);
+   
 	// Send the data to the shift register (MSB first)
 	for (int8_t i = 7; i>=0; i--)
 	{
@@ -230,6 +233,13 @@ void LiquidCrystal_SR1W::send(uint8_t value, uint8_t mode)
 		delayMicroseconds(40 - totalDelay);
 }
 
+//
+// maxSendTime
+uint16_t LiquidCrystal_SR1W::maxSendTime ( void )
+{
+	return ( SR1W_MAX_SEND );
+}
+
 //
 // setBacklight
 void LiquidCrystal_SR1W::setBacklight ( uint8_t value )
@@ -278,6 +278,15 @@
 #define SR1W_DELAY_US		5
 #define SR1W_DELAY()		{ delayMicroseconds(SR1W_DELAY_US); numDelays++; }
 
+/*!
+ @defined 
+ @abstract   Worst case time of a send (us).
+ @discussion Each nibble takes up to 11 capacitor delays: one per bit, one
+ to latch and two to clear the register. A shift out time is added for the
+ register writes.
+ */
+#define SR1W_MAX_SEND		( 22 * SR1W_DELAY_US + FIO_SHIFTOUT_TIME )
+
 // 1-wire SR output bit constants
 // ---------------------------------------------------------------------------
 
@@ -326,6 +335,12 @@ public:
     the LCD.
     */
    virtual void send(uint8_t value, uint8_t mode);
+
+	/*!
+	 @function
+	 @abstract   Worst case time of a send. @see LCD::maxSendTime
+	 */
+	virtual uint16_t maxSendTime ( void );
    
    
    /*!
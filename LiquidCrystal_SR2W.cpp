@@ -30,6 +30,7 @@
 // ---------------------------------------------------------------------------
 
 #include "LiquidCrystal_SR2W.h"
+#include "LCDBusTrace.h"
 
 // CONSTRUCTORS
 // ---------------------------------------------------------------------------
@@ -69,6 +70,7 @@ void LiquidCrystal_SR2W::loadSR(uint8_t val)
    
 	// clock out SR data byte
 	fio_shiftOut(_srDataRegister, _srDataMask, _srClockRegister, _srClockMask, val, MSBFIRST);
+	LCD_TRACE_BUS(val);
    
  	
 	// strobe LCD enable which can now be toggled by the data line
@@ -112,6 +114,13 @@ void LiquidCrystal_SR2W::send(uint8_t value, uint8_t mode)
 #endif
 }
 
+//
+// maxSendTime
+uint16_t LiquidCrystal_SR2W::maxSendTime ( void )
+{
+	return ( SR2W_MAX_SEND );
+}
+
 //
 // setBacklight
 void LiquidCrystal_SR2W::setBacklight ( uint8_t value ) 
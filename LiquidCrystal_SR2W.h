@@ -134,6 +134,18 @@
 #define SR2W_DATA_MASK 0x78	// data bits are hard coded to be SR bits 6,5,4,3
 #define SR2W_EN_MASK 0x80	// cannot ever be changed
 
+/*!
+ @defined 
+ @abstract   Worst case time of a send (us).
+ @discussion 2 nibbles, each shifted out after clearing the register, with a
+ 1us enable pulse, and the wait for the LCD.
+ */
+#if (F_CPU <= 16000000)
+#define SR2W_MAX_SEND ( 4 * FIO_SHIFTOUT_TIME + 2 + 10 )
+#else
+#define SR2W_MAX_SEND ( 4 * FIO_SHIFTOUT_TIME + 2 + 37 )
+#endif
+
 class LiquidCrystal_SR2W : public LCD
 {
 public:
@@ -163,6 +175,12 @@ public:
     the LCD.
     */
    virtual void send(uint8_t value, uint8_t mode);
+
+	/*!
+	 @function
+	 @abstract   Worst case time of a send. @see LCD::maxSendTime
+	 */
+	virtual uint16_t maxSendTime ( void );
    
    
    /*!
@@ -77,6 +77,7 @@
 #include "LiquidCrystal_SR3W.h"
 
 #include "FastIO.h"
+#include "LCDBusTrace.h"
 
 /*!
  @defined 
@@ -179,6 +180,13 @@ void LiquidCrystal_SR3W::send(uint8_t value, uint8_t mode)
 
 }
 
+//
+// maxSendTime
+uint16_t LiquidCrystal_SR3W::maxSendTime ( void )
+{
+   return ( SR3W_MAX_SEND );
+}
+
 
 void LiquidCrystal_SR3W::setBacklightPin ( uint8_t value, t_backlighPol pol = POSITIVE )
 {
@@ -273,6 +281,7 @@ void LiquidCrystal_SR3W::loadSR(uint8_t value)
 {
    // Load the shift register with information
    fio_shiftOut(_data_reg, _data, _clk_reg, _clk, value, MSBFIRST);
+   LCD_TRACE_BUS(value);
    
    // Strobe the data into the latch
    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
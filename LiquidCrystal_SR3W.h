@@ -62,6 +62,18 @@
 #include "LCD.h"
 #include "FastIO.h"
 
+/*!
+ @defined 
+ @abstract   Worst case time of a send (us).
+ @discussion 2 nibbles, each latched with enable high and then low, and the
+ wait for the LCD unless it is skipped (FAST_MODE) up to 16MHz.
+ */
+#if (F_CPU <= 16000000) && defined(FAST_MODE)
+#define SR3W_MAX_SEND ( 4 * FIO_SHIFTOUT_TIME )
+#else
+#define SR3W_MAX_SEND ( 4 * FIO_SHIFTOUT_TIME + 37 )
+#endif
+
 
 class LiquidCrystal_SR3W : public LCD 
 {
@@ -131,6 +143,12 @@ public:
     command to the LCD.
     */
    virtual void send(uint8_t value, uint8_t mode);
+
+   /*!
+    @function
+    @abstract   Worst case time of a send. @see LCD::maxSendTime
+    */
+   virtual uint16_t maxSendTime ( void );
    
    /*!
     @function
@@ -0,0 +1,296 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LiquidCrystal_SR3W_Linux.cpp
+// This file implements a driver for LCDs connected through a latching shift
+// register (74HC595) to the SPI bus of a Linux board, through the spidev
+// interface (/dev/spidevB.C).
+//
+// @brief
+// The delay of an SPI transfer elapses after its bits and before the chip
+// select is released, that is before the byte is latched. The time the LCD
+// is busy after a write is therefore set as the delay of the next register
+// load, which doesn't reach the LCD until then.
+//
+// ---------------------------------------------------------------------------
+#include "LiquidCrystal_SR3W_Linux.h"
+
+#if defined ( __linux__ )
+
+#if (ARDUINO <  100)
+#include <WProgram.h>
+#else
+#include <Arduino.h>
+#endif
+#include <inttypes.h>
+#include <string.h>
+#include <fcntl.h>
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+
+// Default pin mapping, the same as LiquidCrystal_SR3W
+#define EN 4  // Enable bit
+#define RW 5  // Read/Write bit
+#define RS 6  // Register select bit
+#define D4 0
+#define D5 1
+#define D6 2
+#define D7 3
+
+// CONSTRUCTORS
+// ---------------------------------------------------------------------------
+LiquidCrystal_SR3W_Linux::LiquidCrystal_SR3W_Linux ( const char *device,
+                                                     const t_linuxIO &io )
+{
+   config ( device, EN, RW, RS, D4, D5, D6, D7, LCDSR3WL_SPEED, io );
+}
+
+LiquidCrystal_SR3W_Linux::LiquidCrystal_SR3W_Linux ( const char *device,
+                                                     uint8_t En, uint8_t Rw,
+                                                     uint8_t Rs, uint8_t d4,
+                                                     uint8_t d5, uint8_t d6,
+                                                     uint8_t d7,
+                                                     uint8_t backlighPin,
+                                                     t_backlighPol pol,
+                                                     uint32_t speed,
+                                                     const t_linuxIO &io )
+{
+   config ( device, En, Rw, Rs, d4, d5, d6, d7, speed, io );
+   _backlightPinMask = ( 1 << backlighPin );
+   _polarity = pol;
+   setBacklight ( BACKLIGHT_OFF );
+}
+
+LiquidCrystal_SR3W_Linux::~LiquidCrystal_SR3W_Linux ( void )
+{
+   if ( _fd >= 0 )
+   {
+      _io->close ( _fd );
+   }
+}
+
+// PUBLIC METHODS
+// ---------------------------------------------------------------------------
+
+//
+// begin
+void LiquidCrystal_SR3W_Linux::begin ( uint8_t cols, uint8_t lines, uint8_t dotsize )
+{
+   uint8_t mode = SPI_MODE_0;
+
+   if ( _fd < 0 )
+   {
+      _fd = _io->open ( _device, O_RDWR );
+      if ( ( _fd >= 0 ) &&
+           ( ( _io->ioctl ( _fd, SPI_IOC_WR_MODE, &mode ) < 0 ) ||
+             ( _io->ioctl ( _fd, SPI_IOC_WR_MAX_SPEED_HZ, &_speed ) < 0 ) ) )
+      {
+         _io->close ( _fd );
+         _fd = -1;
+      }
+   }
+   _displayfunction = LCD_4BITMODE | LCD_1LINE | LCD_5x8DOTS;
+   LCD::begin ( cols, lines, dotsize );
+}
+
+//
+// send - write either command or data
+void LiquidCrystal_SR3W_Linux::send ( uint8_t value, uint8_t mode )
+{
+   if ( mode != FOUR_BITS )
+   {
+      write4bits ( ( value >> 4 ), mode );
+   }
+   write4bits ( ( value & 0x0F ), mode );
+   _delay = LCD_EXEC_TIME;
+
+   if ( _batch == 0 )
+   {
+      transmit ( );
+   }
+}
+
+//
+// write - a string in a single message
+size_t LiquidCrystal_SR3W_Linux::write ( const uint8_t *buffer, size_t size )
+{
+   LCD_HOOK_START ( LCD_OP_BULK, size );
+   beginBatch ( );
+   for ( size_t i = 0; i < size; i++ )
+   {
+      send ( buffer[i], DATA );
+   }
+   endBatch ( );
+   LCD_HOOK_END ( LCD_OP_BULK, size );
+   return ( size );
+}
+
+//
+// beginBatch
+void LiquidCrystal_SR3W_Linux::beginBatch ( void )
+{
+   _batch++;
+}
+
+//
+// endBatch
+void LiquidCrystal_SR3W_Linux::endBatch ( void )
+{
+   if ( _batch > 0 )
+   {
+      _batch--;
+   }
+   if ( _batch == 0 )
+   {
+      transmit ( );
+   }
+}
+
+//
+// setBacklight
+void LiquidCrystal_SR3W_Linux::setBacklight ( uint8_t value )
+{
+   if ( _backlightPinMask == 0x0 )
+   {
+      return;
+   }
+
+   if ( ( ( _polarity == POSITIVE ) && ( value > 0 ) ) ||
+        ( ( _polarity == NEGATIVE ) && ( value == 0 ) ) )
+   {
+      _backlightStsMask = _backlightPinMask;
+   }
+   else
+   {
+      _backlightStsMask = 0;
+   }
+   loadSR ( _backlightStsMask );
+   if ( _batch == 0 )
+   {
+      transmit ( );
+   }
+}
+
+// PROTECTED METHODS
+// ---------------------------------------------------------------------------
+
+//
+// waitExec
+void LiquidCrystal_SR3W_Linux::waitExec ( uint16_t uSec )
+{
+   if ( uSec > _delay )
+   {
+      _delay = uSec;
+   }
+}
+
+// PRIVATE METHODS
+// ---------------------------------------------------------------------------
+
+//
+// config
+void LiquidCrystal_SR3W_Linux::config ( const char *device, uint8_t En,
+                                        uint8_t Rw, uint8_t Rs, uint8_t d4,
+                                        uint8_t d5, uint8_t d6, uint8_t d7,
+                                        uint32_t speed, const t_linuxIO &io )
+{
+   _io     = &io;
+   _device = device;
+   _fd     = -1;
+   _speed  = speed;
+
+   _backlightPinMask = 0;
+   _backlightStsMask = 0;
+   _polarity = POSITIVE;
+
+   _En = ( 1 << En );
+   _Rw = ( 1 << Rw );
+   _Rs = ( 1 << Rs );
+
+   _data_pins[0] = ( 1 << d4 );
+   _data_pins[1] = ( 1 << d5 );
+   _data_pins[2] = ( 1 << d6 );
+   _data_pins[3] = ( 1 << d7 );
+
+   _batch = 0;
+   _delay = 0;
+   _loads = 0;
+}
+
+//
+// write4bits
+void LiquidCrystal_SR3W_Linux::write4bits ( uint8_t value, uint8_t mode )
+{
+   uint8_t pinMapValue = 0;
+
+   // Map the value to LCD pin mapping
+   for ( uint8_t i = 0; i < 4; i++ )
+   {
+      if ( ( value & 0x1 ) == 1 )
+      {
+         pinMapValue |= _data_pins[i];
+      }
+      value = ( value >> 1 );
+   }
+
+   mode = ( mode == DATA ) ? _Rs : 0;
+   pinMapValue |= mode | _backlightStsMask;
+
+   // A byte on the bus is longer than the enable pulse width
+   loadSR ( pinMapValue | _En );    // Send with enable high
+   loadSR ( pinMapValue );          // Send with enable low
+}
+
+//
+// loadSR
+void LiquidCrystal_SR3W_Linux::loadSR ( uint8_t value )
+{
+   struct spi_ioc_transfer *xfer;
+
+   if ( _loads == LCDSR3WL_MAX_LOADS )
+   {
+      transmit ( );
+   }
+
+   xfer = &_xfer[_loads];
+   memset ( xfer, 0, sizeof ( *xfer ) );
+   _tx[_loads]         = value;
+   xfer->tx_buf        = (unsigned long)&_tx[_loads];
+   xfer->len           = 1;
+   xfer->speed_hz      = _speed;
+   xfer->bits_per_word = 8;
+   xfer->delay_usecs   = _delay;    // the LCD is busy until then
+   xfer->cs_change     = 1;         // latch the byte
+   _delay = 0;
+   _loads++;
+}
+
+//
+// transmit
+int LiquidCrystal_SR3W_Linux::transmit ( void )
+{
+   int status;
+
+   if ( _loads == 0 )
+   {
+      return ( 1 );
+   }
+
+   // On the last transfer cs_change would keep the device selected, the
+   // end of the message releases it anyway.
+   _xfer[_loads - 1].cs_change = 0;
+   status = ( _fd >= 0 ) &&
+            ( _io->ioctl ( _fd, SPI_IOC_MESSAGE ( _loads ), _xfer ) >= 0 );
+   _loads = 0;
+   return ( status );
+}
+
+#endif
@@ -0,0 +1,246 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file LiquidCrystal_SR3W_Linux.h
+// This file implements a driver for LCDs connected through a latching shift
+// register (74HC595) to the SPI bus of a Linux board, through the spidev
+// interface (/dev/spidevB.C).
+//
+// @brief
+// Same shift register wiring and pin mappings as LiquidCrystal_SR3W, with
+// the register data on MOSI, the register clock on SCLK and the strobe
+// (latch clock, RCLK) on the chip select of the device:
+//
+//   +--------------------------------------------+
+//   |                 Linux board                |
+//   |   CSn           MOSI          SCLK         |
+//   +----+-------------+-------------+-----------+
+//        |             |             |
+//   +----+-------------+-------------+-----------+
+//   |    Strobe        Data          Clock       |
+//   |          8-bit shift/latch register        | 74HC595N
+//   +--------------------------------------------+
+//
+// Every register load is a one byte SPI transfer with the chip select
+// released at its end, its rising edge latches the byte on the outputs. The
+// register loads of a whole string, or of a whole batch (@see
+// LCD::beginBatch), are sent in a single SPI_IOC_MESSAGE ioctl, and the
+// execution time of the LCD is encoded as the delay of the transfers, so
+// the kernel and the SPI controller handle the timing instead of the
+// application sleeping between writes.
+//
+// The chip select can be a GPIO line (cs-gpios in the device tree) when
+// the SPI controller chip selects are taken.
+//
+//   LiquidCrystal_SR3W_Linux lcd("/dev/spidev0.0");
+//
+// The system calls are made through a t_linuxIO table, the last argument
+// of the constructors, so that the driver can be run against a stand in for
+// the device node.
+//
+// Only built on Linux.
+//
+// ---------------------------------------------------------------------------
+#ifndef LiquidCrystal_SR3W_Linux_h
+#define LiquidCrystal_SR3W_Linux_h
+
+#if defined ( __linux__ )
+
+#include <inttypes.h>
+#include <Print.h>
+#include <linux/spi/spidev.h>
+
+#include "LCD.h"
+#include "LinuxIO.h"
+
+/*!
+ @defined
+ @abstract   Maximum number of register loads sent in one message.
+ @discussion Each character takes 4 register loads, the default holds the
+ whole LCD (80 characters) plus a few commands. Longer batches are sent in
+ several messages.
+ */
+#ifndef LCDSR3WL_MAX_LOADS
+#define LCDSR3WL_MAX_LOADS      352
+#endif
+
+/*!
+ @defined
+ @abstract   Default SPI clock (Hz).
+ */
+#define LCDSR3WL_SPEED          1000000
+
+class LiquidCrystal_SR3W_Linux : public LCD
+{
+public:
+   /*!
+    @method
+    @abstract   Class constructor.
+    @discussion Initializes class variables, the pin mapping is the one of
+    LiquidCrystal_SR3W(data, clk, strobe). The constructor does not
+    initialize the LCD nor opens the device.
+
+    @param      device[in] spidev device node, i.e. "/dev/spidev0.0".
+    @param      io[in] system calls to use.
+    */
+   LiquidCrystal_SR3W_Linux ( const char *device,
+                              const t_linuxIO &io = linuxSystemIO );
+
+   /*!
+    @method
+    @abstract   Class constructor.
+    @discussion Initializes class variables with the shift register outputs
+    connected to the LCD. The constructor does not initialize the LCD nor
+    opens the device.
+
+    @param      device[in] spidev device node, i.e. "/dev/spidev0.0".
+    @param      En[in] LCD En (Enable) output of the shift register
+    @param      Rw[in] LCD Rw (Read/write) output of the shift register
+    @param      Rs[in] LCD Rs (Reset) output of the shift register
+    @param      d4[in] LCD data 0 output of the shift register
+    @param      d5[in] LCD data 1 output of the shift register
+    @param      d6[in] LCD data 2 output of the shift register
+    @param      d7[in] LCD data 3 output of the shift register
+    @param      backlighPin[in] backlight output of the shift register
+    @param      pol[in] backlight polarity
+    @param      speed[in] SPI clock (Hz).
+    @param      io[in] system calls to use.
+    */
+   LiquidCrystal_SR3W_Linux ( const char *device, uint8_t En, uint8_t Rw,
+                              uint8_t Rs, uint8_t d4, uint8_t d5, uint8_t d6,
+                              uint8_t d7, uint8_t backlighPin,
+                              t_backlighPol pol,
+                              uint32_t speed = LCDSR3WL_SPEED,
+                              const t_linuxIO &io = linuxSystemIO );
+
+   /*!
+    @method
+    @abstract   Class destructor.
+    @discussion Closes the device.
+    */
+   ~LiquidCrystal_SR3W_Linux ( void );
+
+   /*!
+    @function
+    @abstract   LCD initialization.
+    @discussion Opens and configures the device (SPI mode 0) and initializes
+    the LCD to a given size (col, row).
+
+    @param      cols[in] the number of columns that the display has
+    @param      rows[in] the number of rows that the display has
+    @param      charsize[in] size of the characters of the LCD: LCD_5x8DOTS or
+    LCD_5x10DOTS.
+    */
+   virtual void begin ( uint8_t cols, uint8_t rows, uint8_t charsize = LCD_5x8DOTS );
+
+   /*!
+    @function
+    @abstract   Send a particular value to the LCD.
+    @discussion Sends a particular value to the LCD for writing to the LCD or
+    as an LCD command. Within a batch the register loads are queued.
+
+    Users should never call this method.
+
+    @param      value[in] Value to send to the LCD.
+    @param      mode[in] DATA - write to the LCD CGRAM, COMMAND - write a
+    command to the LCD.
+    */
+   virtual void send ( uint8_t value, uint8_t mode );
+
+   /*!
+    @function
+    @abstract   Writes a string of characters to the LCD.
+    @discussion The whole string is sent in a single SPI message.
+
+    @param      buffer[in] characters to write to the LCD.
+    @param      size[in] number of characters to write.
+    */
+   virtual size_t write ( const uint8_t *buffer, size_t size );
+   using LCD::write;
+
+   /*!
+    @function
+    @abstract   Starts a batch of transfers. @see LCD::beginBatch
+    */
+   virtual void beginBatch ( void );
+
+   /*!
+    @function
+    @abstract   Ends a batch of transfers, sending the queued register loads
+    in a single SPI message. @see LCD::beginBatch
+    */
+   virtual void endBatch ( void );
+
+   /*!
+    @function
+    @abstract   Switch-on/off the LCD backlight.
+
+    @param      value: backlight mode (HIGH|LOW)
+    */
+   void setBacklight ( uint8_t value );
+
+protected:
+   /*!
+    @function
+    @abstract   Waits for the LCD to execute a command.
+    @discussion Doesn't wait, the time is added as the delay of the next
+    register load.
+    */
+   virtual void waitExec ( uint16_t uSec );
+
+private:
+   /*!
+    @function
+    @abstract   Initialises class private variables.
+    */
+   void config ( const char *device, uint8_t En, uint8_t Rw, uint8_t Rs,
+                 uint8_t d4, uint8_t d5, uint8_t d6, uint8_t d7,
+                 uint32_t speed, const t_linuxIO &io );
+
+   /*!
+    @function
+    @abstract   Queues the register loads of a nibble.
+    */
+   void write4bits ( uint8_t value, uint8_t mode );
+
+   /*!
+    @function
+    @abstract   Queues a register load.
+    @discussion The byte is latched once the delay pending has elapsed.
+    */
+   void loadSR ( uint8_t value );
+
+   /*!
+    @function
+    @abstract   Sends the queued register loads in one SPI message.
+    @result     1 on success, 0 otherwise.
+    */
+   int transmit ( void );
+
+   const t_linuxIO        *_io;                         // System calls
+   const char             *_device;                     // Device node
+   int                     _fd;                         // Open device, -1 if not
+   uint32_t                _speed;                      // SPI clock
+   uint8_t                 _backlightPinMask;           // Backlight IO pin mask
+   uint8_t                 _backlightStsMask;           // Backlight status mask
+   uint8_t                 _En;                         // LCD expander word for enable pin
+   uint8_t                 _Rw;                         // LCD expander word for R/W pin
+   uint8_t                 _Rs;                         // LCD expander word for Register Select pin
+   uint8_t                 _data_pins[4];               // LCD data lines
+   uint8_t                 _batch;                      // Batch nesting level
+   uint16_t                _delay;                      // LCD busy before the next load (us)
+   uint16_t                _loads;                      // Register loads queued
+   uint8_t                 _tx[LCDSR3WL_MAX_LOADS];     // Queued register values
+   struct spi_ioc_transfer _xfer[LCDSR3WL_MAX_LOADS];   // Queued transfers
+};
+
+#endif
+
+#endif
@@ -0,0 +1,38 @@
+/*
+ * Turns the board into an intelligent I2C LCD backpack at address 0x30,
+ * driving an LCD shield with the binary display frames sent by the master
+ * (see LCDBackpack.h).
+ *
+ * On the master:
+ *
+ *   LCDEncoder encoder(20, 4);
+ *   uint8_t    frames[LCDP_MAX_ENCODED];
+ *
+ *   length = encoder.encode ( screen, frames, sizeof ( frames ) );
+ *   for ( i = 0; i < length; i += n )
+ *   {
+ *      n = min ( length - i, BUFFER_LENGTH );
+ *      // Wire.requestFrom(0x30, 2): wait for room >= n, invalidate the
+ *      // encoder if the error count changed
+ *      Wire.beginTransmission ( 0x30 );
+ *      Wire.write ( &frames[i], n );
+ *      Wire.endTransmission ( );
+ *   }
+ */
+#include <Wire.h> 
+#include <LiquidCrystal.h>
+#include <LCDBackpack.h>
+
+LiquidCrystal lcd(8, 9, 4, 5, 6, 7); // LCD Shield
+LCDBackpack backpack(lcd, 20, 4);
+
+void setup()
+{
+  backpack.begin(0x30);
+}
+
+void loop()
+{
+  // apply the frames received, the master isn't kept waiting meanwhile
+  backpack.update();
+}
@@ -0,0 +1,99 @@
+/*
+ * Checks the bytes a driver puts on its bus for a fixed set of scenarios
+ * (scenarios.h) against golden values (see LCDBusTrace.h). Each scenario
+ * reports the number of bytes, their CRC and the time taken on the board,
+ * and prints a FAIL line if the bytes differ from the golden ones.
+ *
+ * golden.h holds one table per driver, recorded with the constructors
+ * below. Its times are those of the host test, on a simulated clock where
+ * only the waits of the driver and the I2C bus take time: the host test
+ * fails a scenario that gets any slower. On a board the pin writes add to
+ * them, the time is printed to compare.
+ *
+ * Uncomment LCD_BUS_TRACE in LCDBusTrace.h and select the driver with
+ * BUS_DRIVER below. The host test (make -C test) checks all the drivers.
+ */
+#include <Wire.h> 
+#include <LCDBusTrace.h>
+#include <LiquidCrystal.h>
+#include <LiquidCrystal_I2C.h>
+#include <LiquidCrystal_IIC.h>
+#include <LiquidCrystal_I2C_ByVac.h>
+#include <LiquidCrystal_SR.h>
+#include <LiquidCrystal_SR1W.h>
+#include <LiquidCrystal_SR2W.h>
+#include <LiquidCrystal_SR3W.h>
+
+#include "scenarios.h"
+#include "golden.h"
+
+#define LCD_COLS 16
+#define LCD_ROWS 2
+
+// The driver checked, one of the BUS_ values of golden.h
+#define BUS_DRIVER BUS_I2C
+
+#if BUS_DRIVER == BUS_LIQUIDCRYSTAL
+LiquidCrystal lcd(8, 9, 4, 5, 6, 7, 10, POSITIVE);
+#elif BUS_DRIVER == BUS_I2C
+LiquidCrystal_I2C lcd(0x27, 2, 1, 0, 4, 5, 6, 7, 3, POSITIVE);
+#elif BUS_DRIVER == BUS_IIC
+LiquidCrystal_IIC lcd(0x38, IIC_BOARD_EXTRAIO);
+#elif BUS_DRIVER == BUS_I2C_BYVAC
+LiquidCrystal_I2C_ByVac lcd(0x21);
+#elif BUS_DRIVER == BUS_SR
+LiquidCrystal_SR lcd(2, 3, 4);
+#elif BUS_DRIVER == BUS_SR1W
+LiquidCrystal_SR1W lcd(2, SW_CLEAR);
+#elif BUS_DRIVER == BUS_SR2W
+LiquidCrystal_SR2W lcd(2, 3);
+#elif BUS_DRIVER == BUS_SR3W
+LiquidCrystal_SR3W lcd(2, 3, 4);
+#endif
+
+void setup()
+{
+  const golden *expect;
+  unsigned long us;
+  uint8_t failed = 0;
+  
+  Serial.begin(57600);
+  
+  for (uint8_t i = 0; i < SCENARIOS; i++)
+  {
+    expect = &expected[BUS_DRIVER][i];
+    
+    LCDBusTrace::start();
+    us = micros();
+    scenario(lcd, i, LCD_COLS, LCD_ROWS);
+    us = micros() - us;
+    
+    Serial.print("  { ");
+    Serial.print(LCDBusTrace::count());
+    Serial.print(", 0x");
+    Serial.print(LCDBusTrace::crc(), HEX);
+    Serial.print(", ");
+    Serial.print(us);
+    Serial.print(" },  // ");
+    Serial.print(names[i]);
+    Serial.print(", host ");
+    Serial.print(expect->us);
+    Serial.println(" us");
+    
+    if ((LCDBusTrace::count() != expect->bytes) ||
+        (LCDBusTrace::crc() != expect->crc))
+    {
+      Serial.print("FAIL ");
+      Serial.print(names[i]);
+      Serial.println(": protocol");
+      LCDBusTrace::dump(Serial);
+      failed++;
+    }
+  }
+  Serial.print(failed);
+  Serial.println(" scenarios failed");
+}
+
+void loop()
+{
+}
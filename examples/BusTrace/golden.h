@@ -0,0 +1,121 @@
+/*
+ * Golden bus traces of the BusTrace scenarios (scenarios.h) on a 16x2 LCD,
+ * one table per driver, built with the constructor written above the table.
+ * For each scenario: the number of bytes put on the bus, their CRC-16 and
+ * the time taken in us.
+ *
+ * The time is the time the driver takes on the simulated clock of the host
+ * test: its waits for the LCD and, for I2C, the bus at 100kHz. It is the
+ * same on every run; on a board the time of the other buses adds to it.
+ *
+ * The host test (make -C test) checks every driver against these values.
+ * After a change of protocol checked on the hardware, record them again
+ * with test/build/test_bustrace -r.
+ */
+#ifndef golden_h
+#define golden_h
+
+#include "scenarios.h"
+
+#define BUS_LIQUIDCRYSTAL  0
+#define BUS_I2C            1
+#define BUS_IIC            2
+#define BUS_I2C_BYVAC      3
+#define BUS_SR             4
+#define BUS_SR1W           5
+#define BUS_SR2W           6
+#define BUS_SR3W           7
+#define BUS_DRIVERS        8
+
+struct golden
+{
+  unsigned long bytes;
+  uint16_t      crc;
+  unsigned long us;
+};
+
+const golden expected[BUS_DRIVERS][SCENARIOS] =
+{
+  // LiquidCrystal lcd(8, 9, 4, 5, 6, 7, 10, POSITIVE)
+  {
+    { 20,  0x4B91, 107318 }, // begin
+    { 102, 0x1BA9, 1326 },   // text
+    { 6,   0x58E6, 4078 },   // clear
+    { 12,  0x5191, 156 },    // cursor
+    { 219, 0xD236, 5647 },   // glyphs
+    { 18,  0x7A17, 234 },    // control
+    { 0,   0xFFFF, 0 },      // backlight
+  },
+  // LiquidCrystal_I2C lcd(0x27, 2, 1, 0, 4, 5, 6, 7, 3, POSITIVE)
+  {
+    { 25,  0x7115, 111950 }, // begin
+    { 136, 0xB38F, 25840 },  // text
+    { 8,   0xA446, 5520 },   // clear
+    { 16,  0xD81D, 3040 },   // cursor
+    { 292, 0xEC23, 58280 },  // glyphs
+    { 24,  0x4803, 4560 },   // control
+    { 2,   0x9C07, 380 },    // backlight
+  },
+  // LiquidCrystal_IIC lcd(0x38, IIC_BOARD_EXTRAIO)
+  {
+    { 24,  0xD375, 110160 }, // begin
+    { 136, 0x9FC6, 15640 },  // text
+    { 8,   0x677F, 4920 },   // clear
+    { 16,  0x91FB, 1840 },   // cursor
+    { 264, 0x4803, 33160 },  // glyphs
+    { 24,  0xE299, 2760 },   // control
+    { 0,   0xFFFF, 0 },      // backlight
+  },
+  // LiquidCrystal_I2C_ByVac lcd(0x21)
+  {
+    { 10,  0x6B71, 106410 }, // begin
+    { 68,  0xEB22, 9520 },   // text
+    { 4,   0xD637, 560 },    // clear
+    { 8,   0xA682, 1120 },   // cursor
+    { 146, 0x6115, 20440 },  // glyphs
+    { 12,  0xB59F, 1680 },   // control
+    { 4,   0x7D7F, 560 },    // backlight
+  },
+  // LiquidCrystal_SR lcd(2, 3, 4)
+  {
+    { 12,  0x0090, 107158 }, // begin
+    { 68,  0x5EAB, 646 },    // text
+    { 4,   0x5322, 4038 },   // clear
+    { 8,   0x5599, 76 },     // cursor
+    { 146, 0xDABD, 4187 },   // glyphs
+    { 12,  0xE58E, 114 },    // control
+    { 0,   0xFFFF, 0 },      // backlight
+  },
+  // LiquidCrystal_SR1W lcd(2, SW_CLEAR)
+  {
+    { 14,  0x5FD8, 107655 }, // begin
+    { 68,  0x27A0, 2465 },   // text
+    { 4,   0xDB41, 4195 },   // clear
+    { 8,   0xE075, 320 },    // cursor
+    { 146, 0xBD29, 8255 },   // glyphs
+    { 12,  0x7E5E, 520 },    // control
+    { 4,   0xA8A2, 200 },    // backlight
+  },
+  // LiquidCrystal_SR2W lcd(2, 3)
+  {
+    { 13,  0x41DC, 107103 }, // begin
+    { 68,  0x593C, 408 },    // text
+    { 4,   0x960A, 4024 },   // clear
+    { 8,   0xB037, 48 },     // cursor
+    { 146, 0x8993, 3676 },   // glyphs
+    { 12,  0xBE94, 72 },     // control
+    { 2,   0x3D4D, 2 },      // backlight
+  },
+  // LiquidCrystal_SR3W lcd(2, 3, 4)
+  {
+    { 24,  0xBB8B, 107306 }, // begin
+    { 136, 0xD2FA, 1258 },   // text
+    { 8,   0xA70B, 4074 },   // clear
+    { 16,  0x1F79, 148 },    // cursor
+    { 292, 0x06FF, 5501 },   // glyphs
+    { 24,  0x8A67, 222 },    // control
+    { 0,   0xFFFF, 0 },      // backlight
+  },
+};
+
+#endif
@@ -0,0 +1,81 @@
+/*
+ * The scenarios of the BusTrace example, shared with the host test
+ * (test/test_bustrace.cpp) that checks every driver against the golden
+ * values of golden.h. Static: each file including it has its own copy.
+ */
+#ifndef scenarios_h
+#define scenarios_h
+
+#include <LCD.h>
+
+#define SCENARIOS 7
+
+static const char *const names[SCENARIOS] =
+{
+  "begin", "text", "clear", "cursor", "glyphs", "control", "backlight"
+};
+
+static void scenario(LCD &lcd, uint8_t number, uint8_t cols, uint8_t rows)
+{
+  uint8_t glyph[8];
+
+  switch (number)
+  {
+    case 0:
+      lcd.begin(cols, rows);
+      break;
+
+    case 1:
+      // A full screen
+      for (uint8_t row = 0; row < rows; row++)
+      {
+        lcd.setCursor(0, row);
+        for (uint8_t col = 0; col < cols; col++)
+        {
+          lcd.write('A' + (row * cols + col) % 26);
+        }
+      }
+      break;
+
+    case 2:
+      lcd.clear();
+      lcd.home();
+      break;
+
+    case 3:
+      for (uint8_t row = 0; row < rows; row++)
+      {
+        lcd.setCursor(cols - 1, row);
+        lcd.setCursor(0, row);
+      }
+      break;
+
+    case 4:
+      for (uint8_t i = 0; i < 8; i++)
+      {
+        for (uint8_t line = 0; line < 8; line++)
+        {
+          glyph[line] = (i + line) & 0x1F;
+        }
+        lcd.createChar(i, glyph);
+      }
+      lcd.setCursor(0, 0);
+      break;
+
+    case 5:
+      lcd.cursor();
+      lcd.blink();
+      lcd.noBlink();
+      lcd.noCursor();
+      lcd.noDisplay();
+      lcd.display();
+      break;
+
+    case 6:
+      lcd.noBacklight();
+      lcd.backlight();
+      break;
+  }
+}
+
+#endif
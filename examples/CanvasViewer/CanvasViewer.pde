@@ -0,0 +1,57 @@
+/*
+ * Shows a 64x16 table on a 20x4 LCD and pans over it with the keys sent
+ * through the serial port: a, d, w, s move the window a column or a row,
+ * A, D, W, S a whole window. Only the characters that change on screen are
+ * sent to the LCD (see LCDViewport.h).
+ */
+#include <Wire.h> 
+#include <LiquidCrystal_I2C.h>
+#include <LCDCanvas.h>
+#include <LCDViewport.h>
+
+#define COLS 20
+#define ROWS 4
+
+LiquidCrystal_I2C lcd(0x27, 2, 1, 0, 4, 5, 6, 7, 3, POSITIVE);
+
+uint8_t     cells[64 * 16];
+LCDCanvas   canvas(cells, 64, 16);
+LCDViewport view(canvas, lcd);
+
+void setup()
+{
+  Serial.begin(57600);
+  view.begin(COLS, ROWS);
+  
+  // A table: a row number and 8 columns of values
+  for (uint8_t row = 0; row < canvas.rows(); row++)
+  {
+    canvas.setCursor(0, row);
+    canvas.print(row);
+    for (uint8_t col = 0; col < 8; col++)
+    {
+      canvas.setCursor(4 + col * 7, row);
+      canvas.print(analogRead(col % 6));
+    }
+  }
+  view.update();
+}
+
+void loop()
+{
+  if (Serial.available())
+  {
+    switch (Serial.read())
+    {
+      case 'a': view.scroll(-1, 0); break;
+      case 'd': view.scroll(1, 0); break;
+      case 'w': view.scroll(0, -1); break;
+      case 's': view.scroll(0, 1); break;
+      case 'A': view.scroll(-COLS, 0); break;
+      case 'D': view.scroll(COLS, 0); break;
+      case 'W': view.scroll(0, -ROWS); break;
+      case 'S': view.scroll(0, ROWS); break;
+    }
+    view.update();
+  }
+}
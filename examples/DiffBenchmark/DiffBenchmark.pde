@@ -0,0 +1,107 @@
+/*
+ * Times the search of the changes between two screens, byte by byte and
+ * with lcd_diffFirst and lcd_diffLast (see LCDDiff.h), on a single 20x4
+ * LCD, on 16 of them driven by the same board and on a 64x16 canvas. Only
+ * the last character differs: the whole screen is searched.
+ *
+ * On 8 bit boards both compare a byte at a time and take about the same
+ * time, on 32 bit boards lcd_diffFirst compares 4 bytes at a time. The same
+ * loop built on a host with SSE2 compares 16 bytes at a time, make bench in
+ * the test directory times it there.
+ */
+#include <LCDDiff.h>
+
+#define SCREENS 3
+#define RUNS    100
+
+const uint16_t sizes[SCREENS] = { 20 * 4, 16 * 20 * 4, 64 * 16 };
+
+const char *names[SCREENS] =
+{
+  "1 LCD 20x4", "16 LCD 20x4", "canvas 64x16"
+};
+
+uint8_t screen[16 * 20 * 4];
+uint8_t shown[16 * 20 * 4];
+
+// The byte by byte search lcd_diffFirst is compared against
+size_t byteFirst(const uint8_t *a, const uint8_t *b, size_t size)
+{
+  size_t i = 0;
+
+  while ((i < size) && (a[i] == b[i]))
+  {
+    i++;
+  }
+  return i;
+}
+
+void report(const char *what, unsigned long us, size_t found)
+{
+  Serial.print("  ");
+  Serial.print(what);
+  Serial.print(" ");
+  Serial.print(us / RUNS);
+  Serial.print(" us, found ");
+  Serial.println((unsigned long)found);
+}
+
+void setup()
+{
+  unsigned long start;
+  unsigned long bytes;
+  unsigned long words;
+  unsigned long last;
+  size_t found = 0;
+
+  Serial.begin(57600);
+
+  for (uint8_t i = 0; i < SCREENS; i++)
+  {
+    memset(screen, ' ', sizes[i]);
+    memset(shown, ' ', sizes[i]);
+    screen[sizes[i] - 1] = '*';
+
+    Serial.print(names[i]);
+    Serial.print(", ");
+    Serial.print(sizes[i]);
+    Serial.println(" characters");
+
+    start = micros();
+    for (uint8_t run = 0; run < RUNS; run++)
+    {
+      found = byteFirst(screen, shown, sizes[i]);
+    }
+    bytes = micros() - start;
+    report("byte loop", bytes, found);
+
+    start = micros();
+    for (uint8_t run = 0; run < RUNS; run++)
+    {
+      found = lcd_diffFirst(screen, shown, sizes[i]);
+    }
+    words = micros() - start;
+    report("lcd_diffFirst", words, found);
+
+    // From the end the difference is found straight away
+    screen[sizes[i] - 1] = ' ';
+    screen[0] = '*';
+    start = micros();
+    for (uint8_t run = 0; run < RUNS; run++)
+    {
+      found = lcd_diffLast(screen, shown, sizes[i]);
+    }
+    last = micros() - start;
+    report("lcd_diffLast", last, found);
+
+    if (words != 0)
+    {
+      Serial.print("  speedup x");
+      Serial.println((float)bytes / words);
+    }
+  }
+}
+
+void loop()
+{
+}
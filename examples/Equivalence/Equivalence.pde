@@ -0,0 +1,53 @@
+/*
+ * Checks that LiquidCrystal_Buffer leaves the LCD as plain writes do, making
+ * runs of random LCD calls on both and comparing two simulated LCDs (see
+ * LCDEquivalence.h). No LCD needs to be connected, the results and the bus
+ * time saved are sent to the serial port.
+ *
+ * To check another optimised path, make it write to the target simulator.
+ */
+#include <Wire.h> 
+#include <LCDSimulator.h>
+#include <LCDEquivalence.h>
+#include <LiquidCrystal_Buffer.h>
+
+LCDSimulator         target;
+LCDSimulator         reference;
+LiquidCrystal_Buffer buffer(target);
+
+void flushBuffer()
+{
+  buffer.flush();
+}
+
+LCDEquivalence check(buffer, target, reference, flushBuffer);
+
+void setup()
+{
+  uint8_t failed = 0;
+  
+  Serial.begin(57600);
+  
+  check.begin(20, 4);
+  for (uint32_t seed = 1; seed <= 20; seed++)
+  {
+    if (!check.run(500, seed))
+    {
+      Serial.print("Seed ");
+      Serial.print(seed);
+      Serial.print(": differ after call ");
+      Serial.println(check.failedStep());
+      target.dump(Serial);
+      reference.dump(Serial);
+      failed++;
+      check.begin(20, 4);
+    }
+  }
+  Serial.print(failed);
+  Serial.println(" runs failed");
+  check.report(Serial);
+}
+
+void loop()
+{
+}
@@ -0,0 +1,35 @@
+/*
+ * Records the session of a small application (a counter with a custom
+ * character) to the serial port while it is shown on the LCD (see
+ * LCDRecorder.h). Capture the serial output to a file and replay it on
+ * any driver with LCDReplay.
+ */
+#include <Wire.h> 
+#include <LiquidCrystal_I2C.h>
+#include <LCDRecorder.h>
+
+LiquidCrystal_I2C lcd(0x38);  // set the LCD address to 0x38
+LCDRecorder recorder(lcd, Serial);
+
+uint8_t bell[8]  = {0x4,0xe,0xe,0xe,0x1f,0x0,0x4};
+unsigned int count = 0;
+
+void setup()
+{
+  Serial.begin(115200);
+  
+  // from here on the application uses the recorder as its LCD
+  recorder.begin(16,2);
+  recorder.createChar(0, bell);
+  recorder.clear();
+  recorder.print("Count:");
+}
+
+void loop()
+{
+  recorder.setCursor(7, 0);
+  recorder.print(count++);
+  recorder.setCursor(0, 1);
+  recorder.write((uint8_t)0);
+  delay(250);
+}
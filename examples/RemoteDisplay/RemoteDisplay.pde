@@ -0,0 +1,34 @@
+/*
+ * Displays the screens sent over the serial port (e.g. an RS-485 link) as
+ * binary delta frames (see LCDProtocol.h). The sender keeps an LCDEncoder
+ * and sends only what changes between screens, a couple of digits of a
+ * reading take 6 to 8 bytes instead of the whole screen.
+ */
+#include <Wire.h> 
+#include <LiquidCrystal_I2C.h>
+#include <LCDDecoder.h>
+
+#define BACKLIGHT_PIN     13
+
+LiquidCrystal_I2C lcd(0x38);  // set the LCD address to 0x38
+LCDDecoder decoder(lcd, 20, 4);
+
+void setup()
+{
+  pinMode ( BACKLIGHT_PIN, OUTPUT );
+  lcd.begin (20,4); 
+  digitalWrite ( BACKLIGHT_PIN, HIGH );
+  
+  Serial.begin(9600);
+}
+
+void loop()
+{
+  // frames are applied as soon as they are complete and correct, a
+  // corrupted frame is dropped and the sender resends the whole screen
+  // when it sees fit (LCDEncoder::invalidate)
+  while (Serial.available() > 0) 
+  {
+    decoder.feed(Serial.read());
+  }
+}
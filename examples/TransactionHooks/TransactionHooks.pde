@@ -0,0 +1,56 @@
+/*
+ * Shows the LCD traffic on spare pins for a logic analyser: the bus pin is
+ * HIGH during each command, character or bulk transfer, the wait pin while
+ * waiting for the LCD to power up or to execute a command. The time spent on each kind of
+ * operation is also added up and sent to the serial port.
+ *
+ * Uncomment LCD_HOOKS in LCD.h to compile the calls to the hooks in.
+ */
+#include <Wire.h> 
+#include <LiquidCrystal_I2C.h>
+
+#define BUS_PIN  12
+#define WAIT_PIN 13
+
+LiquidCrystal_I2C lcd(0x27, 2, 1, 0, 4, 5, 6, 7, 3, POSITIVE);
+
+unsigned long started;
+unsigned long spent[5];   // per LCD_OP_xxx
+
+void transactionStart(uint8_t kind, uint16_t size)
+{
+  digitalWrite((kind >= LCD_OP_WAIT) ? WAIT_PIN : BUS_PIN, HIGH);
+  started = micros();
+}
+
+void transactionEnd(uint8_t kind, uint16_t size)
+{
+  spent[kind] += micros() - started;
+  digitalWrite((kind >= LCD_OP_WAIT) ? WAIT_PIN : BUS_PIN, LOW);
+}
+
+void setup()
+{
+  pinMode(BUS_PIN, OUTPUT);
+  pinMode(WAIT_PIN, OUTPUT);
+  Serial.begin(57600);
+  
+  lcd.setHooks(transactionStart, transactionEnd);
+  lcd.begin(16, 2);
+}
+
+void loop()
+{
+  lcd.clear();
+  lcd.print("Uptime ");
+  lcd.print(millis() / 1000);
+  
+  Serial.print("Commands ");
+  Serial.print(spent[LCD_OP_COMMAND]);
+  Serial.print(" us, data ");
+  Serial.print(spent[LCD_OP_DATA] + spent[LCD_OP_BULK]);
+  Serial.print(" us, waits ");
+  Serial.print(spent[LCD_OP_WAIT]);
+  Serial.println(" us");
+  delay(1000);
+}
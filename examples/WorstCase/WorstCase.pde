@@ -0,0 +1,121 @@
+/*
+ * Prints the worst case time each LCD call can block for every driver and
+ * checks it against the time measured on a simulated LCD (see LCD.h,
+ * LCD_WCET_WRITE and LCDSimulator.h). No LCD needs to be connected.
+ *
+ * The simulator is given the worst case send time of each driver and each
+ * call is made in its worst case (createChar in right to left mode). The
+ * bus time is what the simulator adds up: its sends and the waits for the
+ * LCD. The delays begin makes to power up and initialise the LCD are
+ * measured with micros().
+ *
+ * At run time, lcd.maxBlocking(LCD_CALL_CLEAR) gives the same figures for
+ * the driver of an LCD.
+ */
+#include <Wire.h> 
+#include <LCDSimulator.h>
+#include <LiquidCrystal.h>
+#include <LiquidCrystal_I2C.h>
+#include <LiquidCrystal_IIC.h>
+#include <LiquidCrystal_I2C_ByVac.h>
+#include <LiquidCrystal_SI2C.h>
+#include <LiquidCrystal_SR.h>
+#include <LiquidCrystal_SR1W.h>
+#include <LiquidCrystal_SR2W.h>
+#include <LiquidCrystal_SR3W.h>
+
+#define DRIVERS 9
+#define CALLS   5
+
+const char *drivers[DRIVERS] =
+{
+  "LiquidCrystal", "I2C", "IIC", "I2C_ByVac", "SI2C", "SR", "SR1W", "SR2W", "SR3W"
+};
+
+const uint16_t sendTimes[DRIVERS] =
+{
+  LC_MAX_SEND, LCI2C_MAX_SEND, IIC_MAX_SEND, BYVAC_MAX_SEND, SI2C_MAX_SEND,
+  SR_MAX_SEND, SR1W_MAX_SEND, SR2W_MAX_SEND, SR3W_MAX_SEND
+};
+
+const char *calls[CALLS] =
+{
+  "write", "setCursor", "clear", "createChar", "begin"
+};
+
+unsigned long measure(LCDSimulator &lcd, uint8_t call)
+{
+  uint8_t glyph[8] = { 0x1F, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x1F };
+  unsigned long us = 0;
+  
+  lcd.begin(20, 4);
+  if (call == LCD_CALL_CREATE_CHAR)
+  {
+    lcd.rightToLeft();
+  }
+  lcd.resetCounters();
+  
+  switch (call)
+  {
+    case LCD_CALL_WRITE:
+      lcd.write('A');
+      break;
+    case LCD_CALL_SET_CURSOR:
+      lcd.setCursor(19, 3);
+      break;
+    case LCD_CALL_CLEAR:
+      lcd.clear();
+      break;
+    case LCD_CALL_CREATE_CHAR:
+      lcd.createChar(7, glyph);
+      break;
+    case LCD_CALL_BEGIN:
+      us = micros();
+      lcd.begin(20, 4);
+      us = micros() - us;
+      break;
+  }
+  return (lcd.busTime() + us);
+}
+
+void setup()
+{
+  unsigned long measured;
+  unsigned long bound;
+  uint8_t failed = 0;
+  
+  Serial.begin(57600);
+  
+  for (uint8_t i = 0; i < DRIVERS; i++)
+  {
+    LCDSimulator lcd(sendTimes[i]);
+    
+    Serial.print(drivers[i]);
+    Serial.print(": send ");
+    Serial.print(sendTimes[i]);
+    Serial.println(" us");
+    for (uint8_t call = 0; call < CALLS; call++)
+    {
+      measured = measure(lcd, call);
+      bound    = lcd.maxBlocking(call);
+      Serial.print("  ");
+      Serial.print(calls[call]);
+      Serial.print(" ");
+      Serial.print(bound);
+      Serial.print(" us, simulated ");
+      Serial.print(measured);
+      Serial.println(" us");
+      if (measured > bound)
+      {
+        Serial.println("  EXCEEDED");
+        failed++;
+      }
+    }
+  }
+  Serial.print(failed);
+  Serial.println(" bounds exceeded");
+}
+
+void loop()
+{
+}
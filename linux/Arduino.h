@@ -0,0 +1,80 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: Yes
+// Extendable: Yes
+//
+// @file Arduino.h
+// This file defines the part of the Arduino core the library uses, to build
+// it on Linux hosts.
+//
+// @brief
+// With this directory on the include path and ARDUINO defined the way the
+// Arduino IDE defines it (-DARDUINO=105), the library builds on Linux:
+// the integer types and constants, Print, timing (delay,
+// delayMicroseconds, millis, micros) and flash access, which is plain
+// memory access on Linux.
+//
+// Print.cpp and wiring.cpp implement it, the Makefile builds them with the
+// library for Linux boards. The pin functions are only declared: Linux
+// boards drive the LCD through the _Linux drivers, and the host tests
+// provide the pins in memory and their own simulated time.
+//
+// ---------------------------------------------------------------------------
+#ifndef Arduino_h
+#define Arduino_h
+
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Print.h"
+
+typedef uint8_t byte;
+typedef bool    boolean;
+
+#define HIGH            0x1
+#define LOW             0x0
+
+#define INPUT           0x0
+#define OUTPUT          0x1
+#define INPUT_PULLUP    0x2
+
+#define LSBFIRST        0
+#define MSBFIRST        1
+
+#define NOT_ON_TIMER    0
+#define digitalPinToTimer(pin)      NOT_ON_TIMER
+
+#define _BV(bit)        ( 1 << ( bit ) )
+
+// Flash is plain memory
+#define PROGMEM
+#define PGM_P                       const char *
+#define pgm_read_byte(addr)         ( *(const uint8_t *)( addr ) )
+#define pgm_read_byte_near(addr)    pgm_read_byte ( addr )
+#define pgm_read_word(addr)         ( *(const uint16_t *)( addr ) )
+#define memcpy_P                    memcpy
+#define strlen_P                    strlen
+#define F(str)                      ( (const __FlashStringHelper *)( str ) )
+
+// There are no interrupts to mask in userspace
+#define interrupts()
+#define noInterrupts()
+
+void pinMode ( uint8_t pin, uint8_t mode );
+void digitalWrite ( uint8_t pin, uint8_t value );
+int  digitalRead ( uint8_t pin );
+void analogWrite ( uint8_t pin, int value );
+
+void          delay ( unsigned long ms );
+void          delayMicroseconds ( unsigned int us );
+unsigned long millis ( void );
+unsigned long micros ( void );
+
+#endif
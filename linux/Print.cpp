@@ -0,0 +1,247 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file Print.cpp
+// This file implements the Print class of the Arduino core for Linux hosts.
+//
+// @brief
+// Numbers are printed as the Arduino core does: negative numbers in
+// decimal only, other bases print the two's complement.
+//
+// ---------------------------------------------------------------------------
+#include <inttypes.h>
+#include <string.h>
+
+#include "Print.h"
+
+// PUBLIC METHODS
+// ---------------------------------------------------------------------------
+
+//
+// write
+size_t Print::write ( const uint8_t *buffer, size_t size )
+{
+   size_t n = 0;
+
+   while ( size-- )
+   {
+      n += write ( *buffer++ );
+   }
+   return ( n );
+}
+
+size_t Print::write ( const char *str )
+{
+   if ( str == NULL )
+   {
+      return ( 0 );
+   }
+   return ( write ( (const uint8_t *)str, strlen ( str ) ) );
+}
+
+size_t Print::write ( const char *buffer, size_t size )
+{
+   return ( write ( (const uint8_t *)buffer, size ) );
+}
+
+//
+// print
+size_t Print::print ( const __FlashStringHelper *str )
+{
+   return ( write ( (const char *)str ) );
+}
+
+size_t Print::print ( const char str[] )
+{
+   return ( write ( str ) );
+}
+
+size_t Print::print ( char value )
+{
+   return ( write ( (uint8_t)value ) );
+}
+
+size_t Print::print ( unsigned char value, int base )
+{
+   return ( print ( (unsigned long)value, base ) );
+}
+
+size_t Print::print ( int value, int base )
+{
+   return ( print ( (long)value, base ) );
+}
+
+size_t Print::print ( unsigned int value, int base )
+{
+   return ( print ( (unsigned long)value, base ) );
+}
+
+size_t Print::print ( long value, int base )
+{
+   size_t n = 0;
+
+   if ( base == 0 )
+   {
+      return ( write ( (uint8_t)value ) );
+   }
+   if ( ( base == DEC ) && ( value < 0 ) )
+   {
+      n = write ( '-' );
+      return ( n + printNumber ( -(unsigned long)value, DEC ) );
+   }
+   return ( printNumber ( (unsigned long)value, base ) );
+}
+
+size_t Print::print ( unsigned long value, int base )
+{
+   if ( base == 0 )
+   {
+      return ( write ( (uint8_t)value ) );
+   }
+   return ( printNumber ( value, base ) );
+}
+
+size_t Print::print ( double value, int digits )
+{
+   return ( printFloat ( value, digits ) );
+}
+
+//
+// println
+size_t Print::println ( const __FlashStringHelper *str )
+{
+   size_t n = print ( str );
+   return ( n + println ( ) );
+}
+
+size_t Print::println ( const char str[] )
+{
+   size_t n = print ( str );
+   return ( n + println ( ) );
+}
+
+size_t Print::println ( char value )
+{
+   size_t n = print ( value );
+   return ( n + println ( ) );
+}
+
+size_t Print::println ( unsigned char value, int base )
+{
+   size_t n = print ( value, base );
+   return ( n + println ( ) );
+}
+
+size_t Print::println ( int value, int base )
+{
+   size_t n = print ( value, base );
+   return ( n + println ( ) );
+}
+
+size_t Print::println ( unsigned int value, int base )
+{
+   size_t n = print ( value, base );
+   return ( n + println ( ) );
+}
+
+size_t Print::println ( long value, int base )
+{
+   size_t n = print ( value, base );
+   return ( n + println ( ) );
+}
+
+size_t Print::println ( unsigned long value, int base )
+{
+   size_t n = print ( value, base );
+   return ( n + println ( ) );
+}
+
+size_t Print::println ( double value, int digits )
+{
+   size_t n = print ( value, digits );
+   return ( n + println ( ) );
+}
+
+size_t Print::println ( void )
+{
+   return ( write ( "\r\n" ) );
+}
+
+// PRIVATE METHODS
+// ---------------------------------------------------------------------------
+
+//
+// printNumber
+size_t Print::printNumber ( unsigned long value, uint8_t base )
+{
+   char    buffer[8 * sizeof ( long ) + 1];
+   uint8_t len = 0;
+
+   if ( base < 2 )
+   {
+      base = 10;
+   }
+
+   // Digits from right to left
+   do
+   {
+      uint8_t digit = value % base;
+
+      buffer[sizeof ( buffer ) - 1 - len++] = ( digit < 10 ) ? '0' + digit :
+                                                              'A' + digit - 10;
+      value /= base;
+   } while ( value != 0 );
+
+   return ( write ( (const uint8_t *)&buffer[sizeof ( buffer ) - len], len ) );
+}
+
+//
+// printFloat
+size_t Print::printFloat ( double value, uint8_t digits )
+{
+   size_t        n = 0;
+   double        rounding = 0.5;
+   unsigned long integer;
+
+   if ( value != value )
+   {
+      return ( write ( "nan" ) );
+   }
+   if ( ( value > 4294967040.0 ) || ( value < -4294967040.0 ) )
+   {
+      return ( write ( "ovf" ) );
+   }
+   if ( value < 0.0 )
+   {
+      n += write ( '-' );
+      value = -value;
+   }
+
+   for ( uint8_t i = 0; i < digits; i++ )
+   {
+      rounding /= 10.0;
+   }
+   value  += rounding;
+   integer = (unsigned long)value;
+   value  -= (double)integer;
+   n += printNumber ( integer, DEC );
+
+   if ( digits > 0 )
+   {
+      n += write ( '.' );
+   }
+   while ( digits-- > 0 )
+   {
+      value *= 10.0;
+      n     += write ( (uint8_t)( '0' + (uint8_t)value ) );
+      value -= (uint8_t)value;
+   }
+   return ( n );
+}
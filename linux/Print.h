@@ -0,0 +1,91 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file Print.h
+// This file implements the Print class of the Arduino core for Linux hosts.
+//
+// @brief
+// Same interface as the Print class of the Arduino 1.0 core: classes
+// implement write ( uint8_t ) and get the text and number printing methods.
+// Strings marked with F() are plain strings on Linux.
+//
+// ---------------------------------------------------------------------------
+#ifndef Print_h
+#define Print_h
+
+#include <inttypes.h>
+#include <stddef.h>
+#include <string.h>
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+class __FlashStringHelper;
+
+class Print
+{
+public:
+   /*!
+    @function
+    @abstract   Writes a character.
+    @result     number of characters written.
+    */
+   virtual size_t write ( uint8_t value ) = 0;
+
+   /*!
+    @function
+    @abstract   Writes a number of characters.
+    @discussion Writes one character at a time, classes override it when
+    they can do better.
+    @result     number of characters written.
+    */
+   virtual size_t write ( const uint8_t *buffer, size_t size );
+
+   size_t write ( const char *str );
+   size_t write ( const char *buffer, size_t size );
+
+   size_t print ( const __FlashStringHelper *str );
+   size_t print ( const char str[] );
+   size_t print ( char value );
+   size_t print ( unsigned char value, int base = DEC );
+   size_t print ( int value, int base = DEC );
+   size_t print ( unsigned int value, int base = DEC );
+   size_t print ( long value, int base = DEC );
+   size_t print ( unsigned long value, int base = DEC );
+   size_t print ( double value, int digits = 2 );
+
+   size_t println ( const __FlashStringHelper *str );
+   size_t println ( const char str[] );
+   size_t println ( char value );
+   size_t println ( unsigned char value, int base = DEC );
+   size_t println ( int value, int base = DEC );
+   size_t println ( unsigned int value, int base = DEC );
+   size_t println ( long value, int base = DEC );
+   size_t println ( unsigned long value, int base = DEC );
+   size_t println ( double value, int digits = 2 );
+   size_t println ( void );
+
+private:
+   /*!
+    @function
+    @abstract   Prints a number in a given base.
+    */
+   size_t printNumber ( unsigned long value, uint8_t base );
+
+   /*!
+    @function
+    @abstract   Prints a number with a given number of decimals.
+    */
+   size_t printFloat ( double value, uint8_t digits );
+};
+
+#endif
@@ -0,0 +1,98 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: Yes
+// Extendable: Yes
+//
+// @file wiring.cpp
+// This file implements the timing functions of the Arduino core for Linux
+// hosts.
+//
+// @brief
+// millis and micros count from the first call on the monotonic clock, they
+// wrap as on the Arduino. Delays sleep on the same clock to an absolute
+// deadline, a signal doesn't cut them short. Userspace wakes up late by
+// tens of microseconds: delays are minimums, as the LCD needs.
+//
+// ---------------------------------------------------------------------------
+#include <time.h>
+#include <errno.h>
+
+#include <Arduino.h>
+
+// CLASS VARIABLES
+// ---------------------------------------------------------------------------
+static struct timespec start;              // Time of the first call
+
+// PRIVATE FUNCTIONS
+// ---------------------------------------------------------------------------
+
+//
+// elapsed - microseconds since the first call
+static unsigned long long elapsed ( void )
+{
+   struct timespec now;
+
+   clock_gettime ( CLOCK_MONOTONIC, &now );
+   if ( ( start.tv_sec == 0 ) && ( start.tv_nsec == 0 ) )
+   {
+      start = now;
+   }
+   return ( (unsigned long long)( now.tv_sec - start.tv_sec ) * 1000000ULL +
+            ( now.tv_nsec - start.tv_nsec ) / 1000 );
+}
+
+//
+// sleepFor - sleep to an absolute deadline
+static void sleepFor ( unsigned long long us )
+{
+   struct timespec deadline;
+
+   clock_gettime ( CLOCK_MONOTONIC, &deadline );
+   deadline.tv_sec  += us / 1000000ULL;
+   deadline.tv_nsec += ( us % 1000000ULL ) * 1000;
+   if ( deadline.tv_nsec >= 1000000000L )
+   {
+      deadline.tv_sec++;
+      deadline.tv_nsec -= 1000000000L;
+   }
+   while ( clock_nanosleep ( CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline,
+                             NULL ) == EINTR )
+   {
+   }
+}
+
+// PUBLIC FUNCTIONS
+// ---------------------------------------------------------------------------
+
+//
+// delay
+void delay ( unsigned long ms )
+{
+   sleepFor ( (unsigned long long)ms * 1000ULL );
+}
+
+//
+// delayMicroseconds
+void delayMicroseconds ( unsigned int us )
+{
+   sleepFor ( us );
+}
+
+//
+// millis
+unsigned long millis ( void )
+{
+   return ( (unsigned long)( elapsed ( ) / 1000ULL ) );
+}
+
+//
+// micros
+unsigned long micros ( void )
+{
+   return ( (unsigned long)elapsed ( ) );
+}
@@ -0,0 +1,28 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file StdoutPrint.h
+// This file implements a Print to the standard output for the host tests.
+//
+// ---------------------------------------------------------------------------
+#ifndef StdoutPrint_h
+#define StdoutPrint_h
+
+#include <stdio.h>
+#include <Print.h>
+
+class StdoutPrint : public Print
+{
+public:
+   size_t write ( uint8_t value ) { return ( putchar ( value ) != EOF ); }
+   using Print::write;
+};
+
+#endif
@@ -0,0 +1,38 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file pins_arduino.h
+// This file maps the pins of the host tests to ports.
+//
+// @brief
+// The pins are grouped by 8 in ports held in memory, the way the AVR and
+// PIC32 cores map them to port registers. FastIO writes the ports directly
+// and digitalWrite through the pin functions, both see the same levels.
+// A port is its own input register: a pin reads the level last written.
+//
+// ---------------------------------------------------------------------------
+#ifndef Pins_Arduino_h
+#define Pins_Arduino_h
+
+#include <inttypes.h>
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+#define NUM_DIGITAL_PINS             64
+#define TEST_PORTS                   ( NUM_DIGITAL_PINS / 8 )
+
+#define digitalPinToPort(pin)        ( (pin) / 8 )
+#define digitalPinToBitMask(pin)     ( 1UL << ( (pin) % 8 ) )
+#define portOutputRegister(port)     ( &testPorts[port] )
+#define portInputRegister(port)      ( &testPorts[port] )
+
+extern volatile uint32_t testPorts[TEST_PORTS];
+
+#endif
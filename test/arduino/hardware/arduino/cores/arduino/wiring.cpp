@@ -0,0 +1,58 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: Yes
+// Extendable: Yes
+//
+// @file wiring.cpp
+// This file implements the timing functions of the Arduino core for the
+// host tests.
+//
+// @brief
+// Time is simulated: delays don't sleep, they move a clock on. The tests
+// run as fast as the host allows and the time a driver spends waiting is
+// exact, the same on every run. The clock is shared by all the threads.
+//
+// ---------------------------------------------------------------------------
+#include <atomic>
+
+#include <Arduino.h>
+
+// CLASS VARIABLES
+// ---------------------------------------------------------------------------
+static std::atomic<unsigned long> now ( 0 );     // Simulated time (us)
+
+// PUBLIC FUNCTIONS
+// ---------------------------------------------------------------------------
+
+//
+// delay
+void delay ( unsigned long ms )
+{
+   now += ms * 1000UL;
+}
+
+//
+// delayMicroseconds
+void delayMicroseconds ( unsigned int us )
+{
+   now += us;
+}
+
+//
+// millis
+unsigned long millis ( void )
+{
+   return ( now / 1000UL );
+}
+
+//
+// micros
+unsigned long micros ( void )
+{
+   return ( now );
+}
@@ -0,0 +1,78 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file wiring_digital.cpp
+// This file implements the pin functions of the Arduino core for the host
+// tests.
+//
+// @brief
+// The pins are bits of the ports of pins_arduino.h. The mode of a pin is
+// not checked and analogWrite sets the pin high for any non zero value.
+//
+// ---------------------------------------------------------------------------
+#include <Arduino.h>
+#include <pins_arduino.h>
+
+// CLASS VARIABLES
+// ---------------------------------------------------------------------------
+volatile uint32_t testPorts[TEST_PORTS];
+
+// PUBLIC FUNCTIONS
+// ---------------------------------------------------------------------------
+
+//
+// pinMode
+void pinMode ( uint8_t pin, uint8_t mode )
+{
+   if ( mode == INPUT_PULLUP )
+   {
+      digitalWrite ( pin, HIGH );
+   }
+}
+
+//
+// digitalWrite
+void digitalWrite ( uint8_t pin, uint8_t value )
+{
+   if ( pin >= NUM_DIGITAL_PINS )
+   {
+      return;
+   }
+   if ( value == LOW )
+   {
+      *portOutputRegister ( digitalPinToPort ( pin ) ) &=
+         ~digitalPinToBitMask ( pin );
+   }
+   else
+   {
+      *portOutputRegister ( digitalPinToPort ( pin ) ) |=
+         digitalPinToBitMask ( pin );
+   }
+}
+
+//
+// digitalRead
+int digitalRead ( uint8_t pin )
+{
+   if ( ( pin < NUM_DIGITAL_PINS ) &&
+        ( *portInputRegister ( digitalPinToPort ( pin ) ) &
+          digitalPinToBitMask ( pin ) ) )
+   {
+      return ( HIGH );
+   }
+   return ( LOW );
+}
+
+//
+// analogWrite
+void analogWrite ( uint8_t pin, int value )
+{
+   digitalWrite ( pin, ( value != 0 ) ? HIGH : LOW );
+}
@@ -0,0 +1,229 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file Wire.cpp
+// This file implements the Wire library of the Arduino core for the host
+// tests.
+//
+// @brief
+// A transmission is handed to the device at endTransmission, a read asks
+// the device for its bytes at requestFrom, as the bus transfers them.
+//
+// ---------------------------------------------------------------------------
+#include <string.h>
+
+#include <Arduino.h>
+
+#include "Wire.h"
+
+// CLASS VARIABLES
+// ---------------------------------------------------------------------------
+TwoWire Wire;
+
+// CONSTRUCTORS
+// ---------------------------------------------------------------------------
+TwoWire::TwoWire ( void )
+{
+   _device    = NULL;
+   _address   = 0;
+   _txLength  = 0;
+   _rxIndex   = 0;
+   _rxLength  = 0;
+   _onReceive = NULL;
+   _onRequest = NULL;
+}
+
+// PUBLIC METHODS
+// ---------------------------------------------------------------------------
+
+//
+// attach
+void TwoWire::attach ( TwoWireDevice *device )
+{
+   _device = device;
+}
+
+//
+// begin
+void TwoWire::begin ( void )
+{
+   _txLength = 0;
+   _rxIndex  = 0;
+   _rxLength = 0;
+}
+
+void TwoWire::begin ( uint8_t address )
+{
+   begin ( );
+}
+
+void TwoWire::begin ( int address )
+{
+   begin ( );
+}
+
+//
+// beginTransmission
+void TwoWire::beginTransmission ( uint8_t address )
+{
+   _address  = address;
+   _txLength = 0;
+}
+
+void TwoWire::beginTransmission ( int address )
+{
+   beginTransmission ( (uint8_t)address );
+}
+
+//
+// endTransmission
+uint8_t TwoWire::endTransmission ( void )
+{
+   return ( endTransmission ( 1 ) );
+}
+
+uint8_t TwoWire::endTransmission ( uint8_t sendStop )
+{
+   uint8_t status = 0;
+
+   if ( _device != NULL )
+   {
+      status = _device->receive ( _address, _tx, _txLength );
+   }
+   delayMicroseconds ( WIRE_START_STOP + ( _txLength + 1 ) * WIRE_BYTE_TIME );
+   _txLength = 0;
+   return ( status );
+}
+
+//
+// requestFrom
+uint8_t TwoWire::requestFrom ( uint8_t address, uint8_t quantity )
+{
+   if ( quantity > BUFFER_LENGTH )
+   {
+      quantity = BUFFER_LENGTH;
+   }
+   for ( uint8_t i = 0; i < quantity; i++ )
+   {
+      _rx[i] = ( _device != NULL ) ? _device->request ( address ) : 0xFF;
+   }
+   delayMicroseconds ( WIRE_START_STOP + ( quantity + 1 ) * WIRE_BYTE_TIME );
+   _rxIndex  = 0;
+   _rxLength = quantity;
+   return ( quantity );
+}
+
+uint8_t TwoWire::requestFrom ( int address, int quantity )
+{
+   return ( requestFrom ( (uint8_t)address, (uint8_t)quantity ) );
+}
+
+//
+// masterWrite
+void TwoWire::masterWrite ( const uint8_t *data, uint8_t length )
+{
+   if ( length > BUFFER_LENGTH )
+   {
+      length = BUFFER_LENGTH;
+   }
+   memcpy ( _rx, data, length );
+   _rxIndex  = 0;
+   _rxLength = length;
+   delayMicroseconds ( WIRE_START_STOP + ( length + 1 ) * WIRE_BYTE_TIME );
+   if ( _onReceive != NULL )
+   {
+      _onReceive ( length );
+   }
+}
+
+//
+// masterRead
+uint8_t TwoWire::masterRead ( uint8_t *data, uint8_t quantity )
+{
+   _txLength = 0;
+   if ( _onRequest != NULL )
+   {
+      _onRequest ( );
+   }
+   if ( quantity > _txLength )
+   {
+      quantity = _txLength;
+   }
+   memcpy ( data, _tx, quantity );
+   _txLength = 0;
+   delayMicroseconds ( WIRE_START_STOP + ( quantity + 1 ) * WIRE_BYTE_TIME );
+   return ( quantity );
+}
+
+//
+// write
+size_t TwoWire::write ( uint8_t value )
+{
+   if ( _txLength >= BUFFER_LENGTH )
+   {
+      return ( 0 );
+   }
+   _tx[_txLength++] = value;
+   return ( 1 );
+}
+
+size_t TwoWire::write ( const uint8_t *data, size_t quantity )
+{
+   size_t n = 0;
+
+   while ( quantity-- )
+   {
+      n += write ( *data++ );
+   }
+   return ( n );
+}
+
+//
+// available
+int TwoWire::available ( void )
+{
+   return ( _rxLength - _rxIndex );
+}
+
+//
+// read
+int TwoWire::read ( void )
+{
+   if ( _rxIndex >= _rxLength )
+   {
+      return ( -1 );
+   }
+   return ( _rx[_rxIndex++] );
+}
+
+//
+// peek
+int TwoWire::peek ( void )
+{
+   if ( _rxIndex >= _rxLength )
+   {
+      return ( -1 );
+   }
+   return ( _rx[_rxIndex] );
+}
+
+//
+// onReceive
+void TwoWire::onReceive ( void ( *function ) ( int ) )
+{
+   _onReceive = function;
+}
+
+//
+// onRequest
+void TwoWire::onRequest ( void ( *function ) ( void ) )
+{
+   _onRequest = function;
+}
@@ -0,0 +1,121 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file Wire.h
+// This file implements the Wire library of the Arduino core for the host
+// tests.
+//
+// @brief
+// Same master interface as the Wire library of the Arduino 1.0 core. The
+// bus goes to a TwoWireDevice the test attaches, a model of the chip the
+// driver talks to. Without a device every address acknowledges, writes are
+// discarded and reads return 0xFF, an idle bus.
+//
+// As a slave, the test plays the master: masterWrite hands a transfer to
+// the onReceive callback, masterRead returns what the onRequest callback
+// writes.
+//
+// The bus takes time on the simulated clock of the test core, as at the
+// 100kHz of the Arduino TWI: 9 clocks a byte, the address included, and
+// about a clock for start and stop.
+//
+// ---------------------------------------------------------------------------
+#ifndef TwoWire_h
+#define TwoWire_h
+
+#include <inttypes.h>
+#include <stddef.h>
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+#define BUFFER_LENGTH 32
+#define WIRE_BYTE_TIME  90      // us
+#define WIRE_START_STOP 10      // us
+
+class TwoWireDevice
+{
+public:
+   /*!
+    @function
+    @abstract   Receives a transmission of the master.
+    @result     0 if acknowledged, 2 if the address is not (endTransmission
+    status).
+    */
+   virtual uint8_t receive ( uint8_t address, const uint8_t *data,
+                             uint8_t length ) = 0;
+
+   /*!
+    @function
+    @abstract   Sends the next byte of a read of the master.
+    */
+   virtual uint8_t request ( uint8_t address ) = 0;
+};
+
+class TwoWire
+{
+public:
+   TwoWire ( void );
+
+   /*!
+    @function
+    @abstract   Attaches the model of the chip on the bus, NULL for none.
+    */
+   void attach ( TwoWireDevice *device );
+
+   /*!
+    @function
+    @abstract   A master writes to the slave: calls the onReceive callback.
+    */
+   void masterWrite ( const uint8_t *data, uint8_t length );
+
+   /*!
+    @function
+    @abstract   A master reads from the slave: calls the onRequest callback.
+    @result     number of bytes the slave wrote, up to quantity.
+    */
+   uint8_t masterRead ( uint8_t *data, uint8_t quantity );
+
+   void    begin ( void );
+   void    begin ( uint8_t address );
+   void    begin ( int address );
+   void    beginTransmission ( uint8_t address );
+   void    beginTransmission ( int address );
+   uint8_t endTransmission ( void );
+   uint8_t endTransmission ( uint8_t sendStop );
+   uint8_t requestFrom ( uint8_t address, uint8_t quantity );
+   uint8_t requestFrom ( int address, int quantity );
+   size_t  write ( uint8_t value );
+   size_t  write ( const uint8_t *data, size_t quantity );
+   int     available ( void );
+   int     read ( void );
+   int     peek ( void );
+   void    onReceive ( void ( *function ) ( int ) );
+   void    onRequest ( void ( *function ) ( void ) );
+
+   inline size_t write ( unsigned long n ) { return ( write ( (uint8_t)n ) ); }
+   inline size_t write ( long n ) { return ( write ( (uint8_t)n ) ); }
+   inline size_t write ( unsigned int n ) { return ( write ( (uint8_t)n ) ); }
+   inline size_t write ( int n ) { return ( write ( (uint8_t)n ) ); }
+
+private:
+   TwoWireDevice *_device;                  // Chip on the bus
+   uint8_t        _address;                 // Address being written
+   uint8_t        _tx[BUFFER_LENGTH];       // Bytes of the transmission
+   uint8_t        _txLength;
+   uint8_t        _rx[BUFFER_LENGTH];       // Bytes read
+   uint8_t        _rxIndex;
+   uint8_t        _rxLength;
+   void         ( *_onReceive ) ( int );    // Slave callbacks
+   void         ( *_onRequest ) ( void );
+};
+
+extern TwoWire Wire;
+
+#endif
@@ -0,0 +1,100 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file bench_diff.cpp
+// This file times lcd_diffFirst and lcd_diffLast against the byte by byte
+// search on the host (@see LCDDiff).
+//
+// @brief
+// The host version of examples/DiffBenchmark: a 20x4 LCD, a 64x16 canvas
+// and 16 LCD 20x4 driven by the same host. Only the last character differs,
+// the whole screen is searched; lcd_diffLast finds it straight away.
+// Prints the time of a search in ns. Not part of the checks, timings depend
+// on the host: make bench.
+//
+// ---------------------------------------------------------------------------
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "LCDDiff.h"
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+#define SCREENS       3
+#define RUNS          1000000L
+
+// CLASS VARIABLES
+// ---------------------------------------------------------------------------
+static const size_t sizes[SCREENS] = { 20 * 4, 64 * 16, 16 * 20 * 4 };
+static const char  *names[SCREENS] =
+{
+   "1 LCD 20x4", "canvas 64x16", "16 LCD 20x4"
+};
+
+static uint8_t         screen[16 * 20 * 4];
+static uint8_t         shown[16 * 20 * 4];
+static volatile size_t found;
+
+// The byte by byte search lcd_diffFirst is compared against, not inlined
+// so that it isn't optimised for the sizes timed
+static size_t __attribute__ ( ( noinline ) )
+byteFirst ( const uint8_t *a, const uint8_t *b, size_t size )
+{
+   size_t i = 0;
+
+   while ( ( i < size ) && ( a[i] == b[i] ) )
+   {
+      i++;
+   }
+   return ( i );
+}
+
+static double now ( void )
+{
+   struct timespec t;
+
+   clock_gettime ( CLOCK_MONOTONIC, &t );
+   return ( t.tv_sec * 1e9 + t.tv_nsec );
+}
+
+static double timeSearch ( size_t ( *search ) ( const uint8_t *,
+                                                const uint8_t *, size_t ),
+                           size_t size )
+{
+   double start = now ( );
+
+   for ( long run = 0; run < RUNS; run++ )
+   {
+      found = search ( screen, shown, size );
+   }
+   return ( ( now ( ) - start ) / RUNS );
+}
+
+int main ( void )
+{
+   for ( unsigned i = 0; i < SCREENS; i++ )
+   {
+      double bytes;
+      double words;
+
+      memset ( screen, ' ', sizes[i] );
+      memset ( shown, ' ', sizes[i] );
+      screen[sizes[i] - 1] = '*';
+
+      bytes = timeSearch ( byteFirst, sizes[i] );
+      words = timeSearch ( lcd_diffFirst, sizes[i] );
+      printf ( "%-13s %5zu characters: byte loop %7.1f ns, "
+               "lcd_diffFirst %6.1f ns (x%.1f), lcd_diffLast %4.1f ns\n",
+               names[i], sizes[i], bytes, words, bytes / words,
+               timeSearch ( lcd_diffLast, sizes[i] ) );
+   }
+   return ( 0 );
+}
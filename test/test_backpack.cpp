@@ -0,0 +1,222 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file test_backpack.cpp
+// This file checks LCDBackpack against a master sending it random screens
+// (@see LCDBackpack).
+//
+// @brief
+// The test plays the master on the Wire bus: an LCDEncoder turns random
+// screens into frames, written to the backpack in transfers of up to
+// BUFFER_LENGTH bytes. The backpack drives an LCDSimulator.
+// - Paced: before each transfer the master reads the room left in the
+//   receive buffer and lets the backpack apply frames until the transfer
+//   fits. Nothing is lost and the LCD shows every screen.
+// - Unpaced: the master writes without reading the room and the backpack
+//   only gets a few updates in between, the buffer overruns. When the
+//   errors the backpack reports change, the master sends the whole screen
+//   again: at the end the LCD shows the last screen.
+//
+// ---------------------------------------------------------------------------
+#include <stdio.h>
+#include <string.h>
+
+#include <Wire.h>
+#include "LCDSimulator.h"
+#include "LCDEncoder.h"
+#include "LCDBackpack.h"
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+#define COLS          20
+#define ROWS          4
+#define CELLS         ( COLS * ROWS )
+#define SCREENS       2000
+#define MAX_UPDATES   1         // backpack updates per transfer, unpaced
+
+// CLASS VARIABLES
+// ---------------------------------------------------------------------------
+static LCDSimulator lcd;
+static LCDBackpack  backpack ( lcd, COLS, ROWS );
+static uint8_t      screen[CELLS];
+static uint32_t     seed = 2463534242UL;
+static unsigned     failed;
+
+// Same sequence on every run (xorshift)
+static uint32_t next ( uint32_t range )
+{
+   seed ^= seed << 13;
+   seed ^= seed >> 17;
+   seed ^= seed << 5;
+   return ( seed % range );
+}
+
+// Next screen: a new one now and then, a few characters changed otherwise
+static void change ( void )
+{
+   uint8_t count = 1 + next ( 6 );
+
+   if ( next ( 10 ) == 0 )
+   {
+      for ( uint8_t i = 0; i < CELLS; i++ )
+      {
+         screen[i] = next ( 3 ) ? ' ' + next ( 95 ) : ' ';
+      }
+      return;
+   }
+   while ( count-- > 0 )
+   {
+      screen[next ( CELLS )] = ' ' + next ( 95 );
+   }
+}
+
+// Room left in the receive buffer and errors
+static void status ( uint8_t &room, uint8_t &errors )
+{
+   uint8_t reply[2];
+
+   if ( Wire.masterRead ( reply, sizeof ( reply ) ) != sizeof ( reply ) )
+   {
+      printf ( "FAIL status not replied\n" );
+      failed++;
+   }
+   room   = reply[0];
+   errors = reply[1];
+}
+
+// Applies all the frames received
+static void drain ( void )
+{
+   while ( backpack.update ( ) )
+   {
+   }
+}
+
+static void send ( const uint8_t *frames, uint16_t length, bool paced )
+{
+   uint8_t room;
+   uint8_t errors;
+
+   for ( uint16_t i = 0; i < length; i += BUFFER_LENGTH )
+   {
+      uint8_t chunk = ( length - i < BUFFER_LENGTH ) ? length - i :
+                                                       BUFFER_LENGTH;
+
+      if ( paced )
+      {
+         for ( status ( room, errors ); room < chunk; status ( room, errors ) )
+         {
+            if ( !backpack.update ( ) )
+            {
+               printf ( "FAIL no room with nothing to apply\n" );
+               failed++;
+               return;
+            }
+         }
+      }
+      Wire.masterWrite ( &frames[i], chunk );
+      for ( uint8_t n = paced ? 0 : next ( MAX_UPDATES + 1 ); n > 0; n-- )
+      {
+         backpack.update ( );
+      }
+   }
+}
+
+static bool shows ( void )
+{
+   for ( uint8_t i = 0; i < CELLS; i++ )
+   {
+      if ( lcd.charAt ( i % COLS, i / COLS ) != screen[i] )
+      {
+         return ( false );
+      }
+   }
+   return ( true );
+}
+
+static void run ( bool paced )
+{
+   LCDEncoder encoder ( COLS, ROWS );
+   uint8_t    frames[LCDP_MAX_ENCODED];
+   uint16_t   length;
+   uint8_t    room;
+   uint8_t    errors;
+   uint8_t    reported;
+   unsigned   resent = 0;
+
+   status ( room, reported );
+   for ( unsigned n = 0; ( n < SCREENS ) && ( failed < 10 ); n++ )
+   {
+      change ( );
+      length = encoder.encode ( screen, frames, sizeof ( frames ) );
+      send ( frames, length, paced );
+
+      if ( paced )
+      {
+         drain ( );
+         if ( !shows ( ) )
+         {
+            printf ( "FAIL paced, screen %u: LCD differs\n", n );
+            failed++;
+         }
+      }
+
+      status ( room, errors );
+      if ( errors != reported )
+      {
+         reported = errors;
+         encoder.invalidate ( );
+         resent++;
+      }
+   }
+
+   // Unpaced, the last screen whole once nothing is lost any more
+   drain ( );
+   for ( status ( room, errors ); errors != reported; status ( room, errors ) )
+   {
+      reported = errors;
+      encoder.invalidate ( );
+      length = encoder.encode ( screen, frames, sizeof ( frames ) );
+      send ( frames, length, true );
+      drain ( );
+      resent++;
+   }
+
+   printf ( "%s: %u screens, %u sent again whole\n",
+            paced ? "paced" : "unpaced", SCREENS, resent );
+   if ( paced && ( resent != 0 ) )
+   {
+      printf ( "FAIL paced: frames lost\n" );
+      failed++;
+   }
+   if ( !paced && ( resent == 0 ) )
+   {
+      printf ( "FAIL unpaced: the buffer never overran\n" );
+      failed++;
+   }
+   if ( !shows ( ) )
+   {
+      printf ( "FAIL %s: LCD differs at the end\n",
+               paced ? "paced" : "unpaced" );
+      failed++;
+   }
+}
+
+int main ( void )
+{
+   backpack.begin ( 0x30 );
+   memset ( screen, ' ', sizeof ( screen ) );
+
+   run ( true );
+   run ( false );
+
+   printf ( "%u checks failed\n", failed );
+   return ( failed != 0 );
+}
@@ -0,0 +1,148 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file test_bustrace.cpp
+// This file checks the bytes every driver puts on its bus against the golden
+// values of the BusTrace example (@see LCDBusTrace).
+//
+// @brief
+// Runs the scenarios of examples/BusTrace on each driver, built with the
+// constructor of its golden table. The duration of a scenario is the time
+// the driver takes on the simulated clock of the test core: the waits of
+// the driver, for the LCD or its bus, the same on every run. A scenario
+// whose bytes differ, or that takes any longer, prints a FAIL line and makes
+// the test fail.
+//
+// With -r the values are printed as the tables of golden.h, to record them
+// after a change of protocol that has been checked on the hardware.
+//
+// ---------------------------------------------------------------------------
+#include <stdio.h>
+#include <string.h>
+
+#include "LCDBusTrace.h"
+#include "LiquidCrystal.h"
+#include "LiquidCrystal_I2C.h"
+#include "LiquidCrystal_IIC.h"
+#include "LiquidCrystal_I2C_ByVac.h"
+#include "LiquidCrystal_SR.h"
+#include "LiquidCrystal_SR1W.h"
+#include "LiquidCrystal_SR2W.h"
+#include "LiquidCrystal_SR3W.h"
+#include "StdoutPrint.h"
+
+#include "../examples/BusTrace/scenarios.h"
+#include "../examples/BusTrace/golden.h"
+
+#ifndef LCD_BUS_TRACE
+#error "The bus trace is off, build with -DLCD_BUS_TRACE"
+#endif
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+#define LCD_COLS        16
+#define LCD_ROWS        2
+
+// CLASS VARIABLES
+// ---------------------------------------------------------------------------
+static StdoutPrint out;
+
+// The constructors of the BusTrace example
+static LiquidCrystal           lcd ( 8, 9, 4, 5, 6, 7, 10, POSITIVE );
+static LiquidCrystal_I2C       lcdI2C ( 0x27, 2, 1, 0, 4, 5, 6, 7, 3,
+                                        POSITIVE );
+static LiquidCrystal_IIC       lcdIIC ( 0x38, IIC_BOARD_EXTRAIO );
+static LiquidCrystal_I2C_ByVac lcdByVac ( 0x21 );
+static LiquidCrystal_SR        lcdSR ( 2, 3, 4 );
+static LiquidCrystal_SR1W      lcdSR1W ( 2, SW_CLEAR );
+static LiquidCrystal_SR2W      lcdSR2W ( 2, 3 );
+static LiquidCrystal_SR3W      lcdSR3W ( 2, 3, 4 );
+
+static LCD *drivers[BUS_DRIVERS] =
+{
+   &lcd, &lcdI2C, &lcdIIC, &lcdByVac, &lcdSR, &lcdSR1W, &lcdSR2W, &lcdSR3W
+};
+
+static const char *constructors[BUS_DRIVERS] =
+{
+   "LiquidCrystal lcd(8, 9, 4, 5, 6, 7, 10, POSITIVE)",
+   "LiquidCrystal_I2C lcd(0x27, 2, 1, 0, 4, 5, 6, 7, 3, POSITIVE)",
+   "LiquidCrystal_IIC lcd(0x38, IIC_BOARD_EXTRAIO)",
+   "LiquidCrystal_I2C_ByVac lcd(0x21)", "LiquidCrystal_SR lcd(2, 3, 4)",
+   "LiquidCrystal_SR1W lcd(2, SW_CLEAR)", "LiquidCrystal_SR2W lcd(2, 3)",
+   "LiquidCrystal_SR3W lcd(2, 3, 4)"
+};
+
+static const char *driverNames[BUS_DRIVERS] =
+{
+   "LiquidCrystal", "LiquidCrystal_I2C", "LiquidCrystal_IIC",
+   "LiquidCrystal_I2C_ByVac", "LiquidCrystal_SR", "LiquidCrystal_SR1W",
+   "LiquidCrystal_SR2W", "LiquidCrystal_SR3W"
+};
+
+int main ( int argc, char *argv[] )
+{
+   bool     record = ( argc > 1 ) && ( strcmp ( argv[1], "-r" ) == 0 );
+   unsigned failed = 0;
+
+   for ( uint8_t driver = 0; driver < BUS_DRIVERS; driver++ )
+   {
+      LCD &display = *drivers[driver];
+
+      if ( record )
+      {
+         printf ( "  // %s\n  {\n", constructors[driver] );
+      }
+      for ( uint8_t i = 0; i < SCENARIOS; i++ )
+      {
+         const golden &expect = expected[driver][i];
+         unsigned long us;
+
+         LCDBusTrace::start ( );
+         us = micros ( );
+         scenario ( display, i, LCD_COLS, LCD_ROWS );
+         us = micros ( ) - us;
+
+         if ( record )
+         {
+            char bytes[16];
+            char time[16];
+
+            snprintf ( bytes, sizeof ( bytes ), "{ %lu,",
+                       LCDBusTrace::count ( ) );
+            snprintf ( time, sizeof ( time ), "%lu },", us );
+            printf ( "    %-6s 0x%04X, %-9s // %s\n", bytes,
+                     LCDBusTrace::crc ( ), time, names[i] );
+         }
+         else if ( ( LCDBusTrace::count ( ) != expect.bytes ) ||
+                   ( LCDBusTrace::crc ( ) != expect.crc ) )
+         {
+            printf ( "FAIL %s %s: protocol, %lu bytes CRC 0x%04X, "
+                     "expected %lu bytes CRC 0x%04X\n",
+                     driverNames[driver], names[i], LCDBusTrace::count ( ),
+                     LCDBusTrace::crc ( ), expect.bytes, expect.crc );
+            LCDBusTrace::dump ( out );
+            failed++;
+         }
+         else if ( us > expect.us )
+         {
+            printf ( "FAIL %s %s: slower, %lu us, expected %lu us\n",
+                     driverNames[driver], names[i], us, expect.us );
+            failed++;
+         }
+      }
+      if ( record )
+      {
+         printf ( "  },\n" );
+      }
+   }
+   printf ( "%u scenarios failed\n", failed );
+   return ( failed != 0 );
+}
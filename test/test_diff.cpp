@@ -0,0 +1,119 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file test_diff.cpp
+// This file checks lcd_diffFirst and lcd_diffLast against the byte by byte
+// search (@see LCDDiff).
+//
+// @brief
+// Random screens of 0 to MAX_SIZE characters, starting at any offset of the
+// buffers so that the two screens are aligned differently, with no to a few
+// differences anywhere, the first and the last characters included. Both
+// functions must find what the byte loops find.
+//
+// Built once as is, comparing 16 bytes at a time with SSE2 on x86 hosts,
+// and once without SSE2, comparing a machine word at a time.
+//
+// ---------------------------------------------------------------------------
+#include <stdio.h>
+#include <string.h>
+
+#include "LCDDiff.h"
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+#define MAX_SIZE      200
+#define MAX_OFFSET    16
+#define MAX_CHANGES   3
+#define RUNS          200000L
+
+// CLASS VARIABLES
+// ---------------------------------------------------------------------------
+static uint8_t  bufferA[MAX_SIZE + MAX_OFFSET];
+static uint8_t  bufferB[MAX_SIZE + MAX_OFFSET];
+static uint32_t seed = 2463534242UL;
+
+// Same sequence on every run (xorshift)
+static uint32_t random ( uint32_t range )
+{
+   seed ^= seed << 13;
+   seed ^= seed >> 17;
+   seed ^= seed << 5;
+   return ( seed % range );
+}
+
+static size_t byteFirst ( const uint8_t *a, const uint8_t *b, size_t size )
+{
+   size_t i = 0;
+
+   while ( ( i < size ) && ( a[i] == b[i] ) )
+   {
+      i++;
+   }
+   return ( i );
+}
+
+static size_t byteLast ( const uint8_t *a, const uint8_t *b, size_t size )
+{
+   while ( ( size > 0 ) && ( a[size - 1] == b[size - 1] ) )
+   {
+      size--;
+   }
+   return ( size );
+}
+
+int main ( void )
+{
+   unsigned failed = 0;
+
+   for ( long run = 0; ( run < RUNS ) && ( failed < 10 ); run++ )
+   {
+      size_t   size    = random ( MAX_SIZE + 1 );
+      uint8_t *a       = &bufferA[random ( MAX_OFFSET )];
+      uint8_t *b       = &bufferB[random ( MAX_OFFSET )];
+      uint32_t changes = random ( MAX_CHANGES + 1 );
+      size_t   first;
+      size_t   last;
+
+      for ( size_t i = 0; i < size; i++ )
+      {
+         a[i] = random ( 256 );
+      }
+      memcpy ( b, a, size );
+      for ( uint32_t i = 0; ( size > 0 ) && ( i < changes ); i++ )
+      {
+         // Any character, the ends more often than by chance
+         size_t at = random ( 4 ) == 0 ? ( random ( 2 ) ? 0 : size - 1 ) :
+                                         random ( size );
+
+         b[at] = a[at] ^ ( 1 << random ( 8 ) );
+      }
+
+      first = lcd_diffFirst ( a, b, size );
+      last  = lcd_diffLast ( a, b, size );
+      if ( first != byteFirst ( a, b, size ) )
+      {
+         printf ( "FAIL run %ld, size %zu, offsets %u/%u: first %zu, "
+                  "expected %zu\n", run, size, (unsigned)( a - bufferA ),
+                  (unsigned)( b - bufferB ), first, byteFirst ( a, b, size ) );
+         failed++;
+      }
+      if ( last != byteLast ( a, b, size ) )
+      {
+         printf ( "FAIL run %ld, size %zu, offsets %u/%u: last %zu, "
+                  "expected %zu\n", run, size, (unsigned)( a - bufferA ),
+                  (unsigned)( b - bufferB ), last, byteLast ( a, b, size ) );
+         failed++;
+      }
+   }
+
+   printf ( "%u checks failed\n", failed );
+   return ( failed != 0 );
+}
@@ -0,0 +1,77 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file test_equivalence.cpp
+// This file checks LiquidCrystal_Buffer against plain writes to the LCD on
+// the host (@see LCDEquivalence).
+//
+// @brief
+// Runs the same seeds on every display size. A run that differs is printed
+// with both simulated LCDs and makes the test fail. The bus time saved is
+// reported for each size.
+//
+// ---------------------------------------------------------------------------
+#include <stdio.h>
+
+#include "LCDSimulator.h"
+#include "LCDEquivalence.h"
+#include "LiquidCrystal_Buffer.h"
+#include "StdoutPrint.h"
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+#define SEEDS      50
+#define STEPS      500
+
+static const uint8_t sizes[][2] =
+{
+   { 8, 1 }, { 16, 1 }, { 40, 1 }, { 16, 2 }, { 20, 2 }, { 40, 2 }, { 16, 4 },
+   { 20, 4 }
+};
+
+// CLASS VARIABLES
+// ---------------------------------------------------------------------------
+static StdoutPrint          out;
+static LCDSimulator         target;
+static LCDSimulator         reference;
+static LiquidCrystal_Buffer buffer ( target );
+
+static void flushBuffer ( void )
+{
+   buffer.flush ( );
+}
+
+int main ( void )
+{
+   LCDEquivalence check ( buffer, target, reference, flushBuffer );
+   unsigned failed = 0;
+
+   for ( uint8_t i = 0; i < sizeof ( sizes ) / sizeof ( sizes[0] ); i++ )
+   {
+      printf ( "%ux%u\n", sizes[i][0], sizes[i][1] );
+      check.begin ( sizes[i][0], sizes[i][1] );
+      for ( uint32_t seed = 1; seed <= SEEDS; seed++ )
+      {
+         if ( !check.run ( STEPS, seed ) )
+         {
+            printf ( "FAIL %ux%u seed %u: differ after call %u\n",
+                     sizes[i][0], sizes[i][1], (unsigned)seed,
+                     check.failedStep ( ) );
+            target.dump ( out );
+            reference.dump ( out );
+            failed++;
+            check.begin ( sizes[i][0], sizes[i][1] );
+         }
+      }
+      check.report ( out );
+   }
+   printf ( "%u runs failed\n", failed );
+   return ( failed != 0 );
+}
@@ -0,0 +1,160 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file test_gpio_linux.cpp
+// This file checks the line changes of LiquidCrystal_GPIO_Linux on a stand
+// in for the GPIO chip (@see t_linuxIO).
+//
+// @brief
+// The stand in records the line request and every
+// GPIO_V2_LINE_SET_VALUES_IOCTL, values and mask, with the time of the
+// call. The calls of a command and two characters are checked one by one:
+// two per nibble, three when RS changes. EN has to stay high for the pulse
+// width.
+//
+// ---------------------------------------------------------------------------
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <linux/gpio.h>
+
+#include "LiquidCrystal_GPIO_Linux.h"
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+#define CHIP_FD      5
+#define LINES_FD     6
+#define MAX_CALLS    64
+
+// Bits of the lines, in the order they are requested
+#define LINE_RS         0x01
+#define LINE_EN         0x02
+#define LINE_DATA       0x3C
+#define LINE_BACKLIGHT  0x40
+#define D(nibble)       ( (nibble) << 2 )
+
+// CLASS VARIABLES
+// ---------------------------------------------------------------------------
+typedef struct
+{
+   uint64_t        bits;
+   uint64_t        mask;
+   struct timespec time;
+} t_set;
+
+static struct gpio_v2_line_request request;
+static t_set    sets[MAX_CALLS];
+static unsigned calls;
+static unsigned failed;
+
+static int mockOpen ( const char *path, int flags )
+{
+   return ( CHIP_FD );
+}
+
+static int mockClose ( int fd )
+{
+   return ( 0 );
+}
+
+static int mockIoctl ( int fd, unsigned long req, void *arg )
+{
+   if ( ( fd == CHIP_FD ) && ( req == GPIO_V2_GET_LINE_IOCTL ) )
+   {
+      request = *(struct gpio_v2_line_request *)arg;
+      ( (struct gpio_v2_line_request *)arg )->fd = LINES_FD;
+      return ( 0 );
+   }
+   if ( ( fd == LINES_FD ) && ( req == GPIO_V2_LINE_SET_VALUES_IOCTL ) &&
+        ( calls < MAX_CALLS ) )
+   {
+      sets[calls].bits = ( (struct gpio_v2_line_values *)arg )->bits;
+      sets[calls].mask = ( (struct gpio_v2_line_values *)arg )->mask;
+      clock_gettime ( CLOCK_MONOTONIC, &sets[calls].time );
+      calls++;
+      return ( 0 );
+   }
+   printf ( "FAIL unexpected ioctl 0x%lX on %d\n", req, fd );
+   failed++;
+   return ( -1 );
+}
+
+static const t_linuxIO mockIO = { mockOpen, mockClose, mockIoctl };
+
+static LiquidCrystal_GPIO_Linux lcd ( "/dev/gpiochip0", 25, 24, 23, 17, 18,
+                                      22, 27, POSITIVE, mockIO );
+
+static void check ( const char *what, unsigned long value,
+                    unsigned long expected )
+{
+   if ( value != expected )
+   {
+      printf ( "FAIL %s: 0x%lX, expected 0x%lX\n", what, value, expected );
+      failed++;
+   }
+}
+
+int main ( void )
+{
+   // Calls for: command 0xC0, 'A' (0x41), 'B' (0x42), backlight on
+   static const uint8_t expected[][2] =
+   {
+      // command, RS unchanged
+      { D(0xC) | LINE_EN, LINE_DATA | LINE_EN }, { 0, LINE_EN },
+      { D(0x0) | LINE_EN, LINE_DATA | LINE_EN }, { 0, LINE_EN },
+      // RS to data first
+      { D(0x4) | LINE_RS, LINE_DATA | LINE_RS }, { LINE_EN, LINE_EN },
+      { 0, LINE_EN },
+      { D(0x1) | LINE_EN, LINE_DATA | LINE_EN }, { 0, LINE_EN },
+      // 'B', RS unchanged
+      { D(0x4) | LINE_EN, LINE_DATA | LINE_EN }, { 0, LINE_EN },
+      { D(0x2) | LINE_EN, LINE_DATA | LINE_EN }, { 0, LINE_EN },
+      { LINE_BACKLIGHT, LINE_BACKLIGHT }
+   };
+   const unsigned count = sizeof ( expected ) / sizeof ( expected[0] );
+   static const uint8_t offsets[] = { 25, 24, 23, 17, 18, 22, 27 };
+   long     width;
+
+   lcd.begin ( 16, 2 );
+   check ( "lines requested", request.num_lines, 7 );
+   for ( unsigned i = 0; i < sizeof ( offsets ); i++ )
+   {
+      check ( "line offset", request.offsets[i], offsets[i] );
+   }
+   check ( "lines are outputs", request.config.flags,
+           GPIO_V2_LINE_FLAG_OUTPUT );
+
+   calls = 0;
+   lcd.command ( LCD_SETDDRAMADDR | 0x40 );
+   lcd.write ( 'A' );
+   lcd.write ( 'B' );
+   lcd.setBacklight ( HIGH );
+
+   check ( "calls", calls, count );
+   for ( unsigned i = 0; ( i < count ) && ( i < calls ); i++ )
+   {
+      check ( "values", sets[i].bits, expected[i][0] );
+      check ( "mask", sets[i].mask, expected[i][1] );
+
+      // EN falling after EN rising, the pulse width
+      if ( ( i > 0 ) && ( expected[i][1] == LINE_EN ) &&
+           ( expected[i][0] == 0 ) )
+      {
+         width = ( sets[i].time.tv_sec - sets[i - 1].time.tv_sec ) *
+                 1000000000L +
+                 ( sets[i].time.tv_nsec - sets[i - 1].time.tv_nsec );
+         check ( "EN pulse long enough", width >= LCDGPIO_PULSE_TIME, 1 );
+      }
+   }
+
+   printf ( "%u checks failed\n", failed );
+   return ( failed != 0 );
+}
@@ -0,0 +1,119 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file test_hooks.cpp
+// This file checks the transaction hooks of LCD (@see LCD::setHooks).
+//
+// @brief
+// Built with LCD_HOOKS, on a simulated LCD: begin must report the power up
+// wait and the waits of the initialisation sequence, and every wait the
+// driver makes must be reported, so the waits reported add up to the time
+// the simulator was kept busy waiting. Starts and ends must pair up.
+//
+// ---------------------------------------------------------------------------
+#include <stdio.h>
+
+#include "LCDSimulator.h"
+
+#ifndef LCD_HOOKS
+#error "test_hooks must be built with LCD_HOOKS"
+#endif
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+#define SEND_TIME     40
+#define INIT_WAITS    ( 4500 + 3 * 150 + 60 )
+
+// CLASS VARIABLES
+// ---------------------------------------------------------------------------
+static unsigned      failed;
+static unsigned      open;                   // started, not ended
+static unsigned long count[5];               // per LCD_OP_xxx
+static unsigned long size[5];
+
+static void check ( bool ok, const char *what )
+{
+   if ( !ok )
+   {
+      printf ( "FAIL %s\n", what );
+      failed++;
+   }
+}
+
+static void hookStart ( uint8_t kind, uint16_t value )
+{
+   check ( open == 0, "nested operation" );
+   check ( kind <= LCD_OP_POWER_UP, "unknown operation" );
+   open++;
+}
+
+static void hookEnd ( uint8_t kind, uint16_t value )
+{
+   check ( open == 1, "end without a start" );
+   open = 0;
+   count[kind]++;
+   size[kind] += value;
+}
+
+static void reset ( void )
+{
+   for ( uint8_t kind = 0; kind <= LCD_OP_POWER_UP; kind++ )
+   {
+      count[kind] = 0;
+      size[kind]  = 0;
+   }
+}
+
+int main ( void )
+{
+   LCDSimulator  lcd ( SEND_TIME );
+   unsigned long waited;
+   uint8_t       smiley[8] = { 0, 10, 0, 4, 17, 14, 0, 0 };
+
+   lcd.setHooks ( hookStart, hookEnd );
+
+   // begin: the power up, then the initialisation waits and clear's
+   lcd.begin ( 20, 4 );
+   check ( count[LCD_OP_POWER_UP] == 1, "begin: power up not reported" );
+   check ( size[LCD_OP_POWER_UP] == 100, "begin: power up time" );
+   check ( size[LCD_OP_WAIT] == INIT_WAITS + HOME_CLEAR_EXEC,
+           "begin: initialisation waits not reported" );
+   waited = lcd.busTime ( ) - lcd.sends ( ) * SEND_TIME;
+   check ( size[LCD_OP_WAIT] == waited, "begin: waits missed" );
+   printf ( "begin: %lu ms power up, %lu waits of %lu us, %lu commands\n",
+            size[LCD_OP_POWER_UP], count[LCD_OP_WAIT], size[LCD_OP_WAIT],
+            count[LCD_OP_COMMAND] );
+
+   // clear, print and createChar
+   reset ( );
+   lcd.resetCounters ( );
+   lcd.clear ( );
+   lcd.print ( "Hi" );
+   lcd.createChar ( 0, smiley );
+   waited = lcd.busTime ( ) - lcd.sends ( ) * SEND_TIME;
+   check ( size[LCD_OP_WAIT] == waited, "waits missed" );
+   check ( count[LCD_OP_COMMAND] + count[LCD_OP_DATA] == lcd.sends ( ),
+           "sends missed" );
+   check ( count[LCD_OP_POWER_UP] == 0, "power up outside of begin" );
+   printf ( "%lu commands, %lu characters, %lu waits of %lu us\n",
+            count[LCD_OP_COMMAND], count[LCD_OP_DATA], count[LCD_OP_WAIT],
+            size[LCD_OP_WAIT] );
+
+   // No hooks
+   reset ( );
+   lcd.setHooks ( 0, 0 );
+   lcd.clear ( );
+   check ( count[LCD_OP_COMMAND] + count[LCD_OP_WAIT] == 0,
+           "hooks called once removed" );
+
+   check ( open == 0, "operation not ended" );
+   printf ( "%u checks failed\n", failed );
+   return ( failed != 0 );
+}
@@ -0,0 +1,180 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file test_i2c_linux.cpp
+// This file checks the I2C messages of LiquidCrystal_I2C_Linux on a stand in
+// for the i2c-dev device node (@see t_linuxIO).
+//
+// @brief
+// The stand in records the I2C_RDWR messages and the simulated time they
+// are sent at. The expander writes are decoded back into the LCD bytes:
+// - a string of 20 characters is one message of 80 expander writes, each
+//   character latched long enough after the previous one for the LCD to
+//   execute it at the bus clock (built at 100kHz and 400kHz),
+// - clear sends what is queued before waiting for the LCD, in a batch too.
+//
+// ---------------------------------------------------------------------------
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+#include "LiquidCrystal_I2C_Linux.h"
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+#define ADDRESS      0x27
+#define FD           3
+#define MAX_CALLS    64
+
+// Pin mapping of the constructor
+#define PIN_EN       0x04
+#define PIN_RS       0x01
+#define PIN_BL       0x08
+
+// CLASS VARIABLES
+// ---------------------------------------------------------------------------
+typedef struct
+{
+   uint16_t      addr;
+   uint16_t      len;
+   uint8_t       buf[LCDI2CL_BUFFER_SIZE];
+   unsigned long time;                      // micros() when sent
+} t_message;
+
+static t_message messages[MAX_CALLS];
+static unsigned  calls;
+static unsigned  failed;
+
+static int mockOpen ( const char *path, int flags )
+{
+   return ( FD );
+}
+
+static int mockClose ( int fd )
+{
+   return ( 0 );
+}
+
+static int mockIoctl ( int fd, unsigned long request, void *arg )
+{
+   struct i2c_rdwr_ioctl_data *data = (struct i2c_rdwr_ioctl_data *)arg;
+
+   if ( ( fd != FD ) || ( request != I2C_RDWR ) || ( data->nmsgs != 1 ) ||
+        ( calls >= MAX_CALLS ) )
+   {
+      printf ( "FAIL unexpected ioctl 0x%lX\n", request );
+      failed++;
+      return ( -1 );
+   }
+   messages[calls].addr = data->msgs[0].addr;
+   messages[calls].len  = data->msgs[0].len;
+   messages[calls].time = micros ( );
+   memcpy ( messages[calls].buf, data->msgs[0].buf, data->msgs[0].len );
+   calls++;
+   return ( 1 );
+}
+
+static const t_linuxIO mockIO = { mockOpen, mockClose, mockIoctl };
+
+// EN on the 2nd pin, RW 1st, RS 0, data on 4..7 and backlight on 3, the
+// usual mapping of the backpacks
+static LiquidCrystal_I2C_Linux lcd ( "/dev/i2c-1", ADDRESS, 2, 1, 0, 4, 5, 6,
+                                     7, 3, POSITIVE, mockIO );
+
+static void check ( const char *what, unsigned long value,
+                    unsigned long expected )
+{
+   if ( value != expected )
+   {
+      printf ( "FAIL %s: %lu, expected %lu\n", what, value, expected );
+      failed++;
+   }
+}
+
+// LCD byte sent by the 4 expander writes at buf, -1 if they are not two
+// enable pulses of the same register. rs is set to the register.
+static int decode ( const uint8_t *buf, bool &rs )
+{
+   if ( !( buf[0] & PIN_EN ) || ( buf[1] & PIN_EN ) ||
+        !( buf[2] & PIN_EN ) || ( buf[3] & PIN_EN ) ||
+        ( ( buf[0] ^ buf[1] ) != PIN_EN ) || ( ( buf[2] ^ buf[3] ) != PIN_EN ) ||
+        ( ( buf[0] ^ buf[2] ) & ( PIN_RS | PIN_BL ) ) )
+   {
+      return ( -1 );
+   }
+   rs = ( buf[0] & PIN_RS ) != 0;
+   return ( ( buf[0] & 0xF0 ) | ( buf[2] >> 4 ) );
+}
+
+int main ( void )
+{
+   const char    *text = "Hello, Raspberry Pi!";
+   unsigned long  start;
+   bool           rs;
+
+   lcd.begin ( 20, 4 );
+   lcd.backlight ( );
+
+   // A string in one message, 4 expander writes a character
+   calls = 0;
+   lcd.print ( text );
+   check ( "print, messages", calls, 1 );
+   check ( "print, address", messages[0].addr, ADDRESS );
+   check ( "print, length", messages[0].len, 4 * strlen ( text ) );
+   for ( unsigned i = 0; ( calls == 1 ) && ( text[i] != '\0' ); i++ )
+   {
+      check ( "print, character", decode ( &messages[0].buf[4 * i], rs ),
+              (uint8_t)text[i] );
+      check ( "print, data register", rs, true );
+   }
+
+   // The first nibble of a character is latched 2 expander writes after the
+   // previous character
+   check ( "print, execution time", 2 * LCDI2CL_BYTE_TIME >= LCD_EXEC_TIME,
+           true );
+   check ( "print, data cost", lcd.dataCost ( ), 4 * LCDI2CL_BYTE_TIME );
+
+   // clear is sent before the wait
+   calls = 0;
+   start = micros ( );
+   lcd.clear ( );
+   check ( "clear, messages", calls, 1 );
+   check ( "clear, sent at", messages[0].time, start );
+   check ( "clear, command", decode ( messages[0].buf, rs ), LCD_CLEARDISPLAY );
+   check ( "clear, command register", rs, false );
+   check ( "clear, waited", micros ( ) - start >= HOME_CLEAR_EXEC, true );
+
+   // In a batch, what is queued goes with it before the wait
+   calls = 0;
+   start = micros ( );
+   lcd.beginBatch ( );
+   lcd.setCursor ( 0, 1 );
+   lcd.write ( 'x' );
+   lcd.clear ( );
+   check ( "batch, messages before the end", calls, 1 );
+   lcd.write ( 'y' );
+   lcd.endBatch ( );
+   check ( "batch, messages", calls, 2 );
+   check ( "batch, sent at", messages[0].time, start );
+   check ( "batch, length", messages[0].len, 12 );
+   check ( "batch, cursor", decode ( messages[0].buf, rs ),
+           LCD_SETDDRAMADDR | 0x40 );
+   check ( "batch, character", decode ( &messages[0].buf[4], rs ), 'x' );
+   check ( "batch, clear", decode ( &messages[0].buf[8], rs ),
+           LCD_CLEARDISPLAY );
+   check ( "batch, after clear", messages[1].time - start >= HOME_CLEAR_EXEC,
+           true );
+   check ( "batch, last", decode ( messages[1].buf, rs ), 'y' );
+
+   printf ( "%u checks failed\n", failed );
+   return ( failed != 0 );
+}
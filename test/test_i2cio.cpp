@@ -0,0 +1,183 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file test_i2cio.cpp
+// This file checks the interrupt line support of I2CIO on a model of the
+// MCP23008 (@see I2CIO::setInterruptPin).
+//
+// @brief
+// The model keeps the registers of the chip and drives its INT output on
+// an MCU pin of the test core: interrupt on change from the previous value,
+// captured in INTCAP, cleared by reading GPIO or INTCAP. Writes are in
+// byte mode (IOCON.SEQOP), as I2CIO configures the chip.
+//
+// ---------------------------------------------------------------------------
+#include <stdio.h>
+
+#include <Arduino.h>
+#include <Wire.h>
+
+#include "I2CIO.h"
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+#define ADDRESS    0x20
+#define INT_PIN    12
+
+// CLASS VARIABLES
+// ---------------------------------------------------------------------------
+class MCP23008 : public TwoWireDevice
+{
+public:
+   MCP23008 ( void )
+   {
+      memset ( reg, 0, sizeof ( reg ) );
+      reg[MCP23008_IODIR] = 0xFF;
+      pointer = 0;
+      pins    = 0;
+      pending = false;
+      ::digitalWrite ( INT_PIN, HIGH );
+   }
+
+   uint8_t receive ( uint8_t address, const uint8_t *data, uint8_t length )
+   {
+      if ( address != ADDRESS )
+      {
+         return ( 2 );
+      }
+      if ( length > 0 )
+      {
+         pointer = data[0];
+      }
+      for ( uint8_t i = 1; i < length; i++ )
+      {
+         if ( pointer == MCP23008_GPIO )
+         {
+            reg[MCP23008_OLAT] = data[i];
+         }
+         else
+         {
+            reg[pointer] = data[i];
+         }
+      }
+      return ( 0 );
+   }
+
+   uint8_t request ( uint8_t address )
+   {
+      if ( ( pointer == MCP23008_GPIO ) || ( pointer == MCP23008_INTCAP ) )
+      {
+         clearInterrupt ( );
+      }
+      if ( pointer == MCP23008_GPIO )
+      {
+         return ( port ( ) );
+      }
+      return ( reg[pointer] );
+   }
+
+   // Levels applied to the input pins, pulled up if enabled and left open
+   void drive ( uint8_t levels )
+   {
+      uint8_t before = port ( );
+
+      pins = levels;
+      if ( ( ( before ^ port ( ) ) & reg[MCP23008_GPINTEN] ) && !pending )
+      {
+         reg[MCP23008_INTF]   = ( before ^ port ( ) ) & reg[MCP23008_GPINTEN];
+         reg[MCP23008_INTCAP] = port ( );
+         pending = true;
+         ::digitalWrite ( INT_PIN, LOW );
+      }
+   }
+
+   uint8_t reg[MCP23008_OLAT + 1];
+
+private:
+   uint8_t port ( void )
+   {
+      uint8_t inputs = reg[MCP23008_IODIR];
+
+      return ( ( pins & inputs ) | ( reg[MCP23008_OLAT] & ~inputs ) );
+   }
+
+   void clearInterrupt ( void )
+   {
+      reg[MCP23008_INTF] = 0;
+      pending = false;
+      ::digitalWrite ( INT_PIN, HIGH );
+   }
+
+   uint8_t pointer;   // Register addressed
+   uint8_t pins;      // Levels on the pins
+   bool    pending;   // INT asserted
+};
+
+static unsigned failed = 0;
+
+static void check ( const char *what, unsigned value, unsigned expected )
+{
+   if ( value != expected )
+   {
+      printf ( "FAIL %s: 0x%02X, expected 0x%02X\n", what, value, expected );
+      failed++;
+   }
+}
+
+int main ( void )
+{
+   MCP23008 chip;
+   I2CIO    io;
+
+   Wire.attach ( &chip );
+
+   // Set before begin, applied by begin. No pull-ups unless asked for.
+   io.setInterruptPin ( INT_PIN, 0x0F );
+   check ( "GPINTEN before begin", chip.reg[MCP23008_GPINTEN], 0x00 );
+   io.begin ( ADDRESS, 0 );
+   check ( "GPINTEN after begin", chip.reg[MCP23008_GPINTEN], 0x0F );
+   check ( "GPPU by default", chip.reg[MCP23008_GPPU], 0x00 );
+
+   // Outputs are removed from the configuration, inputs added back
+   io.pinMode ( 0, OUTPUT );
+   check ( "GPINTEN pin 0 output", chip.reg[MCP23008_GPINTEN], 0x0E );
+   io.portMode ( OUTPUT );
+   check ( "GPINTEN port output", chip.reg[MCP23008_GPINTEN], 0x00 );
+   io.portMode ( INPUT );
+   check ( "GPINTEN port input", chip.reg[MCP23008_GPINTEN], 0x0F );
+
+   io.setInterruptPin ( INT_PIN, 0x0F, 0x03 );
+   check ( "GPPU asked for", chip.reg[MCP23008_GPPU], 0x03 );
+   io.pinMode ( 1, OUTPUT );
+   check ( "GPPU pin 1 output", chip.reg[MCP23008_GPPU], 0x01 );
+   check ( "GPINTEN pin 1 output", chip.reg[MCP23008_GPINTEN], 0x0D );
+   io.pinMode ( 1, INPUT );
+
+   // No change, no bus access: the value read first is kept
+   check ( "idle", io.digitalRead ( 2 ), LOW );
+
+   // A pulse over before the read is seen once, then its end
+   chip.drive ( 0x04 );
+   chip.drive ( 0x00 );
+   check ( "pulse", io.digitalRead ( 2 ), HIGH );
+   check ( "after pulse", io.digitalRead ( 2 ), LOW );
+
+   // A level change stays
+   chip.drive ( 0x08 );
+   check ( "level", io.digitalRead ( 3 ), HIGH );
+   check ( "level again", io.digitalRead ( 3 ), HIGH );
+
+   // Releasing the line turns the interrupt output off
+   io.setInterruptPin ( I2CIO_NO_INT );
+   check ( "GPINTEN released", chip.reg[MCP23008_GPINTEN], 0x00 );
+
+   printf ( "%u checks failed\n", failed );
+   return ( failed != 0 );
+}
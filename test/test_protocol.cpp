@@ -0,0 +1,207 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file test_protocol.cpp
+// This file checks the binary display protocol end to end: LCDEncoder
+// frames decoded by LCDDecoder into a simulated HD44780 (@see LCDProtocol.h).
+//
+// @brief
+// For several display sizes, a sequence of random screens (new screens, a
+// few characters changed, runs of a character) is encoded, the frames fed
+// to the decoder and the simulated display compared with the screen. Along
+// the way:
+// - a byte of the frames of some screens is corrupted: the decoder counts
+//   an error and leaves the display as it was, the encoder is invalidated
+//   and the next screen is sent whole,
+// - an encoder made for 40x4 encodes the top 40x2 and doesn't write past
+//   its screen copy.
+//
+// ---------------------------------------------------------------------------
+#include <stdio.h>
+#include <string.h>
+#include <new>
+
+#include "LCDSimulator.h"
+#include "LCDEncoder.h"
+#include "LCDDecoder.h"
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+#define SCREENS       2000
+#define CORRUPT_ONE   16        // one screen in CORRUPT_ONE is corrupted
+#define GUARD         0x5A
+
+static const uint8_t sizes[][2] =
+{
+   { 8, 1 }, { 16, 1 }, { 16, 2 }, { 20, 2 }, { 20, 4 }, { 40, 2 }, { 40, 4 }
+};
+
+// CLASS VARIABLES
+// ---------------------------------------------------------------------------
+
+// The encoder followed by a guard to catch writes past its screen copy
+static struct
+{
+   alignas ( LCDEncoder ) uint8_t encoder[sizeof ( LCDEncoder )];
+   uint8_t guard[2 * LCDP_MAX_CELLS];
+} memory;
+
+static uint32_t seed = 2463534242UL;
+static unsigned failed;
+
+// Same sequence on every run (xorshift)
+static uint32_t next ( uint32_t range )
+{
+   seed ^= seed << 13;
+   seed ^= seed >> 17;
+   seed ^= seed << 5;
+   return ( seed % range );
+}
+
+// Next screen of the sequence
+static void change ( uint8_t *screen, uint16_t cells )
+{
+   uint8_t  what  = next ( 8 );
+   uint16_t count = 1 + next ( 4 );
+
+   if ( what == 0 )
+   {
+      // Anything, blanks more often
+      for ( uint16_t i = 0; i < cells; i++ )
+      {
+         screen[i] = next ( 3 ) ? ' ' + next ( 95 ) : ' ';
+      }
+   }
+   else if ( what == 1 )
+   {
+      // A run of a character, longer than a record
+      uint16_t from   = next ( cells );
+      uint16_t length = 1 + next ( 2 * LCDP_MAX_RUN );
+      uint8_t  value  = ' ' + next ( 95 );
+
+      for ( uint16_t i = from; ( i < cells ) && ( i < from + length ); i++ )
+      {
+         screen[i] = value;
+      }
+   }
+   else
+   {
+      // A few characters
+      while ( count-- > 0 )
+      {
+         screen[next ( cells )] = ' ' + next ( 95 );
+      }
+   }
+}
+
+static bool shows ( LCDSimulator &lcd, const uint8_t *screen, uint8_t cols,
+                    uint8_t rows )
+{
+   for ( uint8_t row = 0; row < rows; row++ )
+   {
+      for ( uint8_t col = 0; col < cols; col++ )
+      {
+         if ( lcd.charAt ( col, row ) != screen[row * cols + col] )
+         {
+            return ( false );
+         }
+      }
+   }
+   return ( true );
+}
+
+static void check ( bool ok, const char *what, uint8_t cols, uint8_t rows,
+                    unsigned screen )
+{
+   if ( !ok )
+   {
+      printf ( "FAIL %ux%u screen %u: %s\n", cols, rows, screen, what );
+      failed++;
+   }
+}
+
+int main ( void )
+{
+   uint8_t screen[LCDP_MAX_COLS * LCDP_MAX_ROWS];
+   uint8_t frames[LCDP_MAX_ENCODED];
+
+   for ( uint8_t i = 0; i < sizeof ( sizes ) / sizeof ( sizes[0] ); i++ )
+   {
+      uint8_t       cols  = sizes[i][0];
+      uint8_t       rows  = sizes[i][1];
+      uint8_t       shown = ( cols * rows > LCDP_MAX_CELLS ) ?
+                            LCDP_MAX_CELLS / cols : rows;
+      uint16_t      cells = cols * rows;
+      unsigned long bytes = 0;
+      unsigned      corrupted = 0;
+      LCDSimulator  lcd;
+      LCDEncoder   *encoder;
+      LCDDecoder    decoder ( lcd, cols, shown );
+      uint8_t       guard[sizeof ( memory.guard )];
+
+      memset ( memory.guard, GUARD, sizeof ( memory.guard ) );
+      memset ( guard, GUARD, sizeof ( guard ) );
+      encoder = new ( memory.encoder ) LCDEncoder ( cols, rows );
+      lcd.begin ( cols, shown );
+      memset ( screen, ' ', sizeof ( screen ) );
+
+      for ( unsigned n = 0; ( n < SCREENS ) && ( failed < 10 ); n++ )
+      {
+         uint8_t  before[LCDP_MAX_CELLS];
+         uint16_t length;
+
+         change ( screen, cells );
+         length = encoder->encode ( screen, frames, sizeof ( frames ) );
+         bytes += length;
+         check ( length <= sizeof ( frames ), "encoded too long", cols, rows,
+                 n );
+
+         if ( ( next ( CORRUPT_ONE ) == 0 ) && ( length > 0 ) &&
+              ( length <= LCDP_MAX_PAYLOAD + 3 ) )
+         {
+            // Any payload byte: the checksum catches it
+            uint8_t errors = decoder.errors ( );
+
+            for ( uint8_t j = 0; j < cols * shown; j++ )
+            {
+               before[j] = lcd.charAt ( j % cols, j / cols );
+            }
+            frames[2 + next ( length - 3 )] ^= 1 << next ( 8 );
+            for ( uint16_t j = 0; j < length; j++ )
+            {
+               decoder.feed ( frames[j] );
+            }
+            check ( decoder.errors ( ) == ( uint8_t )( errors + 1 ),
+                    "corrupted frame not counted", cols, rows, n );
+            check ( shows ( lcd, before, cols, shown ),
+                    "corrupted frame applied", cols, rows, n );
+
+            // Sent again whole
+            encoder->invalidate ( );
+            length = encoder->encode ( screen, frames, sizeof ( frames ) );
+            corrupted++;
+         }
+
+         for ( uint16_t j = 0; j < length; j++ )
+         {
+            decoder.feed ( frames[j] );
+         }
+         check ( shows ( lcd, screen, cols, shown ), "display differs", cols,
+                 rows, n );
+         check ( memcmp ( memory.guard, guard, sizeof ( guard ) ) == 0,
+                 "written past the screen copy", cols, rows, n );
+      }
+      printf ( "%ux%u: %u rows shown, %u screens in %lu bytes, %u corrupted\n",
+               cols, rows, shown, SCREENS, bytes, corrupted );
+   }
+
+   printf ( "%u checks failed\n", failed );
+   return ( failed != 0 );
+}
@@ -0,0 +1,158 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file test_queue.cpp
+// This file checks the ring of LCDQueue with a producer and a consumer
+// thread (@see LCDQueue).
+//
+// @brief
+// The ring is built alone, without the LCD nor the Arduino core. The
+// producer posts numbered operations, the consumer checks it pops them all
+// once and in order:
+// - retrying posts while the queue is full, nothing is lost,
+// - without retrying, the operations posted are popped, the others are
+//   lost.
+// Every post refused is counted as dropped.
+//
+// ---------------------------------------------------------------------------
+#include <stdio.h>
+#include <thread>
+
+#include "LCDQueue.h"
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+#define OPERATIONS    1000000L
+
+// CLASS VARIABLES
+// ---------------------------------------------------------------------------
+static LCDQueue queue;
+static long     posted;               // Operations the queue took
+static long     refused;              // Posts the queue refused
+
+static void produce ( bool retry )
+{
+   t_lcdOp op;
+
+   op.op  = LCDQ_NUMBER;
+   op.col = 0;
+   op.row = 0;
+   op.arg = 0;
+   for ( long i = 0; i < OPERATIONS; i++ )
+   {
+      op.data.number = i;
+      // The row carries a check of the number, a torn slot shows
+      op.row = (uint8_t)( i * 7 );
+      for ( ;; )
+      {
+         if ( queue.post ( op ) )
+         {
+            posted++;
+            break;
+         }
+         refused++;
+         std::this_thread::yield ( );
+         if ( !retry )
+         {
+            break;
+         }
+      }
+   }
+   // End of the test
+   op.op = LCDQ_BACKLIGHT;
+   while ( !queue.post ( op ) )
+   {
+      refused++;
+      std::this_thread::yield ( );
+   }
+}
+
+// Pops up to the end mark, returns the number of errors
+static long consume ( long &popped )
+{
+   t_lcdOp op;
+   long    last = -1;
+   long    errors = 0;
+
+   popped = 0;
+   for ( ;; )
+   {
+      if ( !queue.pop ( op ) )
+      {
+         std::this_thread::yield ( );
+         continue;
+      }
+      if ( op.op == LCDQ_BACKLIGHT )
+      {
+         return ( errors );
+      }
+      if ( ( op.data.number <= last ) ||
+           ( op.row != (uint8_t)( op.data.number * 7 ) ) )
+      {
+         if ( errors++ < 10 )
+         {
+            printf ( "FAIL popped %ld after %ld\n", op.data.number, last );
+         }
+      }
+      last = op.data.number;
+      popped++;
+   }
+}
+
+static unsigned run ( bool retry )
+{
+   long        popped;
+   long        errors;
+   uint8_t     dropped = queue.dropped ( );
+   unsigned    failed = 0;
+
+   posted  = 0;
+   refused = 0;
+   std::thread producer ( produce, retry );
+   errors = consume ( popped );
+   producer.join ( );
+
+   if ( errors != 0 )
+   {
+      printf ( "FAIL %ld operations out of order or torn\n", errors );
+      failed++;
+   }
+   if ( popped != posted )
+   {
+      printf ( "FAIL %ld operations posted, %ld popped\n", posted, popped );
+      failed++;
+   }
+   if ( retry && ( posted != OPERATIONS ) )
+   {
+      printf ( "FAIL %ld operations lost\n", OPERATIONS - posted );
+      failed++;
+   }
+   // The count is 8 bits, it wraps
+   if ( (uint8_t)( queue.dropped ( ) - dropped ) != (uint8_t)refused )
+   {
+      printf ( "FAIL %ld posts refused, %u counted as dropped\n",
+               refused, (uint8_t)( queue.dropped ( ) - dropped ) );
+      failed++;
+   }
+   printf ( "%s: %ld posted, %ld popped, %ld posts refused\n",
+            retry ? "retry" : "drop", posted, popped, refused );
+   return ( failed );
+}
+
+int main ( void )
+{
+   unsigned failed = 0;
+
+   failed += run ( true );
+   failed += run ( false );
+
+   printf ( "%u checks failed\n", failed );
+   return ( failed != 0 );
+}
@@ -0,0 +1,191 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file test_replay.cpp
+// This file checks that a session recorded by LCDRecorder replays the same
+// with LCDReplay (@see LCDRecorder, LCDReplay).
+//
+// @brief
+// The session is the random calls of LCDEquivalence made on a recorder in
+// front of a simulated LCD, with pauses in between. The log is replayed:
+// - on a simulated LCD: same DDRAM, CGRAM, display control, address
+//   counter, backlight and number of sends as the recorded one,
+// - through LiquidCrystal_Buffer: same characters shown and CGRAM,
+// - with the original pauses: the replay takes the recorded time.
+// A log cut within its last record or with an unknown record is reported
+// as such.
+//
+// ---------------------------------------------------------------------------
+#include <stdio.h>
+#include <string.h>
+
+#include "LCDSimulator.h"
+#include "LCDEquivalence.h"
+#include "LCDRecorder.h"
+#include "LCDReplay.h"
+#include "LiquidCrystal_Buffer.h"
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+#define COLS          20
+#define ROWS          4
+#define RUNS          20
+#define STEPS         200
+#define MAX_LOG       65536
+
+// CLASS VARIABLES
+// ---------------------------------------------------------------------------
+
+// A log in memory
+class MemoryLog : public Print
+{
+public:
+   MemoryLog ( void ) : size ( 0 ) { }
+   size_t write ( uint8_t value )
+   {
+      if ( size == sizeof ( data ) )
+      {
+         return ( 0 );
+      }
+      data[size++] = value;
+      return ( 1 );
+   }
+   using Print::write;
+
+   uint8_t data[MAX_LOG];
+   size_t  size;
+};
+
+static MemoryLog log;
+static unsigned  failed;
+
+static void check ( bool ok, const char *what )
+{
+   if ( !ok )
+   {
+      printf ( "FAIL %s\n", what );
+      failed++;
+   }
+}
+
+// Same state as the LCD recorded
+static void same ( LCDSimulator &lcd, LCDSimulator &recorded,
+                   const char *what )
+{
+   char text[64];
+
+   snprintf ( text, sizeof ( text ), "%s: DDRAM", what );
+   check ( memcmp ( lcd.ddram ( ), recorded.ddram ( ),
+                    LCDSIM_DDRAM_SIZE ) == 0, text );
+   snprintf ( text, sizeof ( text ), "%s: CGRAM", what );
+   check ( memcmp ( lcd.cgram ( ), recorded.cgram ( ),
+                    LCDSIM_CGRAM_SIZE ) == 0, text );
+   snprintf ( text, sizeof ( text ), "%s: display control", what );
+   check ( lcd.control ( ) == recorded.control ( ), text );
+   snprintf ( text, sizeof ( text ), "%s: address counter", what );
+   check ( lcd.addressCounter ( ) == recorded.addressCounter ( ), text );
+   snprintf ( text, sizeof ( text ), "%s: backlight", what );
+   check ( lcd.backlightValue ( ) == recorded.backlightValue ( ), text );
+}
+
+int main ( void )
+{
+   LCDSimulator   recorded;
+   LCDSimulator   reference;
+   LCDRecorder    recorder ( recorded, log );
+   LCDEquivalence session ( recorder, recorded, reference );
+   LCDSimulator   begun;
+   unsigned long  elapsed;
+   unsigned long  beginTime;
+   unsigned long  start;
+
+   // The sends and the time of begin: LCDEquivalence doesn't count the
+   // sends and begins the reference LCD too
+   start = millis ( );
+   begun.begin ( COLS, ROWS );
+   beginTime = millis ( ) - start;
+
+   // Record, with pauses
+   start = millis ( );
+   session.begin ( COLS, ROWS );
+   for ( uint32_t seed = 1; seed <= RUNS; seed++ )
+   {
+      check ( session.run ( STEPS, seed ), "recorder not transparent" );
+      delay ( seed * 7 );
+   }
+   recorder.print ( "end" );
+   elapsed = millis ( ) - start - beginTime;
+   printf ( "%u calls recorded in %lu bytes\n", RUNS * STEPS,
+            (unsigned long)log.size );
+   check ( log.size < sizeof ( log.data ), "log full" );
+
+   // On a simulated LCD
+   {
+      LCDSimulator lcd;
+      LCDReplay    replay ( lcd );
+
+      check ( replay.play ( log.data, log.size ), "replay incomplete" );
+      same ( lcd, recorded, "replayed" );
+      check ( lcd.sends ( ) == begun.sends ( ) + recorded.sends ( ),
+              "replayed: sends" );
+      check ( replay.duration ( ) == elapsed, "replayed: duration" );
+      printf ( "%lu operations, %lu ms\n", replay.operations ( ),
+               replay.duration ( ) );
+   }
+
+   // Through LiquidCrystal_Buffer
+   {
+      LCDSimulator         lcd;
+      LiquidCrystal_Buffer buffer ( lcd );
+      LCDReplay            replay ( buffer );
+      bool                 shown = true;
+
+      check ( replay.play ( log.data, log.size ), "buffer: replay incomplete" );
+      buffer.flush ( );
+      for ( uint8_t row = 0; row < ROWS; row++ )
+      {
+         for ( uint8_t col = 0; col < COLS; col++ )
+         {
+            shown &= ( lcd.charAt ( col, row ) == recorded.charAt ( col, row ) );
+         }
+      }
+      check ( shown, "buffer: characters shown" );
+      check ( memcmp ( lcd.cgram ( ), recorded.cgram ( ),
+                       LCDSIM_CGRAM_SIZE ) == 0, "buffer: CGRAM" );
+      printf ( "through the buffer: %lu sends, %lu recorded\n", lcd.sends ( ),
+               begun.sends ( ) + recorded.sends ( ) );
+   }
+
+   // With the original pauses
+   {
+      LCDSimulator lcd;
+      LCDReplay    replay ( lcd );
+
+      start = millis ( );
+      check ( replay.play ( log.data, log.size, true ), "timed: incomplete" );
+      check ( millis ( ) - start >= elapsed, "timed: pauses" );
+      same ( lcd, recorded, "timed" );
+   }
+
+   // Cut within the last record, "end", and an unknown record
+   {
+      LCDSimulator lcd;
+      LCDReplay    replay ( lcd );
+
+      check ( replay.play ( log.data, log.size - 1 ) == 0,
+              "cut log not reported" );
+      log.data[log.size - 4] = 0xE0;
+      check ( replay.play ( log.data, log.size ) == 0,
+              "unknown record not reported" );
+   }
+
+   printf ( "%u checks failed\n", failed );
+   return ( failed != 0 );
+}
@@ -0,0 +1,281 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file test_service.cpp
+// This file checks LCDService with several producer threads on a simulated
+// LCD (@see LCDService).
+//
+// @brief
+// Stress: each producer prints numbered texts on its own row, sets the
+// backlight now and then and waits for some of its tokens. Tokens are
+// never 0, increase in posting order and are never given twice; a token
+// waited for is done. Once the producers are finished, each row shows the
+// last text of its producer.
+//
+// Shutdown: producers post as fast as they can while the worker is held
+// busy, so they block on the full queue, and the service is ended. Every
+// producer has to return before the worker is let go, every token given
+// has to be done once end returns and posting afterwards fails.
+//
+// ---------------------------------------------------------------------------
+#include <stdio.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "LCDSimulator.h"
+#include "LCDService.h"
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+#define PRODUCERS     4
+#define OPERATIONS    2000
+#define WAIT_EVERY    50
+#define COLS          20
+#define ROWS          4
+#define TIMEOUT_MS    10000
+
+// CLASS VARIABLES
+// ---------------------------------------------------------------------------
+
+// An LCD taking real time for each byte, slower than the producers
+class SlowLCD : public LCDSimulator
+{
+public:
+   virtual void send ( uint8_t value, uint8_t mode )
+   {
+      LCDSimulator::send ( value, mode );
+      std::this_thread::sleep_for ( std::chrono::microseconds ( 20 ) );
+   }
+};
+
+// An LCD the test holds busy, the worker stops in the middle of a frame
+class HeldLCD : public LCDSimulator
+{
+public:
+   HeldLCD ( void ) : hold ( false ) { }
+
+   virtual void send ( uint8_t value, uint8_t mode )
+   {
+      while ( hold )
+      {
+         std::this_thread::sleep_for ( std::chrono::microseconds ( 100 ) );
+      }
+      LCDSimulator::send ( value, mode );
+   }
+
+   std::atomic<bool> hold;
+};
+
+static std::atomic<unsigned> failed ( 0 );
+
+static void fail ( const char *what, long value )
+{
+   if ( failed++ < 10 )
+   {
+      printf ( "FAIL %s: %ld\n", what, value );
+   }
+}
+
+static void text ( char *buffer, int producer, int i )
+{
+   snprintf ( buffer, COLS + 1, "%d:%018d", producer, i );
+}
+
+static void produce ( LCDService *service, int producer,
+                      std::vector<uint32_t> *tokens )
+{
+   char     buffer[COLS + 1];
+   uint32_t token;
+   uint32_t last = 0;
+
+   for ( int i = 0; i < OPERATIONS; i++ )
+   {
+      if ( i % 100 == 99 )
+      {
+         token = service->setBacklight ( i & 0x100 );
+      }
+      else
+      {
+         text ( buffer, producer, i );
+         token = service->print ( 0, producer, buffer );
+      }
+      if ( token == 0 )
+      {
+         fail ( "token 0 while running", i );
+         continue;
+      }
+      if ( ( last != 0 ) && ( (int32_t)( token - last ) <= 0 ) )
+      {
+         fail ( "token out of order", token );
+      }
+      last = token;
+      tokens->push_back ( token );
+      if ( i % WAIT_EVERY == 0 )
+      {
+         service->wait ( token );
+         if ( !service->done ( token ) )
+         {
+            fail ( "not done after wait", token );
+         }
+      }
+   }
+   text ( buffer, producer, OPERATIONS - 1 );
+   service->wait ( service->print ( 0, producer, buffer ) );
+}
+
+static void stress ( void )
+{
+   SlowLCD                lcd;
+   LCDService             service ( lcd );
+   std::vector<uint32_t>  tokens[PRODUCERS];
+   std::vector<uint32_t>  all;
+   std::thread            producers[PRODUCERS];
+   char                   expected[COLS + 1];
+
+   service.begin ( COLS, ROWS, 1 );
+   for ( int p = 0; p < PRODUCERS; p++ )
+   {
+      producers[p] = std::thread ( produce, &service, p, &tokens[p] );
+   }
+   for ( int p = 0; p < PRODUCERS; p++ )
+   {
+      producers[p].join ( );
+      all.insert ( all.end ( ), tokens[p].begin ( ), tokens[p].end ( ) );
+   }
+   service.end ( );
+
+   std::sort ( all.begin ( ), all.end ( ) );
+   if ( std::adjacent_find ( all.begin ( ), all.end ( ) ) != all.end ( ) )
+   {
+      fail ( "token given twice", *std::adjacent_find ( all.begin ( ),
+                                                        all.end ( ) ) );
+   }
+   for ( int p = 0; p < PRODUCERS; p++ )
+   {
+      text ( expected, p, OPERATIONS - 1 );
+      for ( int col = 0; col < COLS; col++ )
+      {
+         if ( lcd.charAt ( col, p ) != (uint8_t)expected[col] )
+         {
+            fail ( "last text not on the display, row", p );
+            break;
+         }
+      }
+   }
+   printf ( "stress: %u tokens, %lu bytes sent\n", (unsigned)all.size ( ),
+            lcd.sends ( ) );
+}
+
+static std::atomic<int> returned ( 0 );
+
+static void flood ( LCDService *service, int producer,
+                    std::vector<uint32_t> *tokens )
+{
+   char     buffer[COLS + 1];
+   uint32_t token;
+
+   for ( int i = 0; ; i++ )
+   {
+      text ( buffer, producer, i );
+      token = service->print ( 0, producer, buffer );
+      if ( token == 0 )
+      {
+         break;
+      }
+      tokens->push_back ( token );
+   }
+   returned++;
+}
+
+static void stop ( LCDService *service )
+{
+   service->end ( );
+}
+
+static void shutdown ( void )
+{
+   HeldLCD                lcd;
+   LCDService             service ( lcd );
+   std::vector<uint32_t>  tokens[PRODUCERS];
+   std::thread            producers[PRODUCERS];
+   std::thread            stopper;
+   unsigned               given = 0;
+   t_lcdSvcOp             op;
+
+   service.begin ( COLS, ROWS, 1 );
+   lcd.hold = true;
+   for ( int p = 0; p < PRODUCERS; p++ )
+   {
+      producers[p] = std::thread ( flood, &service, p, &tokens[p] );
+   }
+
+   // The worker is held in its first frame, the queue fills up and the
+   // producers block. end has to release them while the worker is busy.
+   std::this_thread::sleep_for ( std::chrono::milliseconds ( 50 ) );
+   op.op  = LCDSVC_CLEAR;
+   op.col = 0;
+   op.row = 0;
+   op.arg = 0;
+   if ( service.post ( op, false ) != 0 )
+   {
+      fail ( "posted without blocking to a full queue", 0 );
+   }
+   stopper = std::thread ( stop, &service );
+   for ( int ms = 0; ( returned < PRODUCERS ) && ( ms < TIMEOUT_MS ); ms++ )
+   {
+      std::this_thread::sleep_for ( std::chrono::milliseconds ( 1 ) );
+   }
+   if ( returned < PRODUCERS )
+   {
+      printf ( "FAIL %d producers blocked after end\n",
+               PRODUCERS - returned );
+      fflush ( stdout );
+      _exit ( 1 );
+   }
+   lcd.hold = false;
+   stopper.join ( );
+
+   for ( int p = 0; p < PRODUCERS; p++ )
+   {
+      producers[p].join ( );
+      for ( size_t i = 0; i < tokens[p].size ( ); i++ )
+      {
+         if ( !service.done ( tokens[p][i] ) )
+         {
+            fail ( "posted before end, not done", tokens[p][i] );
+         }
+      }
+      given += tokens[p].size ( );
+   }
+   if ( given == 0 )
+   {
+      fail ( "nothing posted before end", 0 );
+   }
+
+   if ( ( service.post ( op ) != 0 ) || ( service.post ( op, false ) != 0 ) ||
+        ( service.print ( 0, 0, "late" ) != 0 ) )
+   {
+      fail ( "posted after end", 0 );
+   }
+   printf ( "shutdown: %u tokens done\n", given );
+}
+
+int main ( void )
+{
+   stress ( );
+   shutdown ( );
+
+   printf ( "%u checks failed\n", (unsigned)failed );
+   return ( failed != 0 );
+}
@@ -0,0 +1,301 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file test_si2c.cpp
+// This file checks the bus LiquidCrystal_SI2C clocks out through the FastIO
+// write only I2C master (@see fio_i2cWrite).
+//
+// @brief
+// The test provides the timing functions of the core: every wait records
+// the levels of SDA and SCL and how long they are held, which is all the
+// time there is on the bus. From that record the bus is decoded (start,
+// bytes, acknowledge clocks, stop) and its timing checked against the
+// I2C specification for FIO_I2C_KHZ: standard mode up to 100kHz, fast mode
+// above:
+// - SCL HIGH and LOW times, start and stop setup and hold times, bus free
+//   time between a stop and a start,
+// - the bytes of a character write on a PCF8574 backpack,
+// - at least LCD_EXEC_TIME between the enable falling edge and the next
+//   enable pulse,
+// - a send within maxSendTime.
+//
+// Built once at the default rate and once at 400kHz, where the bus alone is
+// faster than the LCD.
+//
+// ---------------------------------------------------------------------------
+#include <stdio.h>
+
+#include "LiquidCrystal_SI2C.h"
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+#define SDA           20
+#define SCL           21
+#define ADDRESS       0x27
+#define MAX_WAITS     20000
+#define MAX_BYTES     2000
+
+// Backpack pins: YwRobot wiring
+#define EN            0x04
+#define RS            0x01
+#define BL            0x08
+
+// Minimum times of the I2C specification (tenths of us)
+#if ( FIO_I2C_KHZ <= 100 )
+#define T_LOW         47
+#define T_HIGH        40
+#define T_SU_STA      47
+#define T_HD_STA      40
+#define T_SU_STO      40
+#define T_BUF         47
+#else
+#define T_LOW         13
+#define T_HIGH        6
+#define T_SU_STA      6
+#define T_HD_STA      6
+#define T_SU_STO      6
+#define T_BUF         13
+#endif
+
+// CLASS VARIABLES
+// ---------------------------------------------------------------------------
+typedef struct
+{
+   uint8_t       sda;
+   uint8_t       scl;
+   unsigned long time;                 // Time held (us)
+} t_wait;
+
+typedef struct
+{
+   uint8_t       value;
+   bool          first;                // First byte of a transaction
+   unsigned long end;                  // End of its acknowledge clock (us)
+} t_byte;
+
+static unsigned long now;
+static t_wait        waits[MAX_WAITS];
+static unsigned      numWaits;
+static t_byte        bytes[MAX_BYTES];
+static unsigned      numBytes;
+static unsigned      failed;
+
+static LiquidCrystal_SI2C lcd ( SDA, SCL, ADDRESS, IIC_BOARD_YWROBOT );
+
+static uint8_t level ( uint8_t pin )
+{
+   return ( ( testPorts[digitalPinToPort ( pin )] &
+              digitalPinToBitMask ( pin ) ) != 0 );
+}
+
+// The bus levels are held as long as the core waits
+void delayMicroseconds ( unsigned int us )
+{
+   uint8_t sda = level ( SDA );
+   uint8_t scl = level ( SCL );
+
+   now += us;
+   if ( ( numWaits > 0 ) && ( waits[numWaits - 1].sda == sda ) &&
+        ( waits[numWaits - 1].scl == scl ) )
+   {
+      waits[numWaits - 1].time += us;
+   }
+   else if ( numWaits < MAX_WAITS )
+   {
+      waits[numWaits].sda  = sda;
+      waits[numWaits].scl  = scl;
+      waits[numWaits].time = us;
+      numWaits++;
+   }
+}
+
+void delay ( unsigned long ms )
+{
+   delayMicroseconds ( ms * 1000UL );
+}
+
+unsigned long micros ( void )
+{
+   return ( now );
+}
+
+unsigned long millis ( void )
+{
+   return ( now / 1000UL );
+}
+
+static void fail ( const char *what, unsigned at, unsigned long time )
+{
+   if ( failed < 10 )
+   {
+      printf ( "FAIL %s: #%u, %lu us\n", what, at, time );
+   }
+   failed++;
+}
+
+static void atLeast ( const char *what, unsigned at, unsigned long time,
+                      unsigned long tenths )
+{
+   if ( time * 10 < tenths )
+   {
+      fail ( what, at, time );
+   }
+}
+
+// Decodes the waits recorded into bytes and checks the bus timing
+static void decode ( void )
+{
+   unsigned long time  = 0;
+   uint8_t       bits  = 0;
+   uint16_t      value = 0;
+   bool          inTransaction = false;
+   bool          first = false;
+
+   numBytes = 0;
+   for ( unsigned i = 0; i < numWaits; i++ )
+   {
+      const t_wait &wait = waits[i];
+      const t_wait *next = ( i + 1 < numWaits ) ? &waits[i + 1] : NULL;
+
+      time += wait.time;
+      if ( !wait.scl )
+      {
+         atLeast ( "SCL LOW", i, wait.time, T_LOW );
+         continue;
+      }
+
+      if ( ( next != NULL ) && next->scl && ( wait.sda != next->sda ) )
+      {
+         // SDA changing while SCL is HIGH: start or stop
+         if ( wait.sda )
+         {
+            atLeast ( inTransaction ? "repeated start setup" :
+                      "bus free / start setup", i, wait.time, T_SU_STA );
+            atLeast ( "start hold", i + 1, next->time, T_HD_STA );
+            inTransaction = true;
+            first = true;
+            time += next->time;
+            i++;
+         }
+         else
+         {
+            atLeast ( "stop setup", i, wait.time, T_SU_STO );
+            if ( i + 2 < numWaits )
+            {
+               atLeast ( "bus free", i + 1, next->time, T_BUF );
+            }
+            inTransaction = false;
+         }
+         if ( bits != 0 )
+         {
+            fail ( "start or stop within a byte", i, wait.time );
+         }
+         bits = 0;
+         continue;
+      }
+
+      // A clock pulse, SDA stable
+      if ( inTransaction )
+      {
+         atLeast ( "SCL HIGH", i, wait.time, T_HIGH );
+         value = ( value << 1 ) | wait.sda;
+         if ( ++bits == 9 )
+         {
+            if ( ( value & 1 ) != 0 )
+            {
+               fail ( "SDA released during the acknowledge", i, wait.time );
+            }
+            if ( numBytes < MAX_BYTES )
+            {
+               bytes[numBytes].value = value >> 1;
+               bytes[numBytes].first = first;
+               bytes[numBytes].end   = time;
+               numBytes++;
+            }
+            first = false;
+            bits  = 0;
+            value = 0;
+         }
+      }
+   }
+}
+
+static void check ( const char *what, unsigned long value,
+                    unsigned long expected )
+{
+   if ( value != expected )
+   {
+      printf ( "FAIL %s: %lu, expected %lu\n", what, value, expected );
+      failed++;
+   }
+}
+
+int main ( void )
+{
+   const uint8_t character[] =
+   {
+      0x40 | RS | BL | EN, 0x40 | RS | BL, 0x10 | RS | BL | EN, 0x10 | RS | BL
+   };
+   unsigned long start;
+   unsigned long last = 0;              // End of the last write
+
+   printf ( "%ukHz, byte %u us, exec wait %u us\n", FIO_I2C_KHZ,
+            SI2C_BYTE_TIME, SI2C_EXEC_WAIT );
+
+   lcd.begin ( 16, 2 );
+   lcd.print ( "Hello" );
+
+   // A character alone: one transaction of the address and 4 port values
+   numWaits = 0;
+   start    = micros ( );
+   lcd.write ( 'A' );
+   if ( micros ( ) - start > lcd.maxSendTime ( ) )
+   {
+      fail ( "send longer than maxSendTime", 0, micros ( ) - start );
+   }
+   lcd.print ( "Hello, world" );
+   lcd.clear ( );
+   lcd.print ( "again" );
+
+   // All along, the bus timing
+   decode ( );
+   check ( "character, bytes", numBytes >= 5, 1 );
+   check ( "character, address", bytes[0].value, ADDRESS << 1 );
+   check ( "character, first", bytes[0].first, 1 );
+   for ( uint8_t i = 0; i < 4; i++ )
+   {
+      check ( "character, port", bytes[1 + i].value, character[i] );
+      check ( "character, same transaction", bytes[1 + i].first, 0 );
+   }
+
+   // The LCD has executed a write, the second nibble, before the next
+   // enable pulse
+   for ( unsigned i = 0, nibbles = 0; i < numBytes; i++ )
+   {
+      if ( bytes[i].first )
+      {
+         continue;
+      }
+      if ( ( bytes[i].value & EN ) && ( last != 0 ) &&
+           ( bytes[i].end - last < LCD_EXEC_TIME ) )
+      {
+         fail ( "enable pulse before the LCD is done", i,
+                bytes[i].end - last );
+      }
+      if ( ( i > 0 ) && ( bytes[i - 1].value & EN ) &&
+           !( bytes[i].value & EN ) )
+      {
+         last = ( ++nibbles % 2 == 0 ) ? bytes[i].end : 0;
+      }
+   }
+
+   printf ( "%u bytes, %u checks failed\n", numBytes, failed );
+   return ( failed != 0 );
+}
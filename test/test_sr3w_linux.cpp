@@ -0,0 +1,181 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file test_sr3w_linux.cpp
+// This file checks the SPI transfers of LiquidCrystal_SR3W_Linux on a stand
+// in for the spidev device node (@see t_linuxIO).
+//
+// @brief
+// The stand in records the transfers of every SPI_IOC_MESSAGE and the byte
+// each one loads in the shift register. Checked for a character and for a
+// string longer than a message:
+// - one byte transfers, at the speed set, each latched releasing the chip
+//   select (cs_change) but the last of a message, released by its end,
+// - two loads per nibble, enable high then low,
+// - the execution time of the LCD as the delay of the first load after it,
+// - strings split at LCDSR3WL_MAX_LOADS.
+//
+// ---------------------------------------------------------------------------
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <linux/spi/spidev.h>
+
+#include "LiquidCrystal_SR3W_Linux.h"
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+#define FD            4
+#define MAX_MESSAGES  4     // the last ones are kept
+#define TEXT_SIZE     100
+
+// Default pin mapping
+#define EN            0x10
+#define RS            0x40
+
+// CLASS VARIABLES
+// ---------------------------------------------------------------------------
+typedef struct
+{
+   unsigned                count;
+   struct spi_ioc_transfer xfer[LCDSR3WL_MAX_LOADS];
+   uint8_t                 tx[LCDSR3WL_MAX_LOADS];
+} t_message;
+
+static t_message messages[MAX_MESSAGES];
+static unsigned  calls;
+static uint32_t  speed;
+static unsigned  failed;
+
+static int mockOpen ( const char *path, int flags )
+{
+   return ( FD );
+}
+
+static int mockClose ( int fd )
+{
+   return ( 0 );
+}
+
+static int mockIoctl ( int fd, unsigned long request, void *arg )
+{
+   struct spi_ioc_transfer *xfer = (struct spi_ioc_transfer *)arg;
+   t_message               *message = &messages[calls % MAX_MESSAGES];
+
+   if ( request == SPI_IOC_WR_MODE )
+   {
+      return ( 0 );
+   }
+   if ( request == SPI_IOC_WR_MAX_SPEED_HZ )
+   {
+      speed = *(uint32_t *)arg;
+      return ( 0 );
+   }
+   if ( ( fd != FD ) || ( _IOC_TYPE ( request ) != SPI_IOC_MAGIC ) ||
+        ( _IOC_NR ( request ) != 0 ) )
+   {
+      printf ( "FAIL unexpected ioctl 0x%lX\n", request );
+      failed++;
+      return ( -1 );
+   }
+   message->count = _IOC_SIZE ( request ) / sizeof ( *xfer );
+   for ( unsigned i = 0; i < message->count; i++ )
+   {
+      message->xfer[i] = xfer[i];
+      message->tx[i]   = *(const uint8_t *)(unsigned long)xfer[i].tx_buf;
+   }
+   calls++;
+   return ( message->count );
+}
+
+static const t_linuxIO mockIO = { mockOpen, mockClose, mockIoctl };
+
+static LiquidCrystal_SR3W_Linux lcd ( "/dev/spidev0.0", mockIO );
+
+static void check ( const char *what, unsigned long value,
+                    unsigned long expected )
+{
+   if ( value != expected )
+   {
+      printf ( "FAIL %s: %lu, expected %lu\n", what, value, expected );
+      failed++;
+   }
+}
+
+// The 4 loads of an LCD byte from load of a message
+static void checkByte ( const t_message &message, unsigned load,
+                        uint8_t value, uint8_t rs, uint16_t delay )
+{
+   const uint8_t expected[4] =
+   {
+      (uint8_t)( ( value >> 4 ) | rs | EN ), (uint8_t)( ( value >> 4 ) | rs ),
+      (uint8_t)( ( value & 0x0F ) | rs | EN ), (uint8_t)( ( value & 0x0F ) | rs )
+   };
+
+   for ( unsigned i = 0; i < 4; i++ )
+   {
+      const struct spi_ioc_transfer &xfer = message.xfer[load + i];
+
+      check ( "load", message.tx[load + i], expected[i] );
+      check ( "length", xfer.len, 1 );
+      check ( "bits", xfer.bits_per_word, 8 );
+      check ( "speed", xfer.speed_hz, LCDSR3WL_SPEED );
+      check ( "delay", xfer.delay_usecs, ( i == 0 ) ? delay : 0 );
+      check ( "latched", xfer.cs_change,
+              ( load + i + 1 < message.count ) ? 1 : 0 );
+   }
+}
+
+int main ( void )
+{
+   char text[TEXT_SIZE + 1];
+
+   lcd.begin ( 20, 4 );
+   check ( "speed set", speed, LCDSR3WL_SPEED );
+
+   // A character, after a command
+   lcd.command ( LCD_SETDDRAMADDR );
+   calls = 0;
+   lcd.write ( 'A' );
+   check ( "character, messages", calls, 1 );
+   check ( "character, loads", messages[0].count, 4 );
+   checkByte ( messages[0], 0, 'A', RS, LCD_EXEC_TIME );
+
+   // After clear the first load waits for it
+   lcd.clear ( );
+   calls = 0;
+   lcd.write ( 'B' );
+   check ( "after clear, messages", calls, 1 );
+   checkByte ( messages[0], 0, 'B', RS, HOME_CLEAR_EXEC );
+
+   // A string longer than a message
+   for ( unsigned i = 0; i < TEXT_SIZE; i++ )
+   {
+      text[i] = 'a' + i % 26;
+   }
+   text[TEXT_SIZE] = '\0';
+   calls = 0;
+   lcd.print ( text );
+   check ( "string, messages", calls, 2 );
+   check ( "string, first message", messages[0].count, LCDSR3WL_MAX_LOADS );
+   check ( "string, second message", messages[1].count,
+           4 * TEXT_SIZE - LCDSR3WL_MAX_LOADS );
+   for ( unsigned i = 0; ( calls == 2 ) && ( i < TEXT_SIZE ); i++ )
+   {
+      unsigned load = 4 * i;
+      unsigned m    = load / LCDSR3WL_MAX_LOADS;
+
+      checkByte ( messages[m], load % LCDSR3WL_MAX_LOADS, text[i], RS,
+                  LCD_EXEC_TIME );
+   }
+
+   printf ( "%u checks failed\n", failed );
+   return ( failed != 0 );
+}
@@ -0,0 +1,218 @@
+// ---------------------------------------------------------------------------
+// Copyright 2013 - Under creative commons license 3.0:
+//        Attribution-ShareAlike CC BY-SA
+//
+// This software is furnished "as is", without technical support, and with no
+// warranty, express or implied, as to its usefulness for any purpose.
+//
+// Thread Safe: No
+// Extendable: Yes
+//
+// @file test_viewport.cpp
+// This file checks that LCDViewport shows its window of the canvas
+// (@see LCDViewport, LCDCanvas).
+//
+// @brief
+// Random pans, jumps and canvas writes are made on a 64x16 canvas shown on
+// a simulated 20x4 LCD, directly and through LiquidCrystal_Buffer (which
+// can send horizontal pans as display shifts). After each update the LCD
+// must show the window, the window must be within the canvas and a second
+// update must send nothing. The LCD is sometimes written behind the
+// viewport's back and invalidated. A canvas smaller than the LCD shows
+// spaces past its edges. On an LCD where characters are cheaper than
+// commands, gaps of up to LCD::maxBridgeGap unchanged characters are
+// rewritten instead of moving the cursor.
+//
+// ---------------------------------------------------------------------------
+#include <stdio.h>
+
+#include "LCDSimulator.h"
+#include "LCDCanvas.h"
+#include "LCDViewport.h"
+#include "LiquidCrystal_Buffer.h"
+
+// CONSTANT  definitions
+// ---------------------------------------------------------------------------
+#define COLS          20
+#define ROWS          4
+#define CANVAS_COLS   64
+#define CANVAS_ROWS   16
+#define STEPS         2000
+
+// CLASS VARIABLES
+// ---------------------------------------------------------------------------
+// Characters a quarter of the cost of a command: gaps of 3 are bridged
+class CheapData : public LCDSimulator
+{
+public:
+   uint16_t dataCost ( void ) { return ( 10 ); }
+   uint16_t commandCost ( void ) { return ( 40 ); }
+};
+
+static uint32_t seed = 2463534242UL;
+static unsigned failed;
+
+static uint32_t next ( uint32_t range )
+{
+   seed ^= seed << 13;
+   seed ^= seed >> 17;
+   seed ^= seed << 5;
+   return ( seed % range );
+}
+
+static void check ( bool ok, const char *what, unsigned step )
+{
+   if ( !ok )
+   {
+      printf ( "FAIL %s, step %u\n", what, step );
+      failed++;
+   }
+}
+
+// The LCD shows the window
+static bool shows ( LCDSimulator &lcd, LCDCanvas &canvas, LCDViewport &view )
+{
+   for ( uint8_t row = 0; row < ROWS; row++ )
+   {
+      for ( uint8_t col = 0; col < COLS; col++ )
+      {
+         if ( lcd.charAt ( col, row ) !=
+              canvas.charAt ( view.col ( ) + col, view.row ( ) + row ) )
+         {
+            return ( false );
+         }
+      }
+   }
+   return ( true );
+}
+
+// A random change of the canvas or of the window
+static void change ( LCDCanvas &canvas, LCDViewport &view, LCD &lcd )
+{
+   uint8_t length;
+
+   switch ( next ( 8 ) )
+   {
+      case 0:
+      case 1:
+      case 2:
+         view.scroll ( ( int16_t )next ( 7 ) - 3, ( int16_t )next ( 3 ) - 1 );
+         break;
+      case 3:
+         view.moveTo ( ( int16_t )next ( CANVAS_COLS + 20 ) - 10,
+                       ( int16_t )next ( CANVAS_ROWS + 8 ) - 4 );
+         break;
+      case 4:
+      case 5:
+         canvas.setCursor ( next ( canvas.cols ( ) ), next ( canvas.rows ( ) ) );
+         length = next ( 24 );
+         for ( uint8_t i = 0; i < length; i++ )
+         {
+            canvas.write ( next ( 4 ) == 0 ? ' ' : 'A' + next ( 58 ) );
+         }
+         break;
+      case 6:
+         // Behind the viewport's back
+         lcd.setCursor ( next ( COLS ), next ( ROWS ) );
+         lcd.print ( "stray" );
+         view.invalidate ( );
+         break;
+      default:
+         if ( next ( 50 ) == 0 )
+         {
+            canvas.clear ( );
+         }
+         break;
+   }
+}
+
+// Random steps on a canvas shown on a simulated LCD
+static void pan ( uint8_t cols, uint8_t rows, bool buffered )
+{
+   static uint8_t cells[CANVAS_COLS * CANVAS_ROWS];
+   LCDCanvas            canvas ( cells, cols, rows );
+   LCDSimulator         lcd;
+   LiquidCrystal_Buffer buffer ( lcd );
+   LCD                 &shown = buffered ? ( LCD & )buffer : ( LCD & )lcd;
+   LCDViewport          view ( canvas, shown );
+   unsigned long        sends;
+
+   check ( view.begin ( COLS, ROWS ), "begin", 0 );
+   for ( uint8_t row = 0; row < rows; row++ )
+   {
+      canvas.setCursor ( 0, row );
+      for ( uint8_t col = 0; col < cols; col++ )
+      {
+         canvas.write ( '0' + ( col + row ) % 64 );
+      }
+   }
+
+   for ( unsigned step = 1; step <= STEPS; step++ )
+   {
+      change ( canvas, view, shown );
+      view.update ( );
+      if ( buffered )
+      {
+         buffer.flush ( );
+      }
+      check ( shows ( lcd, canvas, view ), "window not shown", step );
+      check ( ( cols < COLS ) ? ( view.col ( ) == 0 )
+                              : ( view.col ( ) + COLS <= cols ),
+              "window off the canvas", step );
+      check ( ( rows < ROWS ) ? ( view.row ( ) == 0 )
+                              : ( view.row ( ) + ROWS <= rows ),
+              "window off the canvas", step );
+
+      sends = lcd.sends ( );
+      view.update ( );
+      if ( buffered )
+      {
+         buffer.flush ( );
+      }
+      check ( lcd.sends ( ) == sends, "unchanged window sent", step );
+   }
+   printf ( "%ux%u canvas%s: %lu sends\n", cols, rows,
+            buffered ? ", buffered" : "", lcd.sends ( ) );
+}
+
+int main ( void )
+{
+   pan ( CANVAS_COLS, CANVAS_ROWS, false );
+   pan ( CANVAS_COLS, CANVAS_ROWS, true );
+   pan ( 12, 3, false );
+
+   // Gaps bridged up to maxBridgeGap, the cursor moved past it
+   {
+      uint8_t      cells[COLS * ROWS];
+      LCDCanvas    canvas ( cells, COLS, ROWS );
+      CheapData    lcd;
+      LCDViewport  view ( canvas, lcd );
+
+      check ( lcd.maxBridgeGap ( ) == 3, "bridge gap", 0 );
+      view.begin ( COLS, ROWS );
+      view.update ( );
+      lcd.resetCounters ( );
+      canvas.setCursor ( 0, 1 );
+      canvas.print ( "A   B" );              // 3 unchanged: 1 run
+      canvas.setCursor ( 0, 2 );
+      canvas.print ( "C    D" );             // 4 unchanged: 2 runs
+      view.update ( );
+      check ( shows ( lcd, canvas, view ), "bridged window not shown", 0 );
+      check ( lcd.sends ( ) == ( 1 + 5 ) + ( 1 + 1 + 1 + 1 ),
+              "gaps not bridged", 0 );
+   }
+
+   // A window larger than the LCD can hold
+   {
+      uint8_t      cells[4];
+      LCDCanvas    canvas ( cells, 2, 2 );
+      LCDSimulator lcd;
+      LCDViewport  view ( canvas, lcd );
+
+      check ( view.begin ( LCDVP_MAX_COLS + 1, 1 ) == 0, "too many columns", 0 );
+      check ( view.begin ( 40, 3 ) == 0, "too many cells", 0 );
+   }
+
+   printf ( "%u checks failed\n", failed );
+   return ( failed != 0 );
+}